@@ -322,6 +322,8 @@ public:
             }
         }
 
+        // 先取分片代数，创建期间该 url 所在分片有缓存被移除时不写回缓存
+        const quint64 generation = InfoCacheController::instance().generation(url);
         QSharedPointer<FileInfo> info = InfoCacheController::instance().getCacheInfo(url);
         if (!info) {
             auto tarScheme = scheme(url);
@@ -330,7 +332,7 @@ public:
                 info->updateAttributes();
 
             if (type != Global::CreateFileInfoType::kCreateFileInfoAutoNoCache)
-                emit InfoCacheController::instance().cacheFileInfo(url, info);
+                InfoCacheController::instance().cacheInfo(url, info, generation);
         }
 
         if (!info)
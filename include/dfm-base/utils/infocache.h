@@ -19,6 +19,20 @@ namespace dfmbase {
 class InfoCachePrivate;
 class InfoCache;
 
+// 缓存命中等计数，供调试和性能统计读取
+struct InfoCacheStatistics
+{
+    quint64 hits { 0 };
+    quint64 misses { 0 };
+    quint64 inserts { 0 };
+    quint64 rejects { 0 };   // 因代数变化放弃的插入
+    quint64 evictions { 0 };   // 超出内存预算淘汰
+    quint64 expirations { 0 };   // 超时移除
+    quint64 invalidations { 0 };   // 文件变化等主动移除
+    qint64 entries { 0 };
+    qint64 memoryCost { 0 };
+};
+
 // 异步缓存和移除
 class CacheWorker : public QObject
 {
@@ -45,7 +59,6 @@ class TimeToUpdateCache : public QObject
 public:
     ~TimeToUpdateCache() override;
 public Q_SLOTS:
-    void updateInfoTime(const QUrl url);
     void dealRemoveInfo();
     void updateWatcherTime(const QList<QUrl> &urls, const bool add);
 private:
@@ -69,7 +82,6 @@ public:
 Q_SIGNALS:
     void cacheRemoveCaches(const QList<QUrl> &key);
     void cacheDisconnectWatcher(const QMap<QUrl, FileInfoPointer> infos);
-    void cacheUpdateInfoTime(const QUrl url);
 
 private:
     explicit InfoCache(QObject *parent = nullptr);
@@ -78,14 +90,16 @@ private:
     void setCacheDisbale(const QString &scheme, bool disable = true);
     FileInfoPointer getCacheInfo(const QUrl &url);
     void stop();
-    void cacheInfo(const QUrl url, const FileInfoPointer info);
+    void cacheInfo(const QUrl url, const FileInfoPointer info, quint64 generation = kAnyGeneration);
+    quint64 generation(const QUrl &url);
+    InfoCacheStatistics statistics();
     void disconnectWatcher(const QMap<QUrl, FileInfoPointer> infos);
     void removeCaches(const QList<QUrl> urls);
-    bool updateSortTimeWorker(const QUrl url);
     void timeRemoveCache();
-    void removeInfosTimeWorker(const QList<QUrl> urls);
     void updateSortTimeWatcherWorker(const QList<QUrl> &urls, const bool add);
 
+    static constexpr quint64 kAnyGeneration = ~0ULL;
+
 private Q_SLOTS:
     void fileAttributeChanged(const QUrl url);
     void removeCache(const QUrl url);
@@ -99,6 +113,7 @@ class InfoCacheController : public QObject
 {
     Q_DISABLE_COPY(InfoCacheController)
     Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.deepin.Filemanager.InfoCache")
     QSharedPointer<QThread> thread { nullptr };
     QSharedPointer<CacheWorker> worker { nullptr };
     QSharedPointer<QTimer> removeTimer { nullptr };   // 移除缓存的
@@ -110,6 +125,14 @@ public:
     bool cacheDisable(const QString &scheme);
     void setCacheDisbale(const QString &scheme, bool disable = true);
     FileInfoPointer getCacheInfo(const QUrl &url);
+    quint64 generation(const QUrl &url);
+    void cacheInfo(const QUrl &url, const FileInfoPointer &info, quint64 generation);
+    InfoCacheStatistics statistics();
+    void registerDBus();
+
+public Q_SLOTS:
+    Q_SCRIPTABLE QVariantMap Statistics();
+
 Q_SIGNALS:
     void cacheFileInfo(const QUrl url, const FileInfoPointer info);
     void removeCacheFileInfo(const QList<QUrl> &urls);
@@ -5,8 +5,13 @@
 #include "imageview.h"
 
 #include <dfm-base/utils/windowutils.h>
+#include <dfm-base/utils/thumbnail/thumbnailhelper.h>
 
 #include <QUrl>
+#include <QCache>
+#include <QFileInfo>
+#include <QThreadPool>
+#include <QtConcurrent>
 #include <QImageReader>
 #include <QApplication>
 #include <QtMath>
@@ -17,23 +22,129 @@
 #include <QDebug>
 #include <QMovie>
 #include <QScreen>
+#include <QMutex>
 
 using namespace plugin_filepreview;
 #define MIN_SIZE QSize(400, 300)
 
+// 低分辨率预览的解码比例
+static constexpr int kPreviewScale { 4 };
+// 最近预览过的图像，单位 KiB
+static constexpr int kDecodedCacheCost { 64 * 1024 };
+// 不能在解码时缩放的格式要先按原始大小解码，原始像素数超过该值时同一时间只解码一张
+static constexpr qint64 kSerialDecodePixels { 4096LL * 4096 };
+// 原始像素数超过该值的图像不做完整解码（ARGB32 约 256MiB，与 QImageReader 默认的内存上限一致），
+// 只显示已有的缩略图
+static constexpr qint64 kMaxDecodePixels { 8192LL * 8192 };
+
+static QThreadPool *decodePool()
+{
+    static QThreadPool *pool = [] {
+        QThreadPool *p = new QThreadPool(qApp);
+        p->setMaxThreadCount(2);
+        return p;
+    }();
+    return pool;
+}
+
+static QCache<QString, QImage> &decodedImages()
+{
+    static QCache<QString, QImage> cache(kDecodedCacheCost);
+    return cache;
+}
+
+static QMutex &largeDecodeMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+/*!
+ * \brief 是否在解码时直接缩放
+ * PNG、TIFF 等格式的解码器即使支持 ScaledSize，也是先解码出原始大小的图像再缩放，
+ * 只有 JPEG 和矢量图能直接解码到较小的分辨率
+ */
+static bool decodesScaled(const QImageReader &reader, const QByteArray &format)
+{
+    static const QList<QByteArray> kScaledFormats { "jpeg", "jpg", "svg", "svgz" };
+    return reader.supportsOption(QImageIOHandler::ScaledSize) && kScaledFormats.contains(format.toLower());
+}
+
+static QImage decodePreview(const QString &fileName, const QByteArray &format, const QSize &targetSize,
+                            const std::shared_ptr<std::atomic_bool> &canceled)
+{
+    if (*canceled)
+        return QImage();
+
+    // 文件管理器已经生成过的缩略图可以直接使用
+    const QImage &thumbnail = DFMBASE_NAMESPACE::ThumbnailHelper::thumbnailImage(QUrl::fromLocalFile(fileName),
+                                                                                 DFMGLOBAL_NAMESPACE::kLarge);
+    if (!thumbnail.isNull())
+        return thumbnail;
+
+    // 只有解码时缩放的格式（如 JPEG）低分辨率解码才明显快于完整解码
+    QImageReader reader(fileName, format);
+    if (*canceled || !decodesScaled(reader, format))
+        return QImage();
+
+    reader.setScaledSize(targetSize / kPreviewScale);
+    return reader.read();
+}
+
+static QImage decodeImage(const QString &fileName, const QByteArray &format, const QSize &targetSize,
+                          const std::shared_ptr<std::atomic_bool> &canceled)
+{
+    if (*canceled)
+        return QImage();
+
+    // 直接解码到目标分辨率，支持的格式不会生成原始大小的图像
+    QImageReader reader(fileName, format);
+    if (reader.size() != targetSize)
+        reader.setScaledSize(targetSize);
+    if (decodesScaled(reader, format))
+        return reader.read();
+
+    // 其他格式按原始大小占用内存，两个解码线程同时解码超大图像可能占用上 GiB 内存
+    const QSize &sourceSize = reader.size();
+    const qint64 pixels = static_cast<qint64>(sourceSize.width()) * sourceSize.height();
+    if (pixels > kMaxDecodePixels) {
+        fmWarning() << "Image Preview: image is too large to decode:" << fileName << sourceSize;
+        return QImage();
+    }
+    if (pixels <= kSerialDecodePixels)
+        return reader.read();
+
+    QMutexLocker locker(&largeDecodeMutex());
+    if (*canceled)
+        return QImage();
+    return reader.read();
+}
+
 ImageView::ImageView(const QString &fileName, const QByteArray &format, QWidget *parent)
-    : QLabel(parent)
+    : QLabel(parent),
+      previewWatcher(new QFutureWatcher<QImage>(this)),
+      imageWatcher(new QFutureWatcher<QImage>(this))
 {
+    connect(previewWatcher, &QFutureWatcher<QImage>::finished, this, &ImageView::onPreviewDecoded);
+    connect(imageWatcher, &QFutureWatcher<QImage>::finished, this, &ImageView::onImageDecoded);
+
     setFile(fileName, format);
     setMinimumSize(MIN_SIZE);
     setAlignment(Qt::AlignCenter);
 }
 
+ImageView::~ImageView()
+{
+    cancelDecode();
+}
+
 void ImageView::setFile(const QString &fileName, const QByteArray &format)
 {
     const QSize &dsize = DFMBASE_NAMESPACE::WindowUtils::cursorScreen()->geometry().size();
     qreal device_pixel_ratio = this->devicePixelRatioF();
 
+    cancelDecode();
+
     if (format == QByteArrayLiteral("gif")) {
         if (movie) {
             movie->stop();   // blumia: we need to stop it first before we load a new file
@@ -68,14 +179,83 @@ void ImageView::setFile(const QString &fileName, const QByteArray &format)
         return;
     }
 
-    QPixmap pixmap = QPixmap::fromImageReader(&reader).scaled(QSize(qMin(static_cast<int>(dsize.width() * 0.7 * device_pixel_ratio), sourceImageSize.width()),
-                                                                    qMin(static_cast<int>(dsize.height() * 0.7 * device_pixel_ratio), sourceImageSize.height())),
-                                                              Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    pixmap.setDevicePixelRatio(device_pixel_ratio);
-    setPixmap(pixmap);
+    const QSize boundSize(qMin(static_cast<int>(dsize.width() * 0.7 * device_pixel_ratio), sourceImageSize.width()),
+                          qMin(static_cast<int>(dsize.height() * 0.7 * device_pixel_ratio), sourceImageSize.height()));
+    targetImageSize = sourceImageSize.scaled(boundSize, Qt::KeepAspectRatio);
+    imageKey = fileName + QString("|%1|%2x%3")
+                                  .arg(QFileInfo(fileName).lastModified().toMSecsSinceEpoch())
+                                  .arg(targetImageSize.width())
+                                  .arg(targetImageSize.height());
+
+    if (QImage *cached = decodedImages().object(imageKey)) {
+        showImage(*cached);
+        imageShown = true;
+        return;
+    }
+
+    // 解码完成前用透明占位图撑开布局，避免预览窗口尺寸跳变
+    QPixmap placeholder(targetImageSize);
+    placeholder.fill(Qt::transparent);
+    placeholder.setDevicePixelRatio(device_pixel_ratio);
+    setPixmap(placeholder);
+
+    decodeCanceled = std::make_shared<std::atomic_bool>(false);
+    previewWatcher->setFuture(QtConcurrent::run(decodePool(), decodePreview, fileName, format, targetImageSize, decodeCanceled));
+    imageWatcher->setFuture(QtConcurrent::run(decodePool(), decodeImage, fileName, format, targetImageSize, decodeCanceled));
 }
 
 QSize ImageView::sourceSize() const
 {
     return sourceImageSize;
 }
+
+void ImageView::onPreviewDecoded()
+{
+    if (imageShown || previewWatcher->future().resultCount() == 0)
+        return;
+
+    const QImage &image = previewWatcher->result();
+    if (image.isNull())
+        return;
+
+    previewShown = true;
+    showImage(image.scaled(targetImageSize, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+}
+
+void ImageView::onImageDecoded()
+{
+    if (imageWatcher->future().resultCount() == 0)
+        return;
+
+    const QImage &image = imageWatcher->result();
+    if (image.isNull()) {
+        // 超大图像不做完整解码，保留已显示的缩略图
+        if (!imageShown && !previewShown)
+            setPixmap(QPixmap());
+        return;
+    }
+
+    imageShown = true;
+    decodedImages().insert(imageKey, new QImage(image), qMax<qsizetype>(1, image.sizeInBytes() / 1024));
+    showImage(image);
+}
+
+void ImageView::cancelDecode()
+{
+    // 已经开始的解码无法中断，结果会被丢弃；尚未开始的直接跳过
+    if (decodeCanceled)
+        *decodeCanceled = true;
+    decodeCanceled.reset();
+    imageShown = false;
+    previewShown = false;
+
+    previewWatcher->setFuture(QFuture<QImage>());
+    imageWatcher->setFuture(QFuture<QImage>());
+}
+
+void ImageView::showImage(const QImage &image)
+{
+    QPixmap pixmap = QPixmap::fromImage(image);
+    pixmap.setDevicePixelRatio(devicePixelRatioF());
+    setPixmap(pixmap);
+}
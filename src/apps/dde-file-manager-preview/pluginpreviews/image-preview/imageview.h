@@ -7,19 +7,42 @@
 
 #include "preview_plugin_global.h"
 #include <QLabel>
+#include <QFutureWatcher>
+#include <QImage>
+
+#include <atomic>
+#include <memory>
+
 namespace plugin_filepreview {
 class ImageView : public QLabel
 {
     Q_OBJECT
 public:
     explicit ImageView(const QString &fileName, const QByteArray &format, QWidget *parent = nullptr);
+    ~ImageView() override;
 
     void setFile(const QString &fileName, const QByteArray &format);
     QSize sourceSize() const;
 
+private Q_SLOTS:
+    void onPreviewDecoded();
+    void onImageDecoded();
+
 private:
+    void cancelDecode();
+    void showImage(const QImage &image);
+
     QSize sourceImageSize;
+    QSize targetImageSize;
+    QString imageKey;
     QMovie *movie { nullptr };
+
+    // 先显示缩略图或低分辨率解码结果，再替换为目标分辨率的图像
+    QFutureWatcher<QImage> *previewWatcher { nullptr };
+    QFutureWatcher<QImage> *imageWatcher { nullptr };
+    std::shared_ptr<std::atomic_bool> decodeCanceled;
+    bool imageShown { false };
+    bool previewShown { false };
 };
 }
 #endif   // IMAGEVIEW_H
@@ -3,16 +3,23 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "textbrowseredit.h"
+#include "textfilemodel.h"
 
 #include <QScrollBar>
+#include <QTextBlock>
+#include <QSignalBlocker>
 #include <QDebug>
 
-#include <algorithm>
+#include <climits>
 
 using namespace plugin_filepreview;
-constexpr int kReadTextSize { 1024 * 1024 * 5 };
+// 文档中保留的行数，以及距离窗口边缘多少行时平移窗口
+constexpr qint64 kWindowLines { 2000 };
+constexpr qint64 kWindowMargin { 200 };
+
 TextBrowserEdit::TextBrowserEdit(QWidget *parent)
-    : QPlainTextEdit(parent)
+    : QPlainTextEdit(parent),
+      fileScrollBar(new QScrollBar(Qt::Vertical, this))
 {
     setReadOnly(true);
     setTextInteractionFlags(Qt::TextSelectableByMouse | Qt::TextSelectableByKeyboard);
@@ -22,110 +29,127 @@ TextBrowserEdit::TextBrowserEdit(QWidget *parent)
     setContextMenuPolicy(Qt::NoContextMenu);
     setFrameStyle(QFrame::NoFrame);
 
-    connect(verticalScrollBar(), &QScrollBar::valueChanged, this, &TextBrowserEdit::scrollbarValueChange);
-    connect(verticalScrollBar(), &QScrollBar::sliderMoved, this, &TextBrowserEdit::sliderPositionValueChange);
+    // 自带的滚动条只能表示窗口内的位置，另用一个滚动条表示在整个文件中的行号
+    setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setViewportMargins(0, 0, fileScrollBar->sizeHint().width(), 0);
+    fileScrollBar->setRange(0, 0);
+
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, this, &TextBrowserEdit::onViewScrolled);
+    connect(fileScrollBar, &QScrollBar::valueChanged, this, &TextBrowserEdit::onFileScrolled);
 }
 
 TextBrowserEdit::~TextBrowserEdit()
 {
-    filestr.clear();
 }
 
-void TextBrowserEdit::setFileData(std::string &data)
+void TextBrowserEdit::setFileModel(TextFileModel *model)
 {
-    clear();
-    filestr = data;
-    std::string::iterator temp = filestr.begin();
-    appendText(temp);
-    this->moveCursor(QTextCursor::Start, QTextCursor::MoveAnchor);
-    lastPosition = verticalScrollBar()->sliderPosition();
+    if (fileModel)
+        fileModel->disconnect(this);
+
+    fileModel = model;
+    windowFirstLine = 0;
+    windowLineCount = 0;
+    {
+        QSignalBlocker blocker(fileScrollBar);
+        fileScrollBar->setRange(0, 0);
+    }
+
+    if (fileModel)
+        connect(fileModel, &TextFileModel::lineCountChanged, this, &TextBrowserEdit::onLineCountChanged, Qt::QueuedConnection);
+
+    loadWindow(0);
+    onLineCountChanged();
 }
 
-void TextBrowserEdit::wheelEvent(QWheelEvent *e)
+void TextBrowserEdit::resizeEvent(QResizeEvent *e)
 {
-    QPoint numDegrees = e->angleDelta();
-    if (numDegrees.y() < 0) {
-        int sbValue = verticalScrollBar()->value();
-        if (verticalScrollBar()->maximum() <= sbValue) {
-            if (!filestr.empty()) {
-                std::string::iterator data = filestr.begin();
-                appendText(data);
-            }
-        }
-    }
-    QPlainTextEdit::wheelEvent(e);
+    QPlainTextEdit::resizeEvent(e);
+
+    const QRect &rect = contentsRect();
+    const int width = fileScrollBar->sizeHint().width();
+    fileScrollBar->setGeometry(rect.right() - width + 1, rect.top(), width, rect.height());
+    fileScrollBar->setPageStep(visibleLineCount());
 }
 
-void TextBrowserEdit::scrollbarValueChange(int value)
+void TextBrowserEdit::onLineCountChanged()
 {
-    int maxValue = verticalScrollBar()->maximum();
-    if (maxValue <= value) {
-        verticalScrollBar()->setValue(value);
+    const qint64 count = fileModel ? fileModel->lineCount() : 0;
+    {
+        QSignalBlocker blocker(fileScrollBar);
+        fileScrollBar->setRange(0, int(qBound<qint64>(0, count - 1, INT_MAX)));
+        fileScrollBar->setPageStep(visibleLineCount());
+    }
+
+    // 索引刚开始时窗口还没有填满，补齐后保持当前位置
+    if (windowLineCount < kWindowLines && windowFirstLine + windowLineCount < count) {
+        const qint64 top = topLine();
+        loadWindow(windowFirstLine);
+        setTopLine(top);
     }
 }
 
-void TextBrowserEdit::sliderPositionValueChange(int position)
+void TextBrowserEdit::onViewScrolled()
 {
-    if (position > lastPosition) {
-        if (verticalScrollBar()->maximum() <= position) {
-            if (!filestr.empty()) {
-                std::string::iterator data = filestr.begin();
-                appendText(data);
-            }
-        }
+    if (updatingWindow || !fileModel)
+        return;
+
+    // 自动换行时滚动条的值是显示行而不是文本行，以第一个可见的文本块为准
+    const qint64 block = firstVisibleBlock().blockNumber();
+    const qint64 top = windowFirstLine + block;
+    const bool nearEnd = block + visibleLineCount() + kWindowMargin > windowLineCount
+            && windowFirstLine + windowLineCount < fileModel->lineCount();
+    const bool nearBegin = block < kWindowMargin && windowFirstLine > 0;
+    if (nearEnd || nearBegin) {
+        loadWindow(top - kWindowLines / 2);
+        setTopLine(top);
     }
-    lastPosition = position;
+
+    QSignalBlocker blocker(fileScrollBar);
+    fileScrollBar->setValue(int(qMin<qint64>(top, INT_MAX)));
 }
 
-int TextBrowserEdit::verifyEndOfStrIntegrity(const char *s, int l)
+void TextBrowserEdit::onFileScrolled(int value)
 {
-    int len = 0, i = 0;
-    if (s == nullptr || *s == 0 || l <= 0) {
-        return 0;
-    }
-    while (*s) {
-        if ((*s & 0x80) == 0) {
-            i++;
-            s++;
-            len++;
-        } else {
-            if (*(s + 1) == 0)
-                break;
-            i += 3;
-            s += 3;
-            len += 3;
-        }
-
-        if (i == l)
-            break;
-        else if (i > l) {
-            len -= 3;
-            break;
-        }
-    }
-    return len;
+    if (updatingWindow || !fileModel)
+        return;
+
+    // 目标位置在窗口内时直接滚动，否则以目标行为中心重新加载窗口
+    if (value < windowFirstLine || value + visibleLineCount() > windowFirstLine + windowLineCount)
+        loadWindow(value - kWindowLines / 2);
+    setTopLine(value);
 }
 
-void TextBrowserEdit::appendText(std::string::iterator &data)
+void TextBrowserEdit::loadWindow(qint64 firstLine)
 {
-    if (filestr.size() >= kReadTextSize) {
-        char temp[kReadTextSize] { 0 };
-
-        std::copy(data, data + kReadTextSize, temp);
-
-        char ch = temp[kReadTextSize - 1];
-        int l = verifyEndOfStrIntegrity(temp, kReadTextSize);
-        if (!(0 <= ch && 127 >= static_cast<int>(ch))) {
-            temp[l] = '\0';
-        }
-
-        filestr.erase(std::begin(filestr), std::begin(filestr) + l);
-        QString textData = QString::fromLocal8Bit(temp, l);
-        appendPlainText(textData);
-    } else if (filestr.size() > 0) {
-        unsigned long len = static_cast<unsigned long>(filestr.size());
-        QString textData = QString::fromLocal8Bit(filestr.c_str(), static_cast<int>(len));
-        insertPlainText(textData);
-        filestr.clear();
-    }
+    const qint64 count = fileModel ? fileModel->lineCount() : 0;
+    firstLine = qBound<qint64>(0, firstLine, qMax<qint64>(0, count - kWindowLines));
+
+    updatingWindow = true;
+    setPlainText(fileModel ? fileModel->lines(firstLine, int(kWindowLines)) : QString());
+    windowFirstLine = firstLine;
+    windowLineCount = qBound<qint64>(0, count - firstLine, kWindowLines);
+    updatingWindow = false;
+}
+
+void TextBrowserEdit::setTopLine(qint64 line)
+{
+    const int blockNumber = int(qBound<qint64>(0, line - windowFirstLine, qMax<qint64>(0, windowLineCount - 1)));
+    const QTextBlock &block = document()->findBlockByNumber(blockNumber);
+    if (!block.isValid())
+        return;
+
+    updatingWindow = true;
+    verticalScrollBar()->setValue(block.firstLineNumber());
+    updatingWindow = false;
+}
+
+qint64 TextBrowserEdit::topLine() const
+{
+    return windowFirstLine + firstVisibleBlock().blockNumber();
+}
+
+int TextBrowserEdit::visibleLineCount() const
+{
+    return qMax(1, viewport()->height() / qMax(1, fontMetrics().lineSpacing()));
 }
@@ -7,10 +7,14 @@
 #include "preview_plugin_global.h"
 
 #include <QPlainTextEdit>
+#include <QPointer>
 
-#include <vector>
+QT_BEGIN_NAMESPACE
+class QScrollBar;
+QT_END_NAMESPACE
 
 namespace plugin_filepreview {
+class TextFileModel;
 class TextBrowserEdit : public QPlainTextEdit
 {
     Q_OBJECT
@@ -19,24 +23,37 @@ public:
 
     virtual ~TextBrowserEdit() override;
 
-    void setFileData(std::string &data);
+    void setFileModel(TextFileModel *model);
 
 protected:
-    void wheelEvent(QWheelEvent *e) override;
+    void resizeEvent(QResizeEvent *e) override;
 
 private slots:
-    void scrollbarValueChange(int value);
+    void onLineCountChanged();
 
-    void sliderPositionValueChange(int position);
+    void onViewScrolled();
+
+    void onFileScrolled(int value);
 
 private:
-    int verifyEndOfStrIntegrity(const char *s, int l);
+    void loadWindow(qint64 firstLine);
+
+    void setTopLine(qint64 line);
+
+    qint64 topLine() const;
+
+    int visibleLineCount() const;
+
+    // 文档中只保留文件的一个行窗口，滚动接近窗口边缘时平移窗口
+    QPointer<TextFileModel> fileModel;
+
+    QScrollBar *fileScrollBar { nullptr };
 
-    void appendText(std::string::iterator &data);
+    qint64 windowFirstLine { 0 };
 
-    std::string filestr;
+    qint64 windowLineCount { 0 };
 
-    int lastPosition { 0 };
+    bool updatingWindow { false };
 };
 }
 #endif   // TEXTBROWSER_H
@@ -0,0 +1,307 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "textfilemodel.h"
+
+#include <DTextEncoding>
+
+#include <QtConcurrent>
+
+#include <cerrno>
+#include <cstring>
+
+#include <iconv.h>
+
+using namespace plugin_filepreview;
+DCORE_USE_NAMESPACE
+
+// 每隔多少行记录一次行首偏移，定位任意行最多向后扫描这么多行
+static constexpr qint64 kCheckpointInterval { 64 };
+// 超长的行（或没有换行的文件）按此长度切分显示
+static constexpr qint64 kMaxLineBytes { 16 * 1024 };
+static constexpr int kSampleSize { 64 * 1024 };
+static constexpr qint64 kFlushBytes { 8 * 1024 * 1024 };
+static constexpr qint64 kFirstFlushLines { 1000 };
+// 无法映射的文件（如部分远程文件）只读取开头部分
+static constexpr qint64 kFallbackReadSize { 1024 * 1024 * 5 };
+
+TextFileModel::TextFileModel(QObject *parent)
+    : QObject(parent)
+{
+}
+
+TextFileModel::~TextFileModel()
+{
+    close();
+}
+
+bool TextFileModel::open(const QString &filePath)
+{
+    close();
+
+    file.setFileName(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        fmWarning() << "Text Preview: open file failed:" << filePath << file.errorString();
+        return false;
+    }
+
+    dataSize = file.size();
+    if (dataSize <= 0) {
+        file.close();
+        return false;
+    }
+
+    // NOTE: 映射的是打开时的文件大小，文件被截断后访问超出部分会触发 SIGBUS，
+    // 预览运行在独立进程中，影响范围有限
+    if (uchar *mapped = file.map(0, dataSize)) {
+        data = reinterpret_cast<const char *>(mapped);
+    } else {
+        fmWarning() << "Text Preview: map file failed, only the head is read:" << filePath << file.errorString();
+        buffer = file.read(kFallbackReadSize);
+        data = buffer.constData();
+        dataSize = buffer.size();
+        file.close();
+        if (dataSize <= 0)
+            return false;
+    }
+
+    detectEncoding();
+
+    stopIndex = false;
+    indexer = QtConcurrent::run([this]() { buildIndex(); });
+    return true;
+}
+
+void TextFileModel::close()
+{
+    stopIndex = true;
+    indexer.waitForFinished();
+
+    if (file.isOpen()) {
+        if (buffer.isEmpty() && data)
+            file.unmap(reinterpret_cast<uchar *>(const_cast<char *>(data)));
+        file.close();
+    }
+    buffer.clear();
+    data = nullptr;
+    dataSize = 0;
+    textStart = 0;
+    codec.clear();
+    newline = "\n";
+    unitSize = 1;
+
+    QMutexLocker locker(&mutex);
+    checkpoints.clear();
+    indexedLines = 0;
+}
+
+QByteArray TextFileModel::encoding() const
+{
+    return codec;
+}
+
+qint64 TextFileModel::lineCount() const
+{
+    QMutexLocker locker(&mutex);
+    return indexedLines;
+}
+
+bool TextFileModel::isIndexing() const
+{
+    return indexer.isRunning();
+}
+
+QString TextFileModel::lines(qint64 first, int count) const
+{
+    qint64 offset = 0;
+    qint64 available = 0;
+    {
+        QMutexLocker locker(&mutex);
+        if (first < 0 || first >= indexedLines || count <= 0)
+            return QString();
+        offset = checkpoints.at(int(first / kCheckpointInterval));
+        available = qMin<qint64>(count, indexedLines - first);
+    }
+
+    for (qint64 i = first - first % kCheckpointInterval; i < first; ++i)
+        offset = nextLineStart(offset);
+
+    QStringList texts;
+    texts.reserve(int(available));
+    for (qint64 i = 0; i < available; ++i) {
+        const qint64 end = nextLineStart(offset);
+        QString text = decode(offset, end);
+        if (text.endsWith('\n'))
+            text.chop(1);
+        if (text.endsWith('\r'))
+            text.chop(1);
+        texts.append(text);
+        offset = end;
+    }
+
+    return texts.join('\n');
+}
+
+void TextFileModel::detectEncoding()
+{
+    const uchar *head = reinterpret_cast<const uchar *>(data);
+    auto hasBom = [this, head](std::initializer_list<uchar> bom) {
+        if (dataSize < qint64(bom.size()))
+            return false;
+        return std::equal(bom.begin(), bom.end(), head);
+    };
+
+    if (hasBom({ 0xFF, 0xFE, 0x00, 0x00 })) {
+        codec = "UTF-32LE";
+        textStart = 4;
+    } else if (hasBom({ 0x00, 0x00, 0xFE, 0xFF })) {
+        codec = "UTF-32BE";
+        textStart = 4;
+    } else if (hasBom({ 0xFF, 0xFE })) {
+        codec = "UTF-16LE";
+        textStart = 2;
+    } else if (hasBom({ 0xFE, 0xFF })) {
+        codec = "UTF-16BE";
+        textStart = 2;
+    } else if (hasBom({ 0xEF, 0xBB, 0xBF })) {
+        codec = "UTF-8";
+        textStart = 3;
+    } else {
+        // 只用开头的样本检测编码，避免读取整个文件
+        const QByteArray &sample = QByteArray::fromRawData(data, int(qMin<qint64>(dataSize, kSampleSize)));
+        codec = DTextEncoding::detectTextEncoding(sample).toUpper();
+        if (codec.isEmpty() || codec == "ASCII" || codec == "US-ASCII")
+            codec = "UTF-8";
+        else if (codec == "UTF-16")
+            codec = "UTF-16LE";
+        else if (codec == "UTF-32")
+            codec = "UTF-32LE";
+    }
+
+    // 换行符按编码单元匹配，GBK 等兼容 ASCII 的编码中 0x0A 只会出现在换行处
+    if (codec == "UTF-16LE") {
+        newline = QByteArray("\n\0", 2);
+    } else if (codec == "UTF-16BE") {
+        newline = QByteArray("\0\n", 2);
+    } else if (codec == "UTF-32LE") {
+        newline = QByteArray("\n\0\0\0", 4);
+    } else if (codec == "UTF-32BE") {
+        newline = QByteArray("\0\0\0\n", 4);
+    } else {
+        newline = "\n";
+    }
+    unitSize = newline.size();
+}
+
+void TextFileModel::buildIndex()
+{
+    QVector<qint64> pending;
+    qint64 count = 0;
+    qint64 offset = textStart;
+    qint64 lastFlush = offset;
+
+    while (offset < dataSize && !stopIndex) {
+        if (count % kCheckpointInterval == 0)
+            pending.append(offset);
+        offset = nextLineStart(offset);
+        ++count;
+
+        // 尽早发布第一屏，之后按扫描量批量发布，减少加锁和信号
+        if (offset - lastFlush >= kFlushBytes || offset >= dataSize || count == kFirstFlushLines) {
+            {
+                QMutexLocker locker(&mutex);
+                checkpoints += pending;
+                indexedLines = count;
+            }
+            pending.clear();
+            lastFlush = offset;
+            emit lineCountChanged(count);
+        }
+    }
+}
+
+qint64 TextFileModel::nextLineStart(qint64 offset) const
+{
+    const qint64 limit = qMin(dataSize, offset + kMaxLineBytes);
+    const int newlinePos = newline.indexOf('\n');
+
+    qint64 pos = offset;
+    while (pos < limit) {
+        const void *hit = std::memchr(data + pos, '\n', size_t(limit - pos));
+        if (!hit)
+            break;
+
+        const qint64 unitBegin = static_cast<const char *>(hit) - data - newlinePos;
+        if (unitBegin >= offset && (unitBegin - textStart) % unitSize == 0 && unitBegin + unitSize <= dataSize
+            && std::memcmp(data + unitBegin, newline.constData(), size_t(unitSize)) == 0)
+            return unitBegin + unitSize;
+        pos = static_cast<const char *>(hit) - data + 1;
+    }
+
+    if (limit >= dataSize)
+        return dataSize;
+
+    // 切分超长的行时不能截断字符
+    const qint64 cut = characterBoundary(offset, limit - (limit - textStart) % unitSize);
+    return cut > offset ? cut : limit;
+}
+
+/*!
+ * \brief 返回 [offset, end) 中最后一个完整字符的结束位置
+ * \note
+ *  UTF-8 可以直接根据续字节判断，UTF-32 按编码单元对齐即可。
+ *  GBK、GB18030、Big5 等编码的尾字节可能落在 ASCII 范围内，UTF-16 还有代理对，
+ *  无法单看字节值判断边界，用 iconv 从行首连续解码，停在末尾不完整的字符之前。
+ */
+qint64 TextFileModel::characterBoundary(qint64 offset, qint64 end) const
+{
+    if (codec == "UTF-8") {
+        while (end > offset && (uchar(data[end]) & 0xC0) == 0x80)
+            --end;
+        return end;
+    }
+
+    if (codec.startsWith("UTF-32"))
+        return end;
+
+    iconv_t cd = iconv_open("UTF-8", codec.constData());
+    if (cd == reinterpret_cast<iconv_t>(-1))
+        return end;
+
+    char *in = const_cast<char *>(data + offset);
+    size_t inLeft = size_t(end - offset);
+    char out[4096];
+    while (inLeft > 0) {
+        char *outPtr = out;
+        size_t outLeft = sizeof(out);
+        if (iconv(cd, &in, &inLeft, &outPtr, &outLeft) != size_t(-1) || errno == EINVAL)
+            break;
+        // 非法字节解码时会被替换，跳过一个编码单元继续
+        if (errno == EILSEQ) {
+            const size_t skip = qMin(inLeft, size_t(unitSize));
+            in += skip;
+            inLeft -= skip;
+        } else if (errno != E2BIG) {
+            break;
+        }
+    }
+    iconv_close(cd);
+
+    // 解码停止处即为末尾不完整字符的开头
+    return in - data;
+}
+
+QString TextFileModel::decode(qint64 begin, qint64 end) const
+{
+    const QByteArray &bytes = QByteArray::fromRawData(data + begin, int(end - begin));
+    if (codec == "UTF-8")
+        return QString::fromUtf8(bytes);
+
+    QByteArray in(bytes.constData(), bytes.size());
+    QByteArray out;
+    if (DTextEncoding::convertTextEncoding(in, out, "UTF-8", codec))
+        return QString::fromUtf8(out);
+
+    return QString::fromLocal8Bit(bytes);
+}
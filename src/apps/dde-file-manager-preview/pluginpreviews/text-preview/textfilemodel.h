@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef TEXTFILEMODEL_H
+#define TEXTFILEMODEL_H
+
+#include "preview_plugin_global.h"
+
+#include <QObject>
+#include <QFile>
+#include <QFuture>
+#include <QMutex>
+#include <QVector>
+
+#include <atomic>
+
+namespace plugin_filepreview {
+
+/*!
+ * \brief The TextFileModel class gives line based access to a text file of any size.
+ *
+ * The file is memory mapped and a sparse line index (one offset every
+ * kCheckpointInterval lines) is built in the background, so lines can be
+ * fetched as soon as they are indexed and memory use does not depend on the
+ * file size. The encoding is detected from a sample at the head of the file
+ * and only the requested lines are decoded.
+ */
+class TextFileModel : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(TextFileModel)
+
+public:
+    explicit TextFileModel(QObject *parent = nullptr);
+    ~TextFileModel() override;
+
+    bool open(const QString &filePath);
+    void close();
+
+    QByteArray encoding() const;
+    qint64 lineCount() const;
+    bool isIndexing() const;
+    // 返回 [first, first + count) 行的文本，行间以 '\n' 分隔，末尾不带换行
+    QString lines(qint64 first, int count) const;
+
+Q_SIGNALS:
+    void lineCountChanged(qint64 count);
+
+private:
+    void detectEncoding();
+    void buildIndex();
+    qint64 nextLineStart(qint64 offset) const;
+    qint64 characterBoundary(qint64 offset, qint64 end) const;
+    QString decode(qint64 begin, qint64 end) const;
+
+    QFile file;
+    QByteArray buffer;   // 无法映射的文件只读取开头部分
+    const char *data { nullptr };
+    qint64 dataSize { 0 };
+    qint64 textStart { 0 };   // 跳过 BOM
+
+    QByteArray codec;
+    QByteArray newline { "\n" };
+    int unitSize { 1 };
+
+    mutable QMutex mutex;
+    QVector<qint64> checkpoints;
+    qint64 indexedLines { 0 };
+
+    QFuture<void> indexer;
+    std::atomic_bool stopIndex { false };
+};
+}
+
+#endif   // TEXTFILEMODEL_H
@@ -5,20 +5,16 @@
 #include "textpreview.h"
 #include "textbrowseredit.h"
 #include "textcontextwidget.h"
+#include "textfilemodel.h"
 
 #include <dfm-base/interfaces/fileinfo.h>
 
-#include <DTextEncoding>
-
-#include <QProcess>
 #include <QUrl>
 #include <QFileInfo>
 #include <QDebug>
 
-using namespace std;
 DFMBASE_USE_NAMESPACE
 using namespace plugin_filepreview;
-static constexpr int kReadTextSize { 1024 * 1024 * 5 };
 
 TextPreview::TextPreview(QObject *parent)
     : AbstractBasePreview(parent)
@@ -38,9 +34,10 @@ bool TextPreview::setFileUrl(const QUrl &url)
 
     selectUrl = url;
 
-    device.open(url.path().toLocal8Bit().data(), ios::binary);
+    if (!fileModel)
+        fileModel = new TextFileModel(this);
 
-    if (!device.is_open()) {
+    if (!fileModel->open(url.toLocalFile())) {
         fmWarning() << "Text Preview: File open failed!";
         return false;
     }
@@ -51,28 +48,7 @@ bool TextPreview::setFileUrl(const QUrl &url)
 
     titleStr = QFileInfo(url.toLocalFile()).fileName();
 
-    long len = device.seekg(0, ios::end).tellg();
-    if (len <= 0)
-        return false;
-
-    if (len > kReadTextSize)
-        len = kReadTextSize;
-
-    char *buf = new char[static_cast<unsigned long>(len)];
-    device.seekg(0, ios::beg).read(buf, static_cast<streamsize>(len));
-    device.close();
-    bool ok { false };
-    QString fileEncoding = DTK_NAMESPACE::DCORE_NAMESPACE::DTextEncoding::detectFileEncoding(url.path(), &ok);
-    std::string strBuf(buf, static_cast<unsigned long>(len));
-    if (ok && fileEncoding.toLower() != "utf-8") {
-        QByteArray out;
-        QByteArray in(buf, static_cast<int>(len));
-        if (DTK_NAMESPACE::DCORE_NAMESPACE::DTextEncoding::convertTextEncoding(in, out, "utf-8"))
-            strBuf = out.toStdString();
-    }
-    textBrowser->textBrowserEdit()->setFileData(strBuf);
-    delete[] buf;
-    buf = nullptr;
+    textBrowser->textBrowserEdit()->setFileModel(fileModel);
 
     Q_EMIT titleChanged();
 
@@ -14,10 +14,9 @@
 #include <QTimer>
 #include <QString>
 
-#include <fstream>
-
 namespace plugin_filepreview {
 class TextContextWidget;
+class TextFileModel;
 class TextPreview : public DFMBASE_NAMESPACE::AbstractBasePreview
 {
     Q_OBJECT
@@ -40,12 +39,8 @@ private:
 
     TextContextWidget *textBrowser { nullptr };
 
-    //! 操作文件的对象
-    std::ifstream device;
-
-    int textSize = 0;
-
-    int readSize = 0;
+    //! 按行索引的文件内容，只解码显示的部分
+    TextFileModel *fileModel { nullptr };
 };
 }
 #endif   // TEXTPREVIEW_H
@@ -12,6 +12,7 @@
 #include <dfm-base/dfm_plugin_defines.h>
 #include <dfm-base/utils/sysinfoutils.h>
 #include <dfm-base/utils/loggerrules.h>
+#include <dfm-base/utils/infocache.h>
 #include <dfm-base/base/configs/dconfig/dconfigmanager.h>
 
 #include <dfm-framework/dpf.h>
@@ -376,8 +377,10 @@ int main(int argc, char *argv[])
 
     // NOTE: temp code!!!!!!!!!!!
     QScopedPointer<dfm_drag::DragMoniter> mo(new dfm_drag::DragMoniter);
-    if (!SysInfoUtils::isOpenAsAdmin())
+    if (!SysInfoUtils::isOpenAsAdmin()) {
         mo->registerDBus();
+        InfoCacheController::instance().registerDBus();
+    }
 
     qCWarning(logAppFileManager) << " --- app start --- pid = " << a.applicationPid();
     int ret { a.exec() };
@@ -15,6 +15,8 @@
 #include <QVariantMap>
 #include <QDebug>
 #include <QStorageInfo>
+#include <QFile>
+#include <QFileInfo>
 #include <QtConcurrent>
 
 #include <dfm-mount/dmount.h>
@@ -27,6 +29,12 @@ using namespace dfmbase;
 DFM_MOUNT_USE_NS
 using namespace GlobalServerDefines;
 
+// 设备正在被写入时（如拷贝任务的目标盘）使用最短的采样间隔
+static constexpr int kActiveSampleInterval { 2000 };
+static constexpr int kIdleSampleInterval { 10000 };
+// 容量长时间不变的设备（多为网络设备）逐步降低采样频率
+static constexpr int kMaxIdleSampleInterval { 30000 };
+
 DeviceWatcher::DeviceWatcher(QObject *parent)
     : QObject(parent), d(new DeviceWatcherPrivate(this))
 {
@@ -53,14 +61,120 @@ void DeviceWatcher::stopPollingUsage()
 
 void DeviceWatcherPrivate::queryUsageAsync()
 {
-    QtConcurrent::run([this] {
-        auto blocks = allBlockInfos;
-        auto protocols = allProtocolInfos;
-        std::for_each(blocks.cbegin(), blocks.cend(),
-                      [this](const QVariantMap &item) { queryUsageOfItem(item, DeviceType::kBlockDevice); });
-        std::for_each(protocols.cbegin(), protocols.cend(),
-                      [this](const QVariantMap &item) { queryUsageOfItem(item, DeviceType::kProtocolDevice); });
-    });
+    const auto blocks = allBlockInfos;
+    const auto protocols = allProtocolInfos;
+    {
+        QMutexLocker locker(&sampleMutex);
+        sampledDevices = QSet<QString>(blocks.keyBegin(), blocks.keyEnd());
+        sampledDevices.unite(QSet<QString>(protocols.keyBegin(), protocols.keyEnd()));
+    }
+
+    // block devices are queried locally, skip this tick if the last one is still running
+    if (!isQueryingBlocks.exchange(true)) {
+        QtConcurrent::run([this, blocks] {
+            FinallyUtil finally([this] { isQueryingBlocks = false; });
+            for (auto iter = blocks.cbegin(); iter != blocks.cend(); ++iter) {
+                if (isUsageSampleDue(iter.key(), iter.value(), DeviceType::kBlockDevice))
+                    queryUsageOfItem(iter.value(), DeviceType::kBlockDevice);
+            }
+        });
+    }
+
+    // a network device may not respond for a long time (gvfs blocks in sizeTotal/sizeFree),
+    // so each protocol device is queried on its own and a hung one only delays itself
+    for (auto iter = protocols.cbegin(); iter != protocols.cend(); ++iter) {
+        const QString id = iter.key();
+        {
+            QMutexLocker locker(&sampleMutex);
+            if (queryingDevices.contains(id))
+                continue;
+        }
+        if (!isUsageSampleDue(id, iter.value(), DeviceType::kProtocolDevice))
+            continue;
+        {
+            QMutexLocker locker(&sampleMutex);
+            queryingDevices.insert(id);
+        }
+        const QVariantMap data = iter.value();
+        QtConcurrent::run([this, id, data] {
+            FinallyUtil finally([this, id] {
+                QMutexLocker locker(&sampleMutex);
+                queryingDevices.remove(id);
+            });
+            queryUsageOfItem(data, DeviceType::kProtocolDevice);
+        });
+    }
+}
+
+/*!
+ * \brief DeviceWatcherPrivate::isUsageSampleDue
+ * Each mounted device is sampled at its own pace: quickly while the device is
+ * being written (block devices only, judged by the written sectors in sysfs),
+ * at the idle interval after its usage changed, and slower and slower while
+ * its usage stays the same.
+ */
+bool DeviceWatcherPrivate::isUsageSampleDue(const QString &id, const QVariantMap &itemData, DFMMOUNT::DeviceType type)
+{
+    QMutexLocker locker(&sampleMutex);
+    auto iter = usageSamples.find(id);
+    if (iter == usageSamples.end())
+        return true;
+
+    if (type == DeviceType::kBlockDevice) {
+        const qint64 sectors = readWrittenSectors(itemData.value(DeviceProperty::kDevice).toString());
+        if (iter->writtenSectors >= 0 && sectors != iter->writtenSectors)
+            iter->interval = kActiveSampleInterval;
+        iter->writtenSectors = sectors;
+    }
+    return sampleClock.elapsed() - iter->lastSampleTime >= iter->interval;
+}
+
+/*!
+ * \brief DeviceWatcherPrivate::publishUsage
+ * \return true if the usage is changed and devSizeChanged is emitted.
+ * The query runs on a snapshot of the devices, a device removed or unmounted
+ * during the query is dropped here instead of re-creating its sample.
+ */
+bool DeviceWatcherPrivate::publishUsage(const QString &id, const DevStorage &storage)
+{
+    {
+        QMutexLocker locker(&sampleMutex);
+        if (!sampledDevices.contains(id))
+            return false;
+        auto &sample = usageSamples[id];
+        const bool changed = sample.storage != storage;
+        sample.lastSampleTime = sampleClock.elapsed();
+        if (changed)
+            sample.interval = sample.interval > 0 ? qMin(sample.interval, kIdleSampleInterval) : kIdleSampleInterval;
+        else
+            sample.interval = qMin(qMax(sample.interval, kIdleSampleInterval) * 2, kMaxIdleSampleInterval);
+        if (!changed)
+            return false;
+        sample.storage = storage;
+    }
+
+    emit DevMngIns->devSizeChanged(id, storage.total, storage.avai);
+    return true;
+}
+
+void DeviceWatcherPrivate::removeUsageSample(const QString &id)
+{
+    QMutexLocker locker(&sampleMutex);
+    usageSamples.remove(id);
+    sampledDevices.remove(id);
+}
+
+qint64 DeviceWatcherPrivate::readWrittenSectors(const QString &device)
+{
+    if (device.isEmpty())
+        return -1;
+
+    // see Documentation/block/stat.rst, the 7th field is the count of written sectors
+    QFile stat(QString("/sys/class/block/%1/stat").arg(QFileInfo(device).fileName()));
+    if (!stat.open(QIODevice::ReadOnly))
+        return -1;
+    const auto &fields = stat.readAll().simplified().split(' ');
+    return fields.count() > 6 ? fields.at(6).toLongLong() : -1;
 }
 
 void DeviceWatcherPrivate::updateStorage(const QString &id, quint64 total, quint64 avai)
@@ -100,12 +214,8 @@ void DeviceWatcherPrivate::queryUsageOfItem(const QVariantMap &itemData, dfmmoun
             ? queryUsageOfBlock(itemData)
             : queryUsageOfProtocol(itemData);
 
-    if (/*old != newStorage && */ newStorage.isValid()) {
-        const QString &devId = itemData.value(DeviceProperty::kId).toString();
-        emit DevMngIns->devSizeChanged(devId,
-                                       newStorage.total,
-                                       newStorage.avai);
-    }
+    if (newStorage.isValid())
+        publishUsage(itemData.value(DeviceProperty::kId).toString(), newStorage);
 }
 
 DevStorage DeviceWatcherPrivate::queryUsageOfBlock(const QVariantMap &itemData)
@@ -326,6 +436,7 @@ void DeviceWatcher::onBlkDevRemoved(const QString &id)
     qCDebug(logDFMBase) << "block device removed: " << id;
     QString oldMpt = d->allBlockInfos.value(id).value(DeviceProperty::kMountPoint).toString();
     d->allBlockInfos.remove(id);
+    d->removeUsageSample(id);
     emit DevMngIns->blockDevRemoved(id, oldMpt);
 }
 
@@ -347,6 +458,7 @@ void DeviceWatcher::onBlkDevUnmounted(const QString &id)
     d->allBlockInfos[id][DeviceProperty::kMountPoint] = QString();
     d->allBlockInfos[id].remove(DeviceProperty::kSizeFree);
     d->allBlockInfos[id].remove(DeviceProperty::kSizeUsed);
+    d->removeUsageSample(id);
     emit DevMngIns->blockDevUnmounted(id, oldMpt);
 }
 
@@ -432,6 +544,7 @@ void DeviceWatcher::onProtoDevRemoved(const QString &id)
     qCDebug(logDFMBase) << "protocol device removed: " << id;
     QString oldMpt = d->allProtocolInfos.value(id).value(DeviceProperty::kMountPoint).toString();
     d->allProtocolInfos.remove(id);
+    d->removeUsageSample(id);
 
     emit DevMngIns->protocolDevRemoved(id, oldMpt);
 }
@@ -451,6 +564,7 @@ void DeviceWatcher::onProtoDevUnmounted(const QString &id)
     //    else
     QString oldMpt = d->allProtocolInfos.value(id).value(DeviceProperty::kMountPoint).toString();
     d->allProtocolInfos.remove(id);
+    d->removeUsageSample(id);
 
     emit DevMngIns->protocolDevUnmounted(id, oldMpt);
 }
@@ -521,4 +635,5 @@ DeviceWatcherPrivate::DeviceWatcherPrivate(DeviceWatcher *qq)
 {
     connect(DevProxyMng, &DeviceProxyManager::devSizeChanged, this, &DeviceWatcherPrivate::updateStorage, Qt::QueuedConnection);
     DConfigManager::instance()->addConfig("org.deepin.dde.file-manager.mount");
+    sampleClock.start();
 }
@@ -8,10 +8,14 @@
 #include <QTimer>
 #include <QMutex>
 #include <QHash>
+#include <QSet>
+#include <QElapsedTimer>
 #include <QtCore/qobjectdefs.h>
 
 #include <dfm-mount/base/dmount_global.h>
 
+#include <atomic>
+
 namespace dfmbase {
 
 struct DevStorage
@@ -20,20 +24,28 @@ struct DevStorage
     quint64 avai { 0 };
     quint64 used { 0 };
 
-    inline bool operator==(const DevStorage &other)
+    inline bool operator==(const DevStorage &other) const
     {
         return total == other.total && avai == other.avai && used == other.used;
     }
-    inline bool operator!=(const DevStorage &other)
+    inline bool operator!=(const DevStorage &other) const
     {
         return !(this->operator==(other));
     }
-    inline bool isValid()
+    inline bool isValid() const
     {
         return this->operator!=({});
     }
 };
 
+struct DevUsageSample
+{
+    DevStorage storage;
+    qint64 writtenSectors { -1 };
+    qint64 lastSampleTime { 0 };   // msecs of DeviceWatcherPrivate::sampleClock
+    int interval { 0 };   // msecs to the next sample
+};
+
 class DeviceWatcher;
 class DeviceWatcherPrivate : public QObject
 {
@@ -51,12 +63,26 @@ private:
     void queryUsageOfItem(const QVariantMap &itemData, DFMMOUNT::DeviceType type);
     DevStorage queryUsageOfBlock(const QVariantMap &itemData);
     DevStorage queryUsageOfProtocol(const QVariantMap &itemData);
+    bool isUsageSampleDue(const QString &id, const QVariantMap &itemData, DFMMOUNT::DeviceType type);
+    bool publishUsage(const QString &id, const DevStorage &storage);
+    void removeUsageSample(const QString &id);
+    static qint64 readWrittenSectors(const QString &device);
 
 private:
     DeviceWatcher *q { nullptr };
 
     QTimer pollingTimer;
-    const int kPollingInterval = 10000;
+    // each device decides on every tick whether it needs a new sample, see isUsageSampleDue
+    const int kPollingInterval = 2000;
+
+    std::atomic_bool isQueryingBlocks { false };
+    QElapsedTimer sampleClock;
+    QMutex sampleMutex;
+    QHash<QString, DevUsageSample> usageSamples;
+    // devices of the running query, a device removed meanwhile must not be published
+    QSet<QString> sampledDevices;
+    // protocol devices whose usage query has not returned yet
+    QSet<QString> queryingDevices;
 
     QHash<QString, QVariantMap> allBlockInfos;
     QHash<QString, QVariantMap> allProtocolInfos;
@@ -35,6 +35,8 @@ QString InfoFactory::scheme(const QUrl &url)
 
 QSharedPointer<FileInfo> InfoFactory::getFileInfoFromCache(const QUrl &url, Global::CreateFileInfoType type, QString *errorString)
 {
+    // 先取分片代数，创建期间该 url 所在分片有缓存被移除时不写回缓存
+    const quint64 generation = InfoCacheController::instance().generation(url);
     QSharedPointer<FileInfo> info = InfoCacheController::instance().getCacheInfo(url);
     if (!info) {
         if (type == Global::CreateFileInfoType::kCreateFileInfoSyncAndCache) {
@@ -46,7 +48,7 @@ QSharedPointer<FileInfo> InfoFactory::getFileInfoFromCache(const QUrl &url, Glob
             }
         }
         if (info)
-            emit InfoCacheController::instance().cacheFileInfo(url, info);
+            InfoCacheController::instance().cacheInfo(url, info, generation);
     }
     return info;
 }
@@ -4,6 +4,8 @@
 
 #include "localfileiconprovider.h"
 
+#include <dfm-base/utils/iconpixmapcache.h>
+
 #include <dfm-io/dfileinfo.h>
 
 namespace dfmbase {
@@ -42,8 +44,8 @@ QIcon LocalFileIconProviderPrivate::fileSystemIcon(const QString &path) const
 QIcon LocalFileIconProviderPrivate::fromTheme(QString iconName) const
 {
     assert(QThread::currentThread() == qApp->thread());
-    QIcon icon;
-    icon = QIcon::fromTheme(iconName);
+    // 同名主题图标只解析一次，主题切换时由 IconPixmapCache 统一失效
+    QIcon icon = IconPixmapCache::instance()->themeIcon(iconName);
 
     if (Q_LIKELY(!icon.isNull()))
         return icon;
@@ -60,7 +62,7 @@ QIcon LocalFileIconProviderPrivate::fromTheme(QString iconName) const
         return icon;
     }
 
-    icon = QIcon::fromTheme(iconName);
+    icon = IconPixmapCache::instance()->themeIcon(iconName);
 
     return icon;
 }
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "dmimedatabase.h"
+#include "mimecache.h"
 
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/base/schemefactory.h>
@@ -75,7 +76,7 @@ QMimeType DMimeDatabase::mimeTypeForFile(const FileInfoPointer &fileInfo, QMimeD
     if (isMatchExtension || ProtocolUtils::isRemoteFile(QUrl::fromLocalFile(path))) {
         result = QMimeDatabase::mimeTypeForFile(fileInfo->pathOf(PathInfoType::kFilePath), QMimeDatabase::MatchExtension);
     } else {
-        result = QMimeDatabase::mimeTypeForFile(fileInfo->pathOf(PathInfoType::kFilePath), mode);
+        result = sniffMimeType(fileInfo->pathOf(PathInfoType::kFilePath), mode);
     }
 
     // temporary dirty fix, once WPS get installed, the whole mimetype database thing get fscked up.
@@ -151,7 +152,7 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabas
     if (isMatchExtension || ProtocolUtils::isRemoteFile(QUrl::fromLocalFile(path))) {
         result = QMimeDatabase::mimeTypeForFile(fileInfo, QMimeDatabase::MatchExtension);
     } else {
-        result = QMimeDatabase::mimeTypeForFile(fileInfo, mode);
+        result = sniffMimeType(fileInfo.absoluteFilePath(), mode);
     }
 
     // temporary dirty fix, once WPS get installed, the whole mimetype database thing get fscked up.
@@ -176,6 +177,32 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabas
     return result;
 }
 
+/*!
+ * \brief DMimeDatabase::sniffMimeType 带持久化缓存的内容探测
+ * 以 (dev, inode, mtime, size) 为键在进程间共享结果，文件未变化时跳过 magic 探测
+ */
+QMimeType DMimeDatabase::sniffMimeType(const QString &filePath, QMimeDatabase::MatchMode mode) const
+{
+    if (mode == QMimeDatabase::MatchExtension)
+        return QMimeDatabase::mimeTypeForFile(filePath, mode);
+
+    MimeCache::Key key;
+    const bool canCache = MimeCache::makeKey(filePath, mode, &key);
+    if (canCache) {
+        const QString &name = MimeCache::instance()->lookup(key);
+        if (!name.isEmpty()) {
+            const QMimeType &type = mimeTypeForName(name);
+            if (type.isValid())
+                return type;
+        }
+    }
+
+    const QMimeType &result = QMimeDatabase::mimeTypeForFile(filePath, mode);
+    if (canCache && result.isValid())
+        MimeCache::instance()->insert(key, result.name());
+    return result;
+}
+
 QMimeType DMimeDatabase::mimeTypeForUrl(const QUrl &url) const
 {
     if (url.isLocalFile())
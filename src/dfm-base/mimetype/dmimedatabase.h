@@ -26,6 +26,7 @@ public:
 
 private:
     QMimeType mimeTypeForFile(const QFileInfo &fileInfo, MatchMode mode, const QString &inod, const bool isGvfs = false) const;
+    QMimeType sniffMimeType(const QString &filePath, MatchMode mode) const;
 
 private:
     QHash<QString, QMimeType> inodMimetypeCache;
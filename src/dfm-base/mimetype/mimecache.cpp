@@ -0,0 +1,300 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mimecache.h"
+#include "private/mimecache_p.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace dfmbase;
+
+namespace {
+constexpr quint32 kCacheMagic = 0x454d494d;   // "MIME"
+constexpr quint32 kCacheVersion = 1;
+constexpr quint32 kProbeCount = 8;
+// 写入只需几十纳秒，奇数 seq 持续这么久说明写入方已退出
+constexpr qint64 kStuckSlotTimeout = 1000;   // ms
+constexpr qint64 kStampCheckInterval = 30 * 1000;   // ms
+
+constexpr qint64 kCacheFileSize = sizeof(CacheHeader) + qint64(sizeof(CacheSlot)) * kSlotCount;
+
+bool keyMatches(const CacheSlot &slot, const MimeCache::Key &key)
+{
+    return slot.dev == key.dev && slot.ino == key.ino && slot.mode == key.mode;
+}
+
+qint64 steadyMsecs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+}
+}
+
+MimeCache *MimeCache::instance()
+{
+    static MimeCache ins(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+                         + "/deepin/dde-file-manager/mime-cache");
+    return &ins;
+}
+
+bool MimeCache::makeKey(const QString &filePath, int mode, MimeCache::Key *key)
+{
+    struct stat st;
+    if (::stat(QFile::encodeName(filePath).constData(), &st) != 0 || !S_ISREG(st.st_mode))
+        return false;
+
+    key->dev = st.st_dev;
+    key->ino = st.st_ino;
+    key->mtime = qint64(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    key->size = st.st_size;
+    key->mode = quint8(mode);
+    return true;
+}
+
+MimeCache::MimeCache(const QString &filePath)
+{
+    if (!open(filePath) && fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+MimeCache::~MimeCache()
+{
+    if (data)
+        ::munmap(data, size_t(dataSize));
+    if (fd >= 0)
+        ::close(fd);
+}
+
+bool MimeCache::open(const QString &filePath)
+{
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+    fd = ::open(QFile::encodeName(filePath).constData(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        qCWarning(logDFMBase) << "open mime cache failed:" << filePath << strerror(errno);
+        return false;
+    }
+
+    // 多个进程可能同时初始化，持有文件锁完成校验与重建
+    if (::flock(fd, LOCK_EX) != 0)
+        return false;
+
+    struct stat st;
+    bool ok = ::fstat(fd, &st) == 0;
+    // 只扩不缩，缩小文件会让其它进程中已映射的页触发 SIGBUS
+    if (ok && st.st_size < kCacheFileSize)
+        ok = ::ftruncate(fd, kCacheFileSize) == 0;
+
+    if (ok) {
+        void *addr = ::mmap(nullptr, size_t(kCacheFileSize), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr != MAP_FAILED) {
+            data = static_cast<uchar *>(addr);
+            dataSize = kCacheFileSize;
+        } else {
+            ok = false;
+        }
+    }
+
+    if (ok) {
+        auto header = reinterpret_cast<CacheHeader *>(data);
+        const qint64 stamp = databaseStamp();
+        if (header->magic != kCacheMagic || header->version != kCacheVersion
+            || header->slotCount != kSlotCount || header->databaseStamp != stamp) {
+            std::memset(data + sizeof(CacheHeader), 0, size_t(kCacheFileSize - qint64(sizeof(CacheHeader))));
+            header->slotCount = kSlotCount;
+            header->version = kCacheVersion;
+            header->databaseStamp = stamp;
+            header->reserved = 0;
+            header->magic = kCacheMagic;
+        }
+    } else {
+        qCWarning(logDFMBase) << "map mime cache failed:" << filePath << strerror(errno);
+    }
+
+    ::flock(fd, LOCK_UN);
+    nextStampCheck = steadyMsecs() + kStampCheckInterval;
+    return ok;
+}
+
+qint64 MimeCache::databaseStamp()
+{
+    qint64 stamp = 0;
+    const QStringList &caches = QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, "mime/mime.cache");
+    for (const QString &path : caches) {
+        struct stat st;
+        if (::stat(QFile::encodeName(path).constData(), &st) == 0)
+            stamp = qMax(stamp, qint64(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec);
+    }
+    return stamp;
+}
+
+bool MimeCache::isValid() const
+{
+    return data != nullptr;
+}
+
+QString MimeCache::lookup(const MimeCache::Key &key) const
+{
+    if (!data)
+        return QString();
+
+    checkDatabase();
+
+    auto slots = reinterpret_cast<CacheSlot *>(data + sizeof(CacheHeader));
+    const quint32 start = slotIndex(key);
+    for (quint32 i = 0; i < kProbeCount; ++i) {
+        CacheSlot &slot = slots[(start + i) % kSlotCount];
+        const quint32 seq = slot.seq.load(std::memory_order_acquire);
+        if (seq & 1)
+            continue;
+
+        if (!keyMatches(slot, key) || slot.nameLength == 0)
+            continue;
+
+        const bool fresh = slot.mtime == key.mtime && slot.size == key.size;
+        const int length = qMin<int>(slot.nameLength, kNameSize);
+        char name[kNameSize];
+        std::memcpy(name, slot.name, size_t(length));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq)
+            return QString();
+
+        // inode 命中但文件已被修改，视为未命中，由调用方重新探测后覆盖
+        return fresh ? QString::fromLatin1(name, length) : QString();
+    }
+    return QString();
+}
+
+void MimeCache::insert(const MimeCache::Key &key, const QString &mimeName)
+{
+    const QByteArray &name = mimeName.toLatin1();
+    if (!data || name.isEmpty() || name.size() > kNameSize)
+        return;
+
+    auto slots = reinterpret_cast<CacheSlot *>(data + sizeof(CacheHeader));
+    const quint32 start = slotIndex(key);
+    // 优先复用同一文件或空闲的槽，探测范围内都被占用时覆盖起始槽
+    CacheSlot *target = &slots[start];
+    for (quint32 i = 0; i < kProbeCount; ++i) {
+        CacheSlot &slot = slots[(start + i) % kSlotCount];
+        if (slot.nameLength == 0 || keyMatches(slot, key)) {
+            target = &slot;
+            break;
+        }
+    }
+
+    quint32 seq = target->seq.load(std::memory_order_relaxed);
+    if (seq & 1) {
+        if (!reclaimStuckSlot(quint32(target - slots), seq))
+            return;
+        seq += 3;
+    }
+    if (!target->seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire))
+        return;
+    std::atomic_thread_fence(std::memory_order_release);
+
+    target->mode = key.mode;
+    target->dev = key.dev;
+    target->ino = key.ino;
+    target->mtime = key.mtime;
+    target->size = key.size;
+    std::memcpy(target->name, name.constData(), size_t(name.size()));
+    target->nameLength = quint8(name.size());
+
+    target->seq.store(seq + 2, std::memory_order_release);
+}
+
+void MimeCache::clear()
+{
+    resetSlots();
+}
+
+/*!
+ * \brief MimeCache::checkDatabase 节流检查 shared-mime-info 数据库，更新后整表作废
+ */
+void MimeCache::checkDatabase() const
+{
+    const qint64 now = steadyMsecs();
+    qint64 next = nextStampCheck.load(std::memory_order_relaxed);
+    if (now < next || !nextStampCheck.compare_exchange_strong(next, now + kStampCheckInterval))
+        return;
+
+    auto header = reinterpret_cast<CacheHeader *>(data);
+    const qint64 stamp = databaseStamp();
+    if (header->databaseStamp == stamp)
+        return;
+
+    // 其它进程可能同时发现数据库变化，加锁后再确认一次
+    if (::flock(fd, LOCK_EX) != 0)
+        return;
+    if (header->databaseStamp != stamp) {
+        resetSlots();
+        header->databaseStamp = stamp;
+    }
+    ::flock(fd, LOCK_UN);
+}
+
+void MimeCache::resetSlots() const
+{
+    if (!data)
+        return;
+
+    auto slots = reinterpret_cast<CacheSlot *>(data + sizeof(CacheHeader));
+    for (quint32 i = 0; i < kSlotCount; ++i) {
+        quint32 seq = slots[i].seq.load(std::memory_order_relaxed);
+        if ((seq & 1) || !slots[i].seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire))
+            continue;
+        std::atomic_thread_fence(std::memory_order_release);
+        slots[i].nameLength = 0;
+        slots[i].seq.store(seq + 2, std::memory_order_release);
+    }
+}
+
+/*!
+ * \brief MimeCache::reclaimStuckSlot 回收写入方崩溃后一直处于写入状态的槽位
+ * \return 槽位已回收为 seq + 3 的空槽时返回 true
+ */
+bool MimeCache::reclaimStuckSlot(quint32 index, quint32 seq)
+{
+    const qint64 now = steadyMsecs();
+    {
+        QMutexLocker lk(&stuckMutex);
+        auto it = stuckSlots.find(index);
+        if (it == stuckSlots.end() || it->first != seq) {
+            stuckSlots.insert(index, { seq, now });
+            return false;
+        }
+        if (now - it->second < kStuckSlotTimeout)
+            return false;
+        stuckSlots.erase(it);
+    }
+
+    // 以 seq + 2（仍为奇数）接管槽位，清空后置为偶数，读者据此丢弃其间读到的内容
+    auto slots = reinterpret_cast<CacheSlot *>(data + sizeof(CacheHeader));
+    CacheSlot &slot = slots[index];
+    quint32 expected = seq;
+    if (!slot.seq.compare_exchange_strong(expected, seq + 2, std::memory_order_acquire))
+        return false;
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.nameLength = 0;
+    slot.seq.store(seq + 3, std::memory_order_release);
+
+    qCInfo(logDFMBase) << "mime cache: reclaimed slot left by an interrupted writer" << index;
+    return true;
+}
@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MIMECACHE_H
+#define MIMECACHE_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include <atomic>
+
+namespace dfmbase {
+
+/*!
+ * \brief The MimeCache class is a persistent cache of content sniffed mime
+ * types, keyed by (device, inode, mtime, size) and the match mode.
+ *
+ * The table is a fixed size file mmap'd from ~/.cache/deepin/dde-file-manager,
+ * so dde-file-manager, dde-desktop and the daemon share the results and a
+ * directory re-opened in any of them skips magic sniffing. Every slot is
+ * guarded by a sequence counter: readers retry or miss on a concurrent write,
+ * and writers give up when the slot is taken, the cache being best effort.
+ * A slot left odd by a writer that died mid-write is reclaimed once it has
+ * stayed unchanged for a while. Lookups re-check the shared-mime-info
+ * database at most every 30 seconds and drop the table when it changed.
+ */
+class MimeCache
+{
+public:
+    struct Key
+    {
+        quint64 dev { 0 };
+        quint64 ino { 0 };
+        qint64 mtime { 0 };   // ns
+        qint64 size { 0 };
+        quint8 mode { 0 };   // QMimeDatabase::MatchMode
+    };
+
+    static MimeCache *instance();
+    // 仅普通文件可以缓存，其它类型返回 false
+    static bool makeKey(const QString &filePath, int mode, Key *key);
+
+    bool isValid() const;
+    QString lookup(const Key &key) const;
+    void insert(const Key &key, const QString &mimeName);
+    void clear();
+
+private:
+    explicit MimeCache(const QString &filePath);
+    ~MimeCache();
+    Q_DISABLE_COPY(MimeCache)
+
+    bool open(const QString &filePath);
+    void checkDatabase() const;
+    void resetSlots() const;
+    bool reclaimStuckSlot(quint32 index, quint32 seq);
+    static qint64 databaseStamp();
+
+    int fd { -1 };
+    uchar *data { nullptr };
+    qint64 dataSize { 0 };
+    mutable std::atomic<qint64> nextStampCheck { 0 };   // ms, steady clock
+
+    // 本进程观察到的写入中槽位：槽位 -> (seq, 首次发现时间 ms)
+    QMutex stuckMutex;
+    QHash<quint32, QPair<quint32, qint64>> stuckSlots;
+};
+
+}
+
+#endif   // MIMECACHE_H
@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MIMECACHE_P_H
+#define MIMECACHE_P_H
+
+#include <dfm-base/mimetype/mimecache.h>
+
+#include <atomic>
+
+namespace dfmbase {
+
+// 共享映射文件的布局，修改时需递增 kCacheVersion
+inline constexpr quint32 kSlotCount = 32768;
+inline constexpr int kNameSize = 88;
+
+struct CacheHeader
+{
+    quint32 magic;
+    quint32 version;
+    quint32 slotCount;
+    quint32 reserved;
+    qint64 databaseStamp;   // shared-mime-info 数据库的修改时间，数据库更新后整表作废
+};
+
+struct CacheSlot
+{
+    std::atomic<quint32> seq;   // 奇数表示正在写入
+    quint8 mode;
+    quint8 nameLength;   // 0 表示空槽
+    quint16 reserved;
+    quint64 dev;
+    quint64 ino;
+    qint64 mtime;
+    qint64 size;
+    char name[kNameSize];
+};
+
+static_assert(std::atomic<quint32>::is_always_lock_free, "slot sequence must be lock free to live in shared memory");
+static_assert(sizeof(CacheSlot) == 128, "unexpected slot layout");
+
+inline quint32 slotIndex(const MimeCache::Key &key)
+{
+    quint64 h = key.ino * 0x9e3779b97f4a7c15ULL;
+    h ^= key.dev + (h >> 29);
+    return quint32(h % kSlotCount);
+}
+
+}
+
+#endif   // MIMECACHE_P_H
@@ -10,19 +10,67 @@
 #include <QTextDocument>
 #include <QTextLayout>
 #include <QTextBlock>
+#include <QGlyphRun>
+#include <QCache>
+#include <QMutex>
 #include <QDebug>
 
 #include <dfm-base/dfm_base_global.h>
 
 using namespace dfmbase;
 
-ElideTextLayout::ElideTextLayout(const QString &text)
-    : document(new QTextDocument)
+namespace {
+// 排版结果缓存，位置均相对于排版时的 origin，复用时整体平移
+struct CachedTextLine
+{
+    QRectF rect;
+    QString text;
+    QList<QGlyphRun> glyphRuns;
+};
+
+struct CachedTextLayout
+{
+    QPointF origin;
+    QList<CachedTextLine> lines;
+};
+
+constexpr int kLayoutCacheCapacity { 4096 };
+
+class TextLayoutCache
 {
-    document->setPlainText(text);
+public:
+    TextLayoutCache() { cache.setMaxCost(kLayoutCacheCapacity); }
+
+    bool find(const QString &key, CachedTextLayout *layout)
+    {
+        QMutexLocker lk(&mutex);
+        const CachedTextLayout *cached = cache.object(key);
+        if (!cached)
+            return false;
+        *layout = *cached;
+        return true;
+    }
+
+    void insert(const QString &key, const CachedTextLayout &layout)
+    {
+        QMutexLocker lk(&mutex);
+        cache.insert(key, new CachedTextLayout(layout));
+    }
 
-    attributes.insert(kFont, document->defaultFont());
-    attributes.insert(kLineHeight, QFontMetrics(document->defaultFont()).height());
+private:
+    QMutex mutex;
+    QCache<QString, CachedTextLayout> cache;
+};
+
+Q_GLOBAL_STATIC(TextLayoutCache, layoutCache)
+}
+
+ElideTextLayout::ElideTextLayout(const QString &text)
+    : plainText(text)
+{
+    const QFont font;
+    attributes.insert(kFont, font);
+    attributes.insert(kLineHeight, QFontMetrics(font).height());
     attributes.insert(kBackgroundRadius, 0);
     attributes.insert(kAlignment, Qt::AlignHCenter);
     attributes.insert(kWrapMode, (uint)QTextOption::WrapAtWordBoundaryOrAnywhere);
@@ -37,18 +85,70 @@ ElideTextLayout::~ElideTextLayout()
 
 void ElideTextLayout::setText(const QString &text)
 {
-    document->setPlainText(text);
+    plainText = text;
+    if (document)
+        document->setPlainText(text);
 }
 
 QString ElideTextLayout::text() const
 {
-    return document->toPlainText();
+    return document ? document->toPlainText() : plainText;
+}
+
+QTextDocument *ElideTextLayout::documentHandle()
+{
+    if (!document) {
+        document = new QTextDocument;
+        document->setPlainText(plainText);
+    }
+    return document;
+}
+
+QString ElideTextLayout::layoutCacheKey(const QSizeF &size, Qt::TextElideMode elideMode) const
+{
+    const QString &options = QString("%1x%2|%3|%4|%5|%6|%7")
+                                     .arg(size.width())
+                                     .arg(size.height())
+                                     .arg(static_cast<int>(elideMode))
+                                     .arg(attribute<uint>(kWrapMode))
+                                     .arg(attribute<uint>(kAlignment))
+                                     .arg(attribute<int>(kTextDirection))
+                                     .arg(attribute<int>(kLineHeight));
+    return text() + QChar(0x1f) + attribute<QFont>(kFont).toString() + QChar(0x1f) + options;
 }
 
 QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elideMode, QPainter *painter, const QBrush &background, QStringList *textLines)
 {
     QList<QRectF> ret;
-    QTextLayout *lay = document->firstBlock().layout();
+    // 同样的文本、字体与区域大小排版结果相同，直接复用行区域与字形，不再重新塑形
+    const bool cacheable = !document;
+    QString cacheKey;
+    if (cacheable) {
+        cacheKey = layoutCacheKey(rect.size(), elideMode);
+        CachedTextLayout cached;
+        if (layoutCache->find(cacheKey, &cached)) {
+            const QPointF delta = rect.topLeft() - cached.origin;
+            QRectF lastLineRect;
+            for (const CachedTextLine &line : cached.lines) {
+                const QRectF &lRect = line.rect.translated(delta);
+                ret.append(lRect);
+                if (textLines)
+                    textLines->append(line.text);
+
+                if (painter) {
+                    if (background.style() != Qt::NoBrush)
+                        lastLineRect = drawLineBackground(painter, lRect, lastLineRect, background);
+                    for (const QGlyphRun &run : line.glyphRuns)
+                        painter->drawGlyphRun(delta, run);
+                }
+            }
+            return ret;
+        }
+    }
+
+    CachedTextLayout recorded;
+    recorded.origin = rect.topLeft();
+    QTextLayout *lay = documentHandle()->firstBlock().layout();
     if (!lay) {
         qCWarning(logDFMBase) << "invaild block" << document->firstBlock().text();
         return ret;
@@ -64,7 +164,8 @@ QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elid
     QRectF lastLineRect;
     QString elideText;
     QString curText = text();
-    auto processLine = [this, &ret, painter, &lastLineRect, background, textLineHeight, &curText, textLines](QTextLine &line) {
+    auto processLine = [this, &ret, painter, &lastLineRect, background, textLineHeight, &curText, textLines,
+                        cacheable, &recorded](QTextLine &line) {
         QRectF lRect = line.naturalTextRect();
         lRect.setHeight(textLineHeight);
 
@@ -73,6 +174,8 @@ QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elid
             const auto &t = curText.mid(line.textStart(), line.textLength());
             textLines->append(t);
         }
+        if (cacheable)
+            recorded.lines.append({ lRect, curText.mid(line.textStart(), line.textLength()), line.glyphRuns() });
 
         // draw
         if (painter) {
@@ -140,6 +243,13 @@ QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elid
         newlay.endLayout();
     }
 
+    if (cacheable) {
+        // 排版过程中未创建过文档时才缓存，缓存命中的调用无需再构造文档
+        delete document;
+        document = nullptr;
+        layoutCache->insert(cacheKey, recorded);
+    }
+
     return ret;
 }
 
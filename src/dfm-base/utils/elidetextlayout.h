@@ -33,9 +33,8 @@ public:
     QString text() const;
     QList<QRectF> layout(const QRectF &rect, Qt::TextElideMode elideMode, QPainter *painter = nullptr, const QBrush &background = Qt::NoBrush, QStringList *textLines = nullptr);
 public:
-    inline QTextDocument *documentHandle() {
-        return document;
-    }
+    // 取得文档句柄后可能修改文档内容（如插入标记对象），之后的排版不再使用缓存
+    QTextDocument *documentHandle();
 
     inline void setAttribute(Attribute attr, const QVariant &value) {
         attributes.insert(attr, value);
@@ -49,8 +48,10 @@ public:
 protected:
     QRectF drawLineBackground(QPainter *painter, const QRectF &curLineRect, QRectF lastLineRect, const QBrush &brush) const;
     virtual void initLayoutOption(QTextLayout *lay);
+    QString layoutCacheKey(const QSizeF &size, Qt::TextElideMode elideMode) const;
 protected:
-    QTextDocument *document = nullptr;
+    QString plainText;
+    QTextDocument *document = nullptr;   // 按需创建，缓存命中时不需要文档
     QMap<Attribute, QVariant> attributes;
 };
 }
@@ -14,7 +14,38 @@
 
 Q_DECLARE_METATYPE(QSharedPointer<dfmio::DFileInfo>);
 
+// 同时向 dfm-io 发起的异步查询上限
+static constexpr int kMaxRunningQueries { 16 };
+// 有视图提示时，滚出视野的文件最多同时查询的个数
+static constexpr int kMaxBackgroundQueries { 2 };
+// 其它线程正在缓存同一文件时，重新排队的间隔
+static constexpr int kCacheRetryInterval { 50 };
+// 查询迟迟不返回（如远程挂载无响应）时释放并发名额，避免阻塞其它文件
+static constexpr int kQueryReleaseTimeout { 5000 };
+
 DFMBASE_USE_NAMESPACE
+
+/*!
+ * \brief compactQueue 残留项过多时清理队列，均摊后每次调整仍是常数开销
+ */
+template<class Pending>
+static void compactQueue(QList<QUrl> *queue, const QHash<QUrl, Pending> &pending, int priority)
+{
+    if (queue->size() <= pending.size() * 2 + 64)
+        return;
+
+    QList<QUrl> compacted;
+    QSet<QUrl> seen;
+    for (const QUrl &url : std::as_const(*queue)) {
+        auto it = pending.constFind(url);
+        if (it == pending.cend() || it->priority != priority || seen.contains(url))
+            continue;
+        seen.insert(url);
+        compacted.append(url);
+    }
+    *queue = compacted;
+}
+
 FileInfoHelper::FileInfoHelper(QObject *parent)
     : QObject(parent), thread(new QThread), worker(new FileInfoAsycWorker)
 {
@@ -34,6 +65,8 @@ void FileInfoHelper::init()
     connect(this, &FileInfoHelper::fileMimeType, worker.data(), &FileInfoAsycWorker::fileMimeType, Qt::QueuedConnection);
     connect(this, &FileInfoHelper::fileInfoRefresh, worker.data(), &FileInfoAsycWorker::fileRefresh, Qt::QueuedConnection);
     connect(worker.data(), &FileInfoAsycWorker::fileMimeTypeFinished, this, &FileInfoHelper::fileMimeTypeFinished, Qt::QueuedConnection);
+    connect(worker.data(), &FileInfoAsycWorker::fileConutAsyncFinish, this, &FileInfoHelper::jobFinished, Qt::QueuedConnection);
+    connect(worker.data(), &FileInfoAsycWorker::fileMimeTypeFinished, this, &FileInfoHelper::jobFinished, Qt::QueuedConnection);
     connect(this, &FileInfoHelper::fileRefreshRequest, this, &FileInfoHelper::handleFileRefresh, Qt::QueuedConnection);
 
     worker->moveToThread(thread.data());
@@ -51,10 +84,14 @@ void FileInfoHelper::threadHandleDfmFileInfo(const QSharedPointer<FileInfo> dfil
         return;
 
     auto resluts = asyncInfo->cacheAsyncAttributes();
-
-    while (resluts == 0) {
-        QThread::msleep(50);
-        resluts = asyncInfo->cacheAsyncAttributes();
+    if (resluts == 0) {
+        // 其它线程正在缓存该文件，稍后重新排队，不在线程池中空等
+        QMetaObject::invokeMethod(this, [this, dfileInfo]() {
+            QTimer::singleShot(kCacheRetryInterval, this, [this, dfileInfo]() {
+                cacheFileInfoByThread(dfileInfo);
+            });
+        }, Qt::QueuedConnection);
+        return;
     }
 
     if (resluts <= 1) {
@@ -78,7 +115,12 @@ QSharedPointer<FileInfoHelperUeserData> FileInfoHelper::fileCountAsync(QUrl &url
     if (stoped)
         return nullptr;
     QSharedPointer<FileInfoHelperUeserData> data(new FileInfoHelperUeserData);
-    emit fileCount(url, data);
+    PendingJob job;
+    job.type = PendingJob::kFileCount;
+    job.url = url;
+    job.data = data;
+    // 可能在排序等其它线程中调用，排队统一在主线程进行
+    QMetaObject::invokeMethod(this, [this, job]() { enqueueJob(job); }, Qt::AutoConnection);
     return data;
 }
 
@@ -87,7 +129,14 @@ QSharedPointer<FileInfoHelperUeserData> FileInfoHelper::fileMimeTypeAsync(const
     if (stoped)
         return nullptr;
     QSharedPointer<FileInfoHelperUeserData> data(new FileInfoHelperUeserData);
-    emit fileMimeType(url, mode, inod, isGvfs, data);
+    PendingJob job;
+    job.type = PendingJob::kMimeType;
+    job.url = url;
+    job.data = data;
+    job.mode = mode;
+    job.inod = inod;
+    job.isGvfs = isGvfs;
+    QMetaObject::invokeMethod(this, [this, job]() { enqueueJob(job); }, Qt::AutoConnection);
     return data;
 }
 
@@ -141,20 +190,6 @@ void FileInfoHelper::handleFileRefresh(QSharedPointer<FileInfo> dfileInfo)
     if (!asyncInfo)
         return;
 
-    auto callback = [asyncInfo, this](bool success, void *data) {
-        Q_UNUSED(data);
-        if (!success) {
-            FileInfoHelper::instance().checkInfoRefresh(asyncInfo);
-            if (ProtocolUtils::isSMBFile(asyncInfo->fileUrl())
-                && asyncInfo->errorCodeFromDfmio() == DFMIOErrorCode::DFM_IO_ERROR_HOST_IS_DOWN
-                && !NetworkUtils::instance()->checkFtpOrSmbBusy(asyncInfo->fileUrl())) {
-                emit this->smbSeverMayModifyPassword(asyncInfo->fileUrl());
-            }
-            return;
-        }
-        FileInfoHelper::instance().cacheFileInfoByThread(asyncInfo);
-    };
-
     if (qureingInfo.containsByLock(asyncInfo) && needQureingInfo.containsByLock(asyncInfo))
         return;
 
@@ -162,8 +197,7 @@ void FileInfoHelper::handleFileRefresh(QSharedPointer<FileInfo> dfileInfo)
         needQureingInfo.appendByLock(asyncInfo);
         return;
     }
-    qureingInfo.appendByLock(asyncInfo);
-    asyncInfo->asyncQueryDfmFileInfo(0, callback);
+    enqueueRefresh(asyncInfo);
 }
 
 void FileInfoHelper::checkInfoRefresh(QSharedPointer<FileInfo> dfileInfo)
@@ -174,3 +208,219 @@ void FileInfoHelper::checkInfoRefresh(QSharedPointer<FileInfo> dfileInfo)
         fileRefreshAsync(dfileInfo);
     }
 }
+
+void FileInfoHelper::updateViewport(quintptr viewId, const QList<QUrl> &visible, const QList<QUrl> &nearby)
+{
+    assert(qApp->thread() == QThread::currentThread());
+    if (stoped)
+        return;
+
+    // 只重新排定进出视野的文件，与排队总数无关
+    QSet<QUrl> changed = visibleUrls.value(viewId) + nearbyUrls.value(viewId);
+    visibleUrls.insert(viewId, QSet<QUrl>(visible.begin(), visible.end()));
+    nearbyUrls.insert(viewId, QSet<QUrl>(nearby.begin(), nearby.end()));
+    changed += visibleUrls.value(viewId);
+    changed += nearbyUrls.value(viewId);
+    reprioritize(changed);
+    dispatchRefresh();
+    dispatchJobs();
+}
+
+void FileInfoHelper::removeViewport(quintptr viewId)
+{
+    assert(qApp->thread() == QThread::currentThread());
+    const QSet<QUrl> changed = visibleUrls.take(viewId) + nearbyUrls.take(viewId);
+    reprioritize(changed);
+    dispatchRefresh();
+    dispatchJobs();
+}
+
+void FileInfoHelper::enqueueRefresh(const QSharedPointer<FileInfo> &dfileInfo)
+{
+    const QUrl &url = dfileInfo->fileUrl();
+    auto it = pendingRefresh.find(url);
+    if (it != pendingRefresh.end()) {
+        it->info = dfileInfo.toWeakRef();
+    } else {
+        const int priority = refreshPriority(url);
+        pendingRefresh.insert(url, { dfileInfo.toWeakRef(), priority });
+        refreshQueues[priority].append(url);
+    }
+    dispatchRefresh();
+}
+
+/*!
+ * \brief FileInfoHelper::dispatchRefresh 按优先级发起排队中的刷新请求
+ * 可见的文件优先，其次是即将可见的文件；滚出视野的请求不会被丢弃，
+ * 只在前两者处理完后以较低的并发补齐，避免快速滚动时堆积大量过期任务。
+ */
+void FileInfoHelper::dispatchRefresh()
+{
+    while (!stoped && runningQueries.size() < kMaxRunningQueries) {
+        QUrl url;
+        bool background = false;
+        for (int priority = kVisible; priority < kPriorityCount && url.isEmpty(); ++priority) {
+            if (priority == kBackground && !visibleUrls.isEmpty() && runningBackground >= kMaxBackgroundQueries)
+                break;
+            auto &queue = refreshQueues[priority];
+            while (!queue.isEmpty() && url.isEmpty()) {
+                const QUrl candidate = queue.takeFirst();
+                auto it = pendingRefresh.constFind(candidate);
+                if (it != pendingRefresh.cend() && it->priority == priority) {
+                    url = candidate;
+                    background = priority == kBackground;
+                }
+            }
+        }
+
+        if (url.isEmpty())
+            return;
+
+        auto asyncInfo = pendingRefresh.take(url).info.toStrongRef().dynamicCast<AsyncFileInfo>();
+        if (!asyncInfo)
+            continue;
+
+        const quint64 serial = ++querySerial;
+        runningQueries.insert(url, serial);
+        QTimer::singleShot(kQueryReleaseTimeout, this, [this, url, serial]() { queryFinished(url, serial); });
+        if (background) {
+            ++runningBackground;
+            backgroundQueries.insert(url);
+        }
+
+        auto callback = [asyncInfo, url, serial, this](bool success, void *data) {
+            Q_UNUSED(data);
+            QMetaObject::invokeMethod(this, [this, url, serial]() { queryFinished(url, serial); }, Qt::QueuedConnection);
+            if (!success) {
+                FileInfoHelper::instance().checkInfoRefresh(asyncInfo);
+                if (ProtocolUtils::isSMBFile(asyncInfo->fileUrl())
+                    && asyncInfo->errorCodeFromDfmio() == DFMIOErrorCode::DFM_IO_ERROR_HOST_IS_DOWN
+                    && !NetworkUtils::instance()->checkFtpOrSmbBusy(asyncInfo->fileUrl())) {
+                    emit this->smbSeverMayModifyPassword(asyncInfo->fileUrl());
+                }
+                return;
+            }
+            FileInfoHelper::instance().cacheFileInfoByThread(asyncInfo);
+        };
+
+        qureingInfo.appendByLock(asyncInfo);
+        if (!asyncInfo->asyncQueryDfmFileInfo(0, callback)) {
+            checkInfoRefresh(asyncInfo);
+            queryFinished(url, serial);
+        }
+    }
+}
+
+void FileInfoHelper::reprioritize(const QSet<QUrl> &urls)
+{
+    for (const QUrl &url : urls) {
+        const int priority = refreshPriority(url);
+        auto it = pendingRefresh.find(url);
+        if (it != pendingRefresh.end() && it->priority != priority) {
+            it->priority = priority;
+            refreshQueues[priority].append(url);
+        }
+        auto jobIt = pendingJobs.find(url);
+        if (jobIt != pendingJobs.end() && jobIt->priority != priority) {
+            jobIt->priority = priority;
+            jobQueues[priority].append(url);
+        }
+    }
+
+    for (int priority = kVisible; priority < kPriorityCount; ++priority) {
+        compactRefreshQueue(priority);
+        compactQueue(&jobQueues[priority], pendingJobs, priority);
+    }
+}
+
+void FileInfoHelper::compactRefreshQueue(int priority)
+{
+    compactQueue(&refreshQueues[priority], pendingRefresh, priority);
+}
+
+int FileInfoHelper::refreshPriority(const QUrl &url) const
+{
+    for (const auto &urls : visibleUrls) {
+        if (urls.contains(url))
+            return kVisible;
+    }
+    for (const auto &urls : nearbyUrls) {
+        if (urls.contains(url))
+            return kNearby;
+    }
+    return kBackground;
+}
+
+void FileInfoHelper::queryFinished(const QUrl &url, quint64 serial)
+{
+    auto it = runningQueries.find(url);
+    if (it == runningQueries.end() || it.value() != serial)
+        return;
+    runningQueries.erase(it);
+    if (backgroundQueries.remove(url))
+        --runningBackground;
+    dispatchRefresh();
+}
+
+void FileInfoHelper::enqueueJob(const PendingJob &job)
+{
+    if (stoped)
+        return;
+
+    auto it = pendingJobs.find(job.url);
+    if (it == pendingJobs.end()) {
+        const int priority = refreshPriority(job.url);
+        it = pendingJobs.insert(job.url, { {}, priority });
+        jobQueues[priority].append(job.url);
+    }
+    it->jobs.append(job);
+    dispatchJobs();
+}
+
+/*!
+ * \brief FileInfoHelper::dispatchJobs 按优先级把子文件计数和 mime 探测交给工作线程
+ * 工作线程中只保留少量任务，其余在此排队，视野变化后可见文件的任务先执行
+ */
+void FileInfoHelper::dispatchJobs()
+{
+    while (!stoped && runningJobs < kMaxRunningJobs) {
+        QUrl url;
+        for (int priority = kVisible; priority < kPriorityCount && url.isEmpty(); ++priority) {
+            auto &queue = jobQueues[priority];
+            while (!queue.isEmpty() && url.isEmpty()) {
+                const QUrl candidate = queue.takeFirst();
+                auto it = pendingJobs.constFind(candidate);
+                if (it != pendingJobs.cend() && it->priority == priority)
+                    url = candidate;
+            }
+        }
+
+        if (url.isEmpty())
+            return;
+
+        const QList<PendingJob> jobs = pendingJobs.take(url).jobs;
+        for (const auto &job : jobs) {
+            // 请求方已释放，结果无人读取，不再执行
+            auto data = job.data.toStrongRef();
+            if (!data)
+                continue;
+            ++runningJobs;
+            startJob(job, data);
+        }
+    }
+}
+
+void FileInfoHelper::startJob(const PendingJob &job, const QSharedPointer<FileInfoHelperUeserData> &data)
+{
+    if (job.type == PendingJob::kFileCount)
+        emit fileCount(job.url, data);
+    else
+        emit fileMimeType(job.url, job.mode, job.inod, job.isGvfs, data);
+}
+
+void FileInfoHelper::jobFinished()
+{
+    if (runningJobs > 0)
+        --runningJobs;
+    dispatchJobs();
+}
@@ -18,6 +18,7 @@
 #include <QMimeDatabase>
 #include <QThreadPool>
 #include <QReadWriteLock>
+#include <QSet>
 
 namespace dfmbase {
 class FileInfoHelper : public QObject
@@ -31,6 +32,9 @@ public:
                                                               const QString &inod, const bool isGvfs);
     void fileRefreshAsync(const QSharedPointer<dfmbase::FileInfo> dfileInfo);
     void cacheFileInfoByThread(const QSharedPointer<FileInfo> dfileInfo);
+    // 视图告知当前可见与即将可见的文件，属性刷新、子文件计数和 mime 探测按此排定优先级
+    void updateViewport(quintptr viewId, const QList<QUrl> &visible, const QList<QUrl> &nearby);
+    void removeViewport(quintptr viewId);
 
 private:
     explicit FileInfoHelper(QObject *parent = nullptr);
@@ -58,6 +62,18 @@ private Q_SLOTS:
 
 private:
     void checkInfoRefresh(QSharedPointer<FileInfo> dfileInfo);
+    void enqueueRefresh(const QSharedPointer<FileInfo> &dfileInfo);
+    void dispatchRefresh();
+    void reprioritize(const QSet<QUrl> &urls);
+    void compactRefreshQueue(int priority);
+    int refreshPriority(const QUrl &url) const;
+    void queryFinished(const QUrl &url, quint64 serial);
+
+    struct PendingJob;
+    void enqueueJob(const PendingJob &job);
+    void dispatchJobs();
+    void startJob(const PendingJob &job, const QSharedPointer<FileInfoHelperUeserData> &data);
+    void jobFinished();
 
 private:
     QSharedPointer<QThread> thread { nullptr };
@@ -66,6 +82,53 @@ private:
     DThreadList<FileInfoPointer> qureingInfo;
     DThreadList<FileInfoPointer> needQureingInfo;
     QThreadPool pool;
+
+    // 以下仅在主线程访问
+    enum RefreshPriority : uint8_t {
+        kVisible = 0,
+        kNearby,
+        kBackground,   // 已滚出视野或没有视图提示，空闲时才处理
+        kPriorityCount
+    };
+    struct PendingRefresh
+    {
+        QWeakPointer<FileInfo> info;
+        int priority { kBackground };
+    };
+    // 优先级变化时只把 url 追加到新队列，旧队列中的残留项在出队时跳过
+    QHash<QUrl, PendingRefresh> pendingRefresh;
+    QList<QUrl> refreshQueues[kPriorityCount];
+    QHash<quintptr, QSet<QUrl>> visibleUrls;
+    QHash<quintptr, QSet<QUrl>> nearbyUrls;
+    QHash<QUrl, quint64> runningQueries;   // url -> 查询序号，防止过期的超时释放误伤新查询
+    quint64 querySerial { 0 };
+    int runningBackground { 0 };
+    QSet<QUrl> backgroundQueries;
+
+    // 子文件计数和 mime 探测在单个工作线程中执行，同样按视野优先级出队。
+    // 只持有请求方结果的弱引用，请求方（通常是 info）已释放时任务直接取消
+    struct PendingJob
+    {
+        enum Type : uint8_t {
+            kFileCount,
+            kMimeType
+        };
+        Type type { kFileCount };
+        QUrl url;
+        QWeakPointer<FileInfoHelperUeserData> data;
+        QMimeDatabase::MatchMode mode { QMimeDatabase::MatchDefault };
+        QString inod;
+        bool isGvfs { false };
+    };
+    struct PendingJobs
+    {
+        QList<PendingJob> jobs;
+        int priority { kBackground };
+    };
+    static constexpr int kMaxRunningJobs { 2 };   // 同时交给工作线程的任务数，保证工作线程不空等
+    QHash<QUrl, PendingJobs> pendingJobs;
+    QList<QUrl> jobQueues[kPriorityCount];
+    int runningJobs { 0 };
 };
 }
 
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "iconpixmapcache.h"
+
+#include <DGuiApplicationHelper>
+#include <DPlatformTheme>
+
+#include <QApplication>
+#include <QPainter>
+#include <QThread>
+
+DGUI_USE_NAMESPACE
+using namespace dfmbase;
+
+// 缓存上限，单位 KiB
+static constexpr int kPixmapCacheCost { 64 * 1024 };
+static constexpr int kEmblemCacheCost { 16 * 1024 };
+
+IconPixmapCache *IconPixmapCache::instance()
+{
+    static IconPixmapCache ins;
+    return &ins;
+}
+
+IconPixmapCache::IconPixmapCache(QObject *parent)
+    : QObject(parent)
+{
+    pixmaps.setMaxCost(kPixmapCacheCost);
+    emblemPixmaps.setMaxCost(kEmblemCacheCost);
+
+    connect(DGuiApplicationHelper::instance()->systemTheme(), &DPlatformTheme::iconThemeNameChanged,
+            this, &IconPixmapCache::clear);
+    connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged,
+            this, &IconPixmapCache::clear);
+}
+
+QIcon IconPixmapCache::themeIcon(const QString &iconName)
+{
+    Q_ASSERT(QThread::currentThread() == qApp->thread());
+
+    auto it = themeIcons.constFind(iconName);
+    if (it != themeIcons.constEnd())
+        return it.value();
+
+    const QIcon &icon = QIcon::fromTheme(iconName);
+    themeIcons.insert(iconName, icon);
+    return icon;
+}
+
+QPixmap IconPixmapCache::pixmap(const QIcon &icon, const QSize &size, qreal pixelRatio, QIcon::Mode mode, QIcon::State state)
+{
+    Q_ASSERT(QThread::currentThread() == qApp->thread());
+
+    if (icon.isNull() || size.width() <= 0 || size.height() <= 0)
+        return QPixmap();
+
+    const QString &key = QString("%1_%2x%3@%4_%5_%6")
+                                 .arg(iconKey(icon))
+                                 .arg(size.width())
+                                 .arg(size.height())
+                                 .arg(pixelRatio)
+                                 .arg(mode)
+                                 .arg(state);
+    if (QPixmap *cached = pixmaps.object(key))
+        return *cached;
+
+    // 根据设备像素比获取合适大小的pixmap
+    QPixmap px = icon.pixmap(size * pixelRatio, mode, state);
+    px.setDevicePixelRatio(pixelRatio);
+    if (!px.isNull())
+        pixmaps.insert(key, new QPixmap(px), pixmapCost(px));
+    return px;
+}
+
+QPixmap IconPixmapCache::emblemComposite(const QList<QIcon> &emblems, const QList<QRectF> &rects,
+                                         qreal pixelRatio, QPoint *topLeft)
+{
+    Q_ASSERT(QThread::currentThread() == qApp->thread());
+    Q_ASSERT(topLeft);
+
+    const int count = qMin(emblems.count(), rects.count());
+    QList<QRect> emblemRects;
+    QRect bounding;
+    for (int i = 0; i < count; ++i) {
+        emblemRects.append(rects.at(i).toRect());
+        if (!emblems.at(i).isNull())
+            bounding |= emblemRects.last();
+    }
+    if (bounding.isEmpty())
+        return QPixmap();
+
+    // 以合成图左上角为原点描述布局，同样大小的图标区域在任何位置都命中同一缓存
+    *topLeft = bounding.topLeft();
+    QString key = QString("%1x%2@%3").arg(bounding.width()).arg(bounding.height()).arg(pixelRatio);
+    for (int i = 0; i < count; ++i) {
+        if (emblems.at(i).isNull())
+            continue;
+        emblemRects[i].translate(-bounding.topLeft());
+        const QRect &rect = emblemRects.at(i);
+        key += QString("|%1_%2,%3,%4,%5").arg(iconKey(emblems.at(i))).arg(rect.x()).arg(rect.y()).arg(rect.width()).arg(rect.height());
+    }
+    if (QPixmap *cached = emblemPixmaps.object(key))
+        return *cached;
+
+    QPixmap composite(bounding.size() * pixelRatio);
+    composite.setDevicePixelRatio(pixelRatio);
+    composite.fill(Qt::transparent);
+
+    QPainter painter(&composite);
+    painter.setRenderHints(QPainter::SmoothPixmapTransform);
+    for (int i = 0; i < count; ++i) {
+        if (emblems.at(i).isNull())
+            continue;
+        const QRect &rect = emblemRects.at(i);
+        painter.drawPixmap(rect, pixmap(emblems.at(i), rect.size(), pixelRatio));
+    }
+    painter.end();
+
+    emblemPixmaps.insert(key, new QPixmap(composite), pixmapCost(composite));
+    return composite;
+}
+
+void IconPixmapCache::clear()
+{
+    themeIcons.clear();
+    pixmaps.clear();
+    emblemPixmaps.clear();
+    emit cleared();
+}
+
+QString IconPixmapCache::iconKey(const QIcon &icon)
+{
+    // 主题图标每次 fromTheme 都是新实例，按名称区分；缩略图等无名图标按实例区分
+    const QString &name = icon.name();
+    if (!name.isEmpty())
+        return name;
+    return QString("#%1").arg(icon.cacheKey());
+}
+
+int IconPixmapCache::pixmapCost(const QPixmap &pixmap)
+{
+    return qMax(1, pixmap.width() * pixmap.height() * pixmap.depth() / 8 / 1024);
+}
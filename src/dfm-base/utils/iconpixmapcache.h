@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ICONPIXMAPCACHE_H
+#define ICONPIXMAPCACHE_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QIcon>
+#include <QPixmap>
+
+namespace dfmbase {
+
+/*!
+ * \brief The IconPixmapCache class keeps rasterized icons for item delegates.
+ *
+ * Pixmaps are keyed by (icon, size, device pixel ratio, mode, state), emblem
+ * composites by the emblem icons and their layout, so repeated paints of the
+ * same icon become plain blits instead of going through the icon engine.
+ * Theme icons are resolved once per name. Everything is dropped when the icon
+ * theme or the theme type changes. Must be used from the main thread.
+ */
+class IconPixmapCache : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(IconPixmapCache)
+
+public:
+    static IconPixmapCache *instance();
+
+    QIcon themeIcon(const QString &iconName);
+    // 按图标、尺寸、设备像素比缓存栅格化结果，重复绘制时直接取用
+    QPixmap pixmap(const QIcon &icon, const QSize &size, qreal pixelRatio,
+                   QIcon::Mode mode = QIcon::Normal, QIcon::State state = QIcon::Off);
+    // 将多个角标按各自的绘制区域合成为一张图，topLeft 返回合成图应绘制的位置
+    QPixmap emblemComposite(const QList<QIcon> &emblems, const QList<QRectF> &rects,
+                            qreal pixelRatio, QPoint *topLeft);
+
+    void clear();
+
+Q_SIGNALS:
+    void cleared();
+
+private:
+    explicit IconPixmapCache(QObject *parent = nullptr);
+
+    static QString iconKey(const QIcon &icon);
+    static int pixmapCost(const QPixmap &pixmap);
+
+    QHash<QString, QIcon> themeIcons;   // 包括主题中不存在的图标，避免重复查找
+    QCache<QString, QPixmap> pixmaps;
+    QCache<QString, QPixmap> emblemPixmaps;
+};
+
+}
+
+#endif   // ICONPIXMAPCACHE_H
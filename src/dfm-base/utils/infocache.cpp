@@ -8,15 +8,29 @@
 #include <dfm-io/dfileinfo.h>
 
 #include <QtConcurrent>
+#include <QDBusConnection>
+#include <QDBusError>
 
-// cache file total count
-static constexpr int kCacheFileinfoCount = 20000;
+#include <chrono>
+
+// cache file info memory budget, about 20000 infos
+static constexpr qint64 kCacheMemoryBudget = 40 * 1024 * 1024;
+// estimated memory of one file info besides its url
+static constexpr qint64 kCacheInfoBaseCost = 1800;
 // cache file watcher total count
 static constexpr int kCacheFileWatcherCount = 5000;
 // rotation training time
 static constexpr int kRotationTrainingTime = (60 * 1000);
-// remove cache time limit
-static constexpr int kCacheRemoveTime = (60 * (60 * 1000));
+// remove cache time limit (secs)
+static constexpr qint64 kCacheRemoveTime = 60 * 60;
+static constexpr char kInfoCacheObjPath[] { "/org/deepin/Filemanager/InfoCache" };
+
+static qint64 currentSecs()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+}
 
 namespace dfmbase {
 InfoCachePrivate::InfoCachePrivate(InfoCache *qq)
@@ -29,6 +43,64 @@ InfoCachePrivate::~InfoCachePrivate()
     cacheWorkerStoped = true;
 }
 
+InfoCacheShard &InfoCachePrivate::shardOf(const QUrl &url)
+{
+    return shards[qHash(url) % kShardCount];
+}
+
+/*!
+ * \brief InfoCachePrivate::markRemovedLocked 记录 url 被移除时的代数，只影响该 url 的插入
+ *
+ * 记录过多时整体清空并抬高下限，此时仍在创建中的 info 保守地放弃插入
+ *
+ * 调用方需持有分片写锁
+ */
+void InfoCachePrivate::markRemovedLocked(InfoCacheShard &shard, const QUrl &url)
+{
+    const quint64 current = ++shard.generation;
+    if (shard.removedAt.size() >= kMaxRemovedRecords) {
+        shard.removedAt.clear();
+        shard.removedFloor = current;
+    }
+    shard.removedAt.insert(url, current);
+}
+
+/*!
+ * \brief InfoCachePrivate::evictLocked CLOCK 淘汰，直到分片回到内存预算以内
+ *
+ * 调用方需持有分片写锁
+ */
+void InfoCachePrivate::evictLocked(InfoCacheShard &shard, QMap<QUrl, FileInfoPointer> *evicted)
+{
+    static constexpr qint64 kShardBudget = kCacheMemoryBudget / kShardCount;
+
+    // 环中残留过多已删除的 url 时重建
+    if (shard.clock.size() > shard.entries.size() * 2 + 64) {
+        shard.clock = shard.entries.keys();
+        shard.hand = 0;
+    }
+
+    while (shard.cost > kShardBudget && !shard.clock.isEmpty()) {
+        if (shard.hand >= shard.clock.size())
+            shard.hand = 0;
+
+        auto it = shard.entries.find(shard.clock.at(shard.hand));
+        if (it != shard.entries.end() && it->referenced.fetchAndStoreRelaxed(0)) {
+            ++shard.hand;
+            continue;
+        }
+
+        if (it != shard.entries.end()) {
+            evicted->insert(it.key(), it->info);
+            shard.cost -= it->cost;
+            shard.entries.erase(it);
+            ++shard.evictions;
+        }
+        shard.clock.swapItemsAt(shard.hand, shard.clock.size() - 1);
+        shard.clock.removeLast();
+    }
+}
+
 InfoCache::InfoCache(QObject *parent)
     : QObject(parent), d(new InfoCachePrivate(this))
 {
@@ -126,85 +198,66 @@ void InfoCache::setCacheDisbale(const QString &scheme, bool disable)
  *
  * \param DAbstractFileInfoPointer fileinfo的智能指针
  *
+ * \param generation 创建 info 前通过 generation() 取得的代数，期间该 url 被移除时放弃插入
+ *
  * \return
  */
-void InfoCache::cacheInfo(const QUrl url, const FileInfoPointer info)
+void InfoCache::cacheInfo(const QUrl url, const FileInfoPointer info, quint64 generation)
 {
     Q_D(InfoCache);
     if (!info || d->cacheWorkerStoped)
         return;
 
+    auto &shard = d->shardOf(url);
+    QMap<QUrl, FileInfoPointer> evicted;
     {
-        QReadLocker rlk(&d->mianLock);
-        if (d->mainCache.contains(url))
+        QWriteLocker wlk(&shard.lock);
+        if (generation != kAnyGeneration
+            && (generation < shard.removedFloor || shard.removedAt.value(url, 0) > generation)) {
+            ++shard.rejects;
             return;
-    }
-
-    {
-        QReadLocker rlk(&d->copyLock);
-        if (d->copyCache.contains(url))
+        }
+        if (shard.entries.contains(url))
             return;
-    }
 
-    //获取监视器，监听当前的file的改变 当没有缓存加入监视器后，这里的watcher就会析构，如果启动了就要停止监控，这个是代理
-    // 代理就将启动的缓存了监视关闭了。本来没有缓存的监视器监视就没有意义
-    // if (!WatcherCache::instance().cacheDisable(url.scheme())) {
-    //     auto parentUrl = UrlRoute::urlParent(url);
-    //     auto parentPath = parentUrl.path();
-    //     if (parentPath != QDir::separator() && !parentPath.endsWith(QDir::separator()))
-    //         parentUrl.setPath(parentPath + QDir::separator());
-
-    //     auto watcher = WatcherFactory::create<AbstractFileWatcher>(parentUrl);
-    //     if (watcher) {
-    //         if (watcher->getCacheInfoConnectSize() == 0) {
-    //             connect(watcher.data(), &AbstractFileWatcher::fileDeleted, this, &InfoCache::removeCache);
-    //             connect(watcher.data(), &AbstractFileWatcher::fileAttributeChanged, this,
-    //                     &InfoCache::refreshFileInfo);
-    //             connect(watcher.data(), &AbstractFileWatcher::fileRename, this,
-    //                     &InfoCache::removeCache);
-    //             connect(watcher.data(), &AbstractFileWatcher::subfileCreated, this,
-    //                     &InfoCache::refreshFileInfo);
-    //             watcher->startWatcher();
-    //         }
-    //         watcher->addCacheInfoConnectSize();
-    //     }
-    // }
-
-    // 插入到主和副的所有缓存中
-    d->status = kCacheCopy;
-    {
-        QWriteLocker wlk(&d->mianLock);
-        d->mainCache.insert(url, info);
-    }
-    d->status = kCacheMain;
-    {
-        QWriteLocker wlk(&d->copyLock);
-        d->copyCache.insert(url, info);
+        InfoCacheEntry &entry = shard.entries[url];
+        entry.info = info;
+        entry.cost = kCacheInfoBaseCost + url.path().size() * 2;
+        entry.lastAccess.storeRelaxed(currentSecs());
+        shard.cost += entry.cost;
+        shard.clock.append(url);
+        ++shard.inserts;
+
+        d->evictLocked(shard, &evicted);
     }
-    // 使用线程处理加入时间序列问题
-    emit cacheUpdateInfoTime(url);
+
+    if (!evicted.isEmpty())
+        emit cacheDisconnectWatcher(evicted);
 }
-/*!
- * \brief insertSortTime 处理当前文件的移除时间
- *
- * \param qint64 文件info的当前时间
- *
- * \param QString 文件的url
- *
- * \return
- */
-bool InfoCache::updateSortTimeWorker(const QUrl url)
+
+quint64 InfoCache::generation(const QUrl &url)
 {
     Q_D(InfoCache);
-    if (d->cacheWorkerStoped)
-        return false;
-    auto time = QDateTime::currentMSecsSinceEpoch();
-    auto key = QString::number(time) + QString("-") + url.toString();
-    if (d->urlTimeSortHash.contains(url))
-        d->timeToUrlMap.remove(d->urlTimeSortHash.value(url));
-    d->timeToUrlMap.insert(key, url);
-    d->urlTimeSortHash.insert(url, key);
-    return d->timeToUrlMap.count() > kCacheFileinfoCount;
+    return d->shardOf(url).generation.load();
+}
+
+InfoCacheStatistics InfoCache::statistics()
+{
+    Q_D(InfoCache);
+    InfoCacheStatistics stat;
+    for (auto &shard : d->shards) {
+        stat.hits += shard.hits.load(std::memory_order_relaxed);
+        stat.misses += shard.misses.load(std::memory_order_relaxed);
+        stat.inserts += shard.inserts.load(std::memory_order_relaxed);
+        stat.rejects += shard.rejects.load(std::memory_order_relaxed);
+        stat.evictions += shard.evictions.load(std::memory_order_relaxed);
+        stat.expirations += shard.expirations.load(std::memory_order_relaxed);
+        stat.invalidations += shard.invalidations.load(std::memory_order_relaxed);
+        QReadLocker rlk(&shard.lock);
+        stat.entries += shard.entries.size();
+        stat.memoryCost += shard.cost;
+    }
+    return stat;
 }
 
 void InfoCache::stop()
@@ -213,12 +266,10 @@ void InfoCache::stop()
     d->cacheWorkerStoped = true;
 }
 /*!
- * \brief removeCaches 移除缓存的线程执行函数
+ * \brief removeCaches 移除缓存
  *
  * \param QStringList key需要移除的缓存的key
  *
- * \param std::atomic_bool isStop判断当前是否是退出当前处理
- *
  * \return
  */
 void InfoCache::removeCaches(const QList<QUrl> urls)
@@ -227,31 +278,26 @@ void InfoCache::removeCaches(const QList<QUrl> urls)
     if (d->cacheWorkerStoped || urls.size() <= 0)
         return;
 
-    // 读取主缓存，插入到
-    d->status = kCacheCopy;
     QMap<QUrl, FileInfoPointer> infos;
-    {
-        QWriteLocker wlk(&d->mianLock);
-        for (const auto &url : urls) {
-            auto info = d->mainCache.take(url);
-            if (info)
-                infos.insert(url, d->mainCache.take(url));
-        }
+    for (const auto &url : urls) {
+        auto &shard = d->shardOf(url);
+        QWriteLocker wlk(&shard.lock);
+        // 无论是否命中都记录移除，使正在创建中的该 url 的 info 不再写回
+        d->markRemovedLocked(shard, url);
+        auto it = shard.entries.find(url);
+        if (it == shard.entries.end())
+            continue;
+        infos.insert(url, it->info);
+        shard.cost -= it->cost;
+        shard.entries.erase(it);
+        ++shard.invalidations;
     }
+
     if (d->cacheWorkerStoped)
         return;
     // 断开监视器监视
     if (infos.size() > 0)
         emit cacheDisconnectWatcher(infos);
-
-    // 设置读取主缓存和插入到主缓存中
-    d->status = kCacheMain;
-    {
-        QWriteLocker wlk(&d->copyLock);
-        for (const auto &url : urls) {
-            d->copyCache.remove(url);
-        }
-    }
 }
 /*!
  * \brief getCacheInfo 获取文件
@@ -263,22 +309,18 @@ void InfoCache::removeCaches(const QList<QUrl> urls)
 FileInfoPointer InfoCache::getCacheInfo(const QUrl &url)
 {
     Q_D(InfoCache);
-    // 要异步线程重置计时器 todo 开辟一个可控制的线程来处理时间排序的问题
-    // 读取副缓存和临时缓存返回
-    FileInfoPointer info(nullptr);
-    if (d->status == kCacheMain) {   // 可以读取主缓存返回
-        QReadLocker wlk(&d->mianLock);
-        info = d->mainCache.value(url);
-    } else {
-        QReadLocker wlk(&d->copyLock);
-        info = d->copyCache.value(url);
+    auto &shard = d->shardOf(url);
+    QReadLocker rlk(&shard.lock);
+    auto it = shard.entries.constFind(url);
+    if (it == shard.entries.cend()) {
+        ++shard.misses;
+        return nullptr;
     }
-    // 异步线程或者信号更新时间
-    // 使用线程处理加入时间序列问题
-    if (info)
-        emit cacheUpdateInfoTime(url);
 
-    return info;
+    it->referenced.storeRelaxed(1);
+    it->lastAccess.storeRelaxed(currentSecs());
+    ++shard.hits;
+    return it->info;
 }
 /*!
  * \brief refreshFileInfo 刷新缓存fileinfo
@@ -303,26 +345,26 @@ void InfoCache::addWatcherTimeInfo(const QList<QUrl> &urls)
     for (const auto &url : urls) {
         if (d->cacheWorkerStoped)
             return;
-        auto key = QString::number(time) + QString("-") + url.toString();
-        if (d->urlTimeSortWatcherHash.contains(url))
-            d->timeToUrlWatcherMap.remove(d->urlTimeSortWatcherHash.value(url));
-        d->timeToUrlWatcherMap.insert(key, url);
-        d->urlTimeSortWatcherHash.insert(url, key);
+        auto old = d->watcherTimeHash.constFind(url);
+        if (old != d->watcherTimeHash.cend())
+            d->timeToWatcherMap.remove(old.value(), url);
+        d->timeToWatcherMap.insert(time, url);
+        d->watcherTimeHash.insert(url, time);
     }
 
-    if (d->timeToUrlWatcherMap.count() <= kCacheFileWatcherCount)
+    if (d->timeToWatcherMap.count() <= kCacheFileWatcherCount)
         return;
 
-             // 超出限制移除先进入的watcher
-    auto it = d->timeToUrlWatcherMap.begin();
-    while (d->urlTimeSortWatcherHash.size() > kCacheFileWatcherCount
-           && it != d->timeToUrlWatcherMap.end()) {
+    // 超出限制移除先进入的watcher
+    auto it = d->timeToWatcherMap.begin();
+    while (d->watcherTimeHash.size() > kCacheFileWatcherCount
+           && it != d->timeToWatcherMap.end()) {
         if (d->cacheWorkerStoped)
             return;
         auto url = it.value();
-        d->urlTimeSortWatcherHash.remove(url);
+        d->watcherTimeHash.remove(url);
         WatcherCache::instance().removeCacheWatcher(url, false);
-        it = d->timeToUrlWatcherMap.erase(it);
+        it = d->timeToWatcherMap.erase(it);
     }
 }
 
@@ -331,54 +373,47 @@ void InfoCache::removeWatcherTimeInfo(const QList<QUrl> &urls)
     for (const auto &url : urls) {
         if (d->cacheWorkerStoped)
             return;
-        if (d->urlTimeSortWatcherHash.contains(url)) {
-            d->timeToUrlWatcherMap.remove(d->urlTimeSortWatcherHash.take(url));
+        auto it = d->watcherTimeHash.find(url);
+        if (it != d->watcherTimeHash.end()) {
+            d->timeToWatcherMap.remove(it.value(), url);
+            d->watcherTimeHash.erase(it);
         }
     }
 }
 /*!
- * \brief timeRemoveCache 定时检查哪些fileinfo要移除
+ * \brief timeRemoveCache 定时移除长时间未访问的fileinfo
  *
  * \return
  */
 void InfoCache::timeRemoveCache()
 {
     Q_D(InfoCache);
-    // 取出哪些url的时间超出了u
-    qint64 delCount = d->urlTimeSortHash.size() < kCacheFileinfoCount ? 0 : d->urlTimeSortHash.size() - kCacheFileinfoCount;
-    QList<QUrl> delList;
-    foreach (const auto time, d->timeToUrlMap.keys()) {
+    const qint64 deadline = currentSecs() - kCacheRemoveTime;
+    QMap<QUrl, FileInfoPointer> expired;
+    for (auto &shard : d->shards) {
         if (d->cacheWorkerStoped)
             return;
 
-        if (time < QString::number(QDateTime::currentDateTime().toMSecsSinceEpoch() - kCacheRemoveTime)) {
-            delList.append(d->timeToUrlMap.value(time));
-            continue;
-        }
-
-        if (delList.size() >= delCount) {
-            break;
-        }
-
-        delList.append(d->timeToUrlMap.value(time));
-    }
-    for (auto url : delList) {
-        if (d->urlTimeSortHash.contains(url)) {
-            d->timeToUrlMap.remove(d->urlTimeSortHash.take(url));
+        QWriteLocker wlk(&shard.lock);
+        for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+            if (it->lastAccess.loadRelaxed() >= deadline) {
+                ++it;
+                continue;
+            }
+            expired.insert(it.key(), it->info);
+            shard.cost -= it->cost;
+            it = shard.entries.erase(it);
+            ++shard.expirations;
         }
     }
-    // 发送异步消息 告诉移除线程创建移除线程移除，考虑是否是使用线程一直还是使用临时线程（使用临时线程）
-    if (delList.size() > 0 && !d->cacheWorkerStoped)
-        emit cacheRemoveCaches(delList);
-}
 
-void InfoCache::removeInfosTimeWorker(const QList<QUrl> urls)
-{
-    for (auto url : urls) {
-        if (d->urlTimeSortHash.contains(url)) {
-            d->timeToUrlMap.remove(d->urlTimeSortHash.take(url));
-        }
-    }
+    const auto &stat = statistics();
+    qCDebug(logDFMBase) << "info cache: entries" << stat.entries << "cost" << stat.memoryCost
+                        << "hits" << stat.hits << "misses" << stat.misses << "evictions" << stat.evictions
+                        << "expirations" << stat.expirations << "rejects" << stat.rejects;
+
+    if (expired.size() > 0 && !d->cacheWorkerStoped)
+        emit cacheDisconnectWatcher(expired);
 }
 
 void InfoCache::updateSortTimeWatcherWorker(const QList<QUrl> &urls, const bool add)
@@ -389,7 +424,7 @@ void InfoCache::updateSortTimeWatcherWorker(const QList<QUrl> &urls, const bool
     if (add)
         return addWatcherTimeInfo(urls);
 
-    removeInfosTimeWorker(urls);
+    removeWatcherTimeInfo(urls);
 }
 
 void InfoCache::fileAttributeChanged(const QUrl url)
@@ -455,6 +490,43 @@ FileInfoPointer InfoCacheController::getCacheInfo(const QUrl &url)
     return InfoCache::instance().getCacheInfo(url);
 }
 
+quint64 InfoCacheController::generation(const QUrl &url)
+{
+    return InfoCache::instance().generation(url);
+}
+
+void InfoCacheController::cacheInfo(const QUrl &url, const FileInfoPointer &info, quint64 generation)
+{
+    InfoCache::instance().cacheInfo(url, info, generation);
+}
+
+InfoCacheStatistics InfoCacheController::statistics()
+{
+    return InfoCache::instance().statistics();
+}
+
+void InfoCacheController::registerDBus()
+{
+    // 只注册对象用于调试查看，通过进程自身的连接名访问
+    QDBusConnection conn = QDBusConnection::sessionBus();
+    if (!conn.registerObject(kInfoCacheObjPath, this, QDBusConnection::ExportScriptableSlots))
+        qCWarning(logDFMBase) << "cannot register the info cache to D-Bus:" << conn.lastError().message();
+}
+
+QVariantMap InfoCacheController::Statistics()
+{
+    const auto &stat = statistics();
+    return QVariantMap { { "hits", stat.hits },
+                         { "misses", stat.misses },
+                         { "inserts", stat.inserts },
+                         { "rejects", stat.rejects },
+                         { "evictions", stat.evictions },
+                         { "expirations", stat.expirations },
+                         { "invalidations", stat.invalidations },
+                         { "entries", stat.entries },
+                         { "memoryCost", stat.memoryCost } };
+}
+
 InfoCacheController::InfoCacheController(QObject *parent)
     : QObject(parent), thread(new QThread), worker(new CacheWorker), removeTimer(new QTimer)
     , threadUpdate(new QThread)
@@ -468,10 +540,13 @@ void InfoCacheController::init()
     removeTimer->moveToThread(qApp->thread());
     connect(removeTimer.data(), &QTimer::timeout, workerUpdate.data(),
             &TimeToUpdateCache::dealRemoveInfo, Qt::QueuedConnection);
-    connect(&InfoCache::instance(), &InfoCache::cacheUpdateInfoTime, workerUpdate.data(),
-            &TimeToUpdateCache::updateInfoTime, Qt::QueuedConnection);
-    connect(this, &InfoCacheController::cacheFileInfo, worker.data(), &CacheWorker::cacheInfo, Qt::QueuedConnection);
-    connect(this, &InfoCacheController::removeCacheFileInfo, worker.data(), &CacheWorker::removeCaches, Qt::QueuedConnection);
+    // 分片缓存可并发访问，插入和移除直接在调用线程完成，避免排队期间读到过期的 info
+    connect(this, &InfoCacheController::cacheFileInfo, this, [](const QUrl url, const FileInfoPointer info) {
+        InfoCache::instance().cacheInfo(url, info);
+    }, Qt::DirectConnection);
+    connect(this, &InfoCacheController::removeCacheFileInfo, this, [](const QList<QUrl> &urls) {
+        InfoCache::instance().removeCaches(urls);
+    }, Qt::DirectConnection);
     connect(&InfoCache::instance(), &InfoCache::cacheRemoveCaches, worker.data(), &CacheWorker::removeCaches, Qt::QueuedConnection);
     connect(&InfoCache::instance(), &InfoCache::cacheDisconnectWatcher, worker.data(), &CacheWorker::disconnectWatcher, Qt::QueuedConnection);
     connect(&WatcherCache::instance(), &WatcherCache::updateWatcherTime,
@@ -490,13 +565,6 @@ TimeToUpdateCache::~TimeToUpdateCache()
 
 }
 
-void TimeToUpdateCache::updateInfoTime(const QUrl url)
-{
-    Q_ASSERT(qApp->thread() != QThread::currentThread());
-    if (InfoCache::instance().updateSortTimeWorker(url))
-        InfoCache::instance().timeRemoveCache();
-}
-
 void TimeToUpdateCache::dealRemoveInfo()
 {
     Q_ASSERT(qApp->thread() != QThread::currentThread());
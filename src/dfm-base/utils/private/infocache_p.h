@@ -12,11 +12,43 @@
 #include <QTimer>
 #include <QMap>
 
+#include <array>
+#include <atomic>
+
 namespace dfmbase {
-enum CacheInfoStatus : uint8_t {
-    kCacheMain = 0,   // 1.正常状态 插入(同时插入主和副缓存hash)， 读取主缓存hash， 删除主缓存hash
-    kCacheCopy,
+// 单条缓存，referenced 与 lastAccess 在读锁下更新
+struct InfoCacheEntry
+{
+    FileInfoPointer info;
+    qint64 cost { 0 };   // 估算的内存占用
+    mutable QAtomicInt referenced { 1 };   // CLOCK 访问位
+    mutable QAtomicInteger<qint64> lastAccess { 0 };   // 最近访问时间（秒）
 };
+
+// 按 url 哈希分片，每个分片独立加锁、独立做 CLOCK 淘汰、独立计数
+struct alignas(64) InfoCacheShard
+{
+    QReadWriteLock lock;
+    QHash<QUrl, InfoCacheEntry> entries;
+    QList<QUrl> clock;   // CLOCK 环，允许残留已删除的 url，淘汰时顺带清理
+    int hand { 0 };
+    qint64 cost { 0 };
+    // 每次移除缓存时递增，removedAt 记录各 url 最近一次被移除时的代数。
+    // 创建 info 期间该 url 被移除过则放弃插入，避免写回过期的 info
+    std::atomic<quint64> generation { 0 };
+    QHash<QUrl, quint64> removedAt;
+    quint64 removedFloor { 0 };   // removedAt 清空时的代数，早于它取得的代数一律视为过期
+
+    // 统计计数，读取时汇总各分片，避免所有线程争用同一组计数
+    std::atomic<quint64> hits { 0 };
+    std::atomic<quint64> misses { 0 };
+    std::atomic<quint64> inserts { 0 };
+    std::atomic<quint64> rejects { 0 };
+    std::atomic<quint64> evictions { 0 };
+    std::atomic<quint64> expirations { 0 };
+    std::atomic<quint64> invalidations { 0 };
+};
+
 class InfoCachePrivate
 {
     friend class InfoCache;
@@ -24,24 +56,22 @@ class InfoCachePrivate
     InfoCache *const q;
     DThreadList<QString> disableCahceSchemes;
 
-    QAtomicInt status { kCacheMain };   // 当前状态缓存的状态
-    QHash<QUrl, FileInfoPointer> mainCache;   // 主信息缓存
-    QHash<QUrl, FileInfoPointer> copyCache;   // 副信息缓存
-    QReadWriteLock mianLock;
-    QReadWriteLock copyLock;
+    static constexpr int kShardCount = 32;
+    static constexpr int kMaxRemovedRecords = 1024;   // 每个分片保留的移除记录数
+    std::array<InfoCacheShard, kShardCount> shards;
 
-    // 时间排序url,利用map的有序性，来处理时间到了要移除的url
-    QHash<QUrl, QString> urlTimeSortHash;
-    QMap<QString, QUrl> timeToUrlMap;
-
-    // 时间排序url,利用map的有序性，来处理时间到了要移除的url
-    QHash<QUrl, QString> urlTimeSortWatcherHash;
-    QMap<QString, QUrl> timeToUrlWatcherMap;
+    // 按时间排序的 watcher，利用 map 的有序性处理超出数量要移除的 url
+    QHash<QUrl, qint64> watcherTimeHash;
+    QMultiMap<qint64, QUrl> timeToWatcherMap;
     std::atomic_bool cacheWorkerStoped { false };
 
 public:
     explicit InfoCachePrivate(InfoCache *qq);
     virtual ~InfoCachePrivate();
+
+    InfoCacheShard &shardOf(const QUrl &url);
+    void markRemovedLocked(InfoCacheShard &shard, const QUrl &url);
+    void evictLocked(InfoCacheShard &shard, QMap<QUrl, FileInfoPointer> *evicted);
 };
 }
 
@@ -0,0 +1,489 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <dfm-base/utils/trashindex.h>
+#include <dfm-base/utils/fileutils.h>
+#include <dfm-base/base/standardpaths.h>
+#include <dfm-base/dfm_global_defines.h>
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QSet>
+#include <QStorageInfo>
+
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fts.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace dfmbase;
+
+static constexpr quint32 kIndexMagic = 0x54524958;   // "TRIX"
+static constexpr quint32 kIndexVersion = 1;
+static constexpr char kTrashInfoSuffix[] = ".trashinfo";
+static constexpr qint64 kMountsRefreshInterval = 60 * 1000;   // ms
+
+// 远程文件系统上探测 .Trash 目录可能阻塞，不纳入索引
+static bool isRemoteFileSystem(const QByteArray &fsType)
+{
+    static const QList<QByteArray> kRemoteTypes { "cifs", "smb3", "nfs", "nfs4", "fuse.sshfs", "fuse.dlnfs", "fuse.rclone" };
+    return kRemoteTypes.contains(fsType);
+}
+
+QString TrashIndex::Entry::filePath() const
+{
+    return trashDir + "/files/" + name;
+}
+
+QUrl TrashIndex::Entry::trashUrl() const
+{
+    QUrl url;
+    url.setScheme(Global::Scheme::kTrash);
+    // 家目录回收站中的文件以名称表示，其它挂载点的回收站使用 gvfs 的转义全路径
+    if (trashDir == homeTrashDir())
+        url.setPath("/" + name);
+    else
+        url.setPath(FileUtils::normalPathToTrash(filePath()));
+    return url;
+}
+
+TrashIndex *TrashIndex::instance()
+{
+    static TrashIndex ins;
+    return &ins;
+}
+
+TrashIndex::TrashIndex()
+{
+    // 挂载表变化时 /proc/self/mounts 上产生 POLLPRI，据此刷新回收站目录列表
+    mountsFd = ::open("/proc/self/mounts", O_RDONLY | O_CLOEXEC);
+    load();
+}
+
+TrashIndex::~TrashIndex()
+{
+    // 析构发生在进程退出阶段，不在此写盘，由各任务结束时 sync
+    if (mountsFd >= 0)
+        ::close(mountsFd);
+}
+
+void TrashIndex::addEntry(const Entry &entry)
+{
+    QMutexLocker lk(&mutex);
+    insertLocked(entry);
+    dirty = true;
+}
+
+void TrashIndex::removeEntry(const QUrl &trashUrl)
+{
+    if (trashUrl.scheme() != Global::Scheme::kTrash)
+        return;
+
+    const QString &path = trashUrl.path();
+    QMutexLocker lk(&mutex);
+    if (!path.contains("\\")) {
+        // 只记录回收站的顶层文件，子文件不在索引中
+        if (path.lastIndexOf('/') == 0)
+            eraseLocked(homeTrashDir(), path.mid(1));
+        return;
+    }
+
+    const QString &filePath = FileUtils::trashPathToNormal(path);
+    const int pos = filePath.lastIndexOf("/files/");
+    if (pos > 0)
+        eraseLocked(filePath.left(pos), filePath.mid(pos + 7));
+}
+
+void TrashIndex::clear()
+{
+    QMutexLocker lk(&mutex);
+    dirs.clear();
+    originIndex.clear();
+    dirty = true;
+}
+
+QList<TrashIndex::Entry> TrashIndex::entries()
+{
+    reconcile();
+    QMutexLocker lk(&mutex);
+
+    QList<Entry> result;
+    for (const QString &dir : std::as_const(activeDirs)) {
+        const auto &items = dirs.value(dir).entries;
+        for (auto it = items.cbegin(); it != items.cend(); ++it)
+            result.append(it.value());
+    }
+    return result;
+}
+
+/*!
+ * \brief TrashIndex::findTrashUrls 按原路径查找回收站中的文件
+ * \param startTime endTime 删除时间区间（秒），小于 0 时不限制
+ */
+QList<QUrl> TrashIndex::findTrashUrls(const QString &originalPath, qint64 startTime, qint64 endTime)
+{
+    reconcile();
+    QMutexLocker lk(&mutex);
+
+    QList<QUrl> result;
+    const auto &keys = originIndex.values(originalPath);
+    for (const auto &key : keys) {
+        const auto &entry = dirs.value(key.first).entries.value(key.second);
+        if (startTime >= 0 && entry.deletionTime < startTime)
+            continue;
+        if (endTime >= 0 && entry.deletionTime > endTime)
+            continue;
+        result.append(entry.trashUrl());
+    }
+    return result;
+}
+
+int TrashIndex::count()
+{
+    reconcile();
+    QMutexLocker lk(&mutex);
+
+    int total = 0;
+    for (const QString &dir : std::as_const(activeDirs))
+        total += dirs.value(dir).entries.size();
+    return total;
+}
+
+/*!
+ * \brief TrashIndex::totalSize 回收站总大小，只统计尚未记录大小的项
+ */
+qint64 TrashIndex::totalSize()
+{
+    reconcile();
+    QList<QPair<QString, QString>> unknown;
+    {
+        QMutexLocker lk(&mutex);
+        for (const QString &dir : std::as_const(activeDirs)) {
+            const auto &items = dirs.value(dir).entries;
+            for (auto it = items.cbegin(); it != items.cend(); ++it) {
+                if (it.value().size < 0)
+                    unknown.append({ dir, it.key() });
+            }
+        }
+    }
+
+    // 统计大小可能耗时，不持有锁
+    QList<qint64> sizes;
+    sizes.reserve(unknown.size());
+    for (const auto &key : std::as_const(unknown))
+        sizes.append(computeSize(key.first + "/files/" + key.second));
+
+    QMutexLocker lk(&mutex);
+    for (int i = 0; i < unknown.size(); ++i) {
+        auto dir = dirs.find(unknown.at(i).first);
+        if (dir == dirs.end())
+            continue;
+        auto entry = dir->entries.find(unknown.at(i).second);
+        if (entry != dir->entries.end()) {
+            entry->size = sizes.at(i);
+            dirty = true;
+        }
+    }
+
+    qint64 total = 0;
+    for (const QString &dir : std::as_const(activeDirs)) {
+        const auto &items = dirs.value(dir).entries;
+        for (auto it = items.cbegin(); it != items.cend(); ++it)
+            total += qMax<qint64>(0, it.value().size);
+    }
+    return total;
+}
+
+void TrashIndex::sync()
+{
+    QMutexLocker lk(&mutex);
+    if (!dirty)
+        return;
+
+    const QString &path = indexFilePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(logDFMBase) << "trash index: cannot write" << path;
+        return;
+    }
+
+    QDataStream out(&file);
+    out << kIndexMagic << kIndexVersion << static_cast<qint32>(dirs.size());
+    for (auto dir = dirs.cbegin(); dir != dirs.cend(); ++dir) {
+        out << dir.key() << dir->stamp << static_cast<qint32>(dir->entries.size());
+        for (const auto &entry : dir->entries)
+            out << entry.name << entry.originalPath << entry.deletionTime << entry.size;
+    }
+
+    if (file.commit())
+        dirty = false;
+}
+
+QString TrashIndex::homeTrashDir()
+{
+    static const QString dir = StandardPaths::location(StandardPaths::kTrashLocalPath);
+    return dir;
+}
+
+/*!
+ * \brief TrashIndex::trashDirs 家目录回收站与各挂载点上属于当前用户的回收站
+ */
+QStringList TrashIndex::trashDirs()
+{
+    QStringList result { homeTrashDir() };
+    const QString &uid = QString::number(::getuid());
+    const auto &volumes = QStorageInfo::mountedVolumes();
+    for (const auto &volume : volumes) {
+        if (!volume.isValid() || !volume.isReady() || isRemoteFileSystem(volume.fileSystemType()))
+            continue;
+        const QString &root = volume.rootPath();
+        if (root == "/")
+            continue;
+
+        const QString &topDir = root.endsWith('/') ? root : root + '/';
+        for (const QString &dir : { topDir + ".Trash/" + uid, topDir + ".Trash-" + uid }) {
+            if (!result.contains(dir) && QFileInfo(dir + "/info").isDir())
+                result.append(dir);
+        }
+    }
+    return result;
+}
+
+bool TrashIndex::parseTrashInfo(const QString &trashDir, const QByteArray &content, Entry *entry)
+{
+    QString path;
+    QString date;
+    const auto &lines = content.split('\n');
+    for (const QByteArray &line : lines) {
+        if (line.startsWith("Path="))
+            path = QUrl::fromPercentEncoding(line.mid(5).trimmed());
+        else if (line.startsWith("DeletionDate="))
+            date = QString::fromLatin1(line.mid(13).trimmed());
+    }
+
+    if (path.isEmpty())
+        return false;
+
+    // 挂载点回收站中的路径相对于挂载点（.Trash-uid 或 .Trash/uid 的上级目录）
+    if (!path.startsWith('/')) {
+        QString topDir = QFileInfo(trashDir).absolutePath();
+        if (topDir.endsWith("/.Trash"))
+            topDir = QFileInfo(topDir).absolutePath();
+        path = QDir::cleanPath(topDir + '/' + path);
+    }
+
+    entry->trashDir = trashDir;
+    entry->originalPath = path;
+    entry->deletionTime = QDateTime::fromString(date, Qt::ISODate).toSecsSinceEpoch();
+    return true;
+}
+
+void TrashIndex::load()
+{
+    QFile file(indexFilePath());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 dirCount = 0;
+    in >> magic >> version >> dirCount;
+    if (magic != kIndexMagic || version != kIndexVersion)
+        return;
+
+    QMutexLocker lk(&mutex);
+    for (qint32 i = 0; i < dirCount && in.status() == QDataStream::Ok; ++i) {
+        QString dirPath;
+        qint64 stamp = -1;
+        qint32 entryCount = 0;
+        in >> dirPath >> stamp >> entryCount;
+        for (qint32 j = 0; j < entryCount && in.status() == QDataStream::Ok; ++j) {
+            Entry entry;
+            entry.trashDir = dirPath;
+            in >> entry.name >> entry.originalPath >> entry.deletionTime >> entry.size;
+            insertLocked(entry);
+        }
+        dirs[dirPath].stamp = stamp;
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qCWarning(logDFMBase) << "trash index: corrupted index file, rebuild it";
+        dirs.clear();
+        originIndex.clear();
+    }
+}
+
+/*!
+ * \brief TrashIndex::currentTrashDirs 回收站目录列表，仅在挂载表变化后重新探测
+ */
+QStringList TrashIndex::currentTrashDirs()
+{
+    {
+        QMutexLocker lk(&mutex);
+        if (!activeDirs.isEmpty() && !mountTableChanged())
+            return activeDirs;
+        mountsTimer.start();
+    }
+
+    // 枚举挂载点需要访问各个文件系统，不持有锁
+    const QStringList &result = trashDirs();
+    QMutexLocker lk(&mutex);
+    activeDirs = result;
+    return result;
+}
+
+bool TrashIndex::mountTableChanged()
+{
+    // 挂载后才创建的 .Trash-uid 目录靠定时刷新发现
+    if (!mountsTimer.isValid() || mountsTimer.hasExpired(kMountsRefreshInterval))
+        return true;
+    if (mountsFd < 0)
+        return false;
+
+    struct pollfd pfd { mountsFd, POLLPRI, 0 };
+    return ::poll(&pfd, 1, 0) > 0 && (pfd.revents & (POLLPRI | POLLERR));
+}
+
+void TrashIndex::reconcile()
+{
+    const QStringList &dirList = currentTrashDirs();
+    for (const QString &dir : dirList) {
+        const qint64 stamp = infoDirStamp(dir);
+        bool changed = false;
+        {
+            QMutexLocker lk(&mutex);
+            changed = stamp != dirs.value(dir).stamp;
+        }
+        if (changed)
+            rescanDir(dir, stamp);
+    }
+}
+
+/*!
+ * \brief TrashIndex::rescanDir 对比 info 目录中的文件名与索引，只解析新增项
+ */
+void TrashIndex::rescanDir(const QString &trashDir, qint64 stamp)
+{
+    QSet<QString> known;
+    {
+        QMutexLocker lk(&mutex);
+        const auto &items = dirs.value(trashDir).entries;
+        for (auto it = items.cbegin(); it != items.cend(); ++it)
+            known.insert(it.key());
+    }
+
+    const QByteArray &infoPath = QFile::encodeName(trashDir + "/info");
+    DIR *dir = ::opendir(infoPath.constData());
+    if (!dir) {
+        QMutexLocker lk(&mutex);
+        for (const QString &name : std::as_const(known))
+            eraseLocked(trashDir, name);
+        dirs.remove(trashDir);
+        dirty = true;
+        return;
+    }
+
+    const int suffixLen = static_cast<int>(strlen(kTrashInfoSuffix));
+    QSet<QString> names;
+    while (struct dirent *ent = ::readdir(dir)) {
+        const QByteArray fileName(ent->d_name);
+        if (!fileName.endsWith(kTrashInfoSuffix))
+            continue;
+        names.insert(QFile::decodeName(fileName.left(fileName.size() - suffixLen)));
+    }
+    ::closedir(dir);
+
+    QList<Entry> added;
+    for (const QString &name : std::as_const(names)) {
+        if (known.contains(name))
+            continue;
+
+        QFile info(trashDir + "/info/" + name + kTrashInfoSuffix);
+        if (!info.open(QIODevice::ReadOnly))
+            continue;
+        Entry entry;
+        if (!parseTrashInfo(trashDir, info.read(64 * 1024), &entry))
+            continue;
+        entry.name = name;
+        added.append(entry);
+    }
+
+    QMutexLocker lk(&mutex);
+    // 只移除扫描前已知的项，扫描期间由任务新加入的项保留
+    for (const QString &name : std::as_const(known)) {
+        if (!names.contains(name))
+            eraseLocked(trashDir, name);
+    }
+    for (const Entry &entry : std::as_const(added)) {
+        if (!dirs.value(trashDir).entries.contains(entry.name))
+            insertLocked(entry);
+    }
+
+    dirs[trashDir].stamp = stamp;
+    dirty = true;
+}
+
+void TrashIndex::insertLocked(const Entry &entry)
+{
+    auto &items = dirs[entry.trashDir].entries;
+    auto old = items.constFind(entry.name);
+    if (old != items.cend())
+        originIndex.remove(old->originalPath, { entry.trashDir, entry.name });
+
+    items.insert(entry.name, entry);
+    originIndex.insert(entry.originalPath, { entry.trashDir, entry.name });
+}
+
+void TrashIndex::eraseLocked(const QString &trashDir, const QString &name)
+{
+    auto dir = dirs.find(trashDir);
+    if (dir == dirs.end())
+        return;
+
+    auto it = dir->entries.find(name);
+    if (it == dir->entries.end())
+        return;
+
+    originIndex.remove(it->originalPath, { trashDir, name });
+    dir->entries.erase(it);
+    dirty = true;
+}
+
+qint64 TrashIndex::infoDirStamp(const QString &trashDir)
+{
+    struct stat st;
+    if (::stat(QFile::encodeName(trashDir + "/info").constData(), &st) != 0)
+        return -1;
+    return static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+qint64 TrashIndex::computeSize(const QString &path)
+{
+    QByteArray localPath = QFile::encodeName(path);
+    char *paths[] = { localPath.data(), nullptr };
+    FTS *fts = ::fts_open(paths, FTS_PHYSICAL | FTS_NOCHDIR, nullptr);
+    if (!fts)
+        return 0;
+
+    qint64 total = 0;
+    while (FTSENT *ent = ::fts_read(fts)) {
+        if (ent->fts_info == FTS_F || ent->fts_info == FTS_SL || ent->fts_info == FTS_SLNONE || ent->fts_info == FTS_DEFAULT)
+            total += ent->fts_statp->st_size;
+    }
+    ::fts_close(fts);
+    return total;
+}
+
+QString TrashIndex::indexFilePath()
+{
+    return StandardPaths::location(StandardPaths::kCachePath) + "/trash-index";
+}
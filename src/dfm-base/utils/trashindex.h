@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef TRASHINDEX_H
+#define TRASHINDEX_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMultiHash>
+#include <QMutex>
+#include <QStringList>
+#include <QUrl>
+
+namespace dfmbase {
+
+/*!
+ * \brief The TrashIndex class keeps a persistent index of every trashed item
+ * (original path, deletion time, size and the trash directory it lives in).
+ *
+ * The file operation workers update it as they trash, restore and clean
+ * items. Before each query the index is reconciled lazily: the list of
+ * trash directories is rebuilt only after the mount table changes or once a
+ * minute, a trash directory is rescanned only when the mtime of its info dir
+ * differs from the stamp recorded at the last scan, and then only the names
+ * are diffed, so known items are never parsed or sized twice. Scanning
+ * happens outside the lock. The index is written to disk by sync(), which
+ * the workers call when they finish.
+ */
+class TrashIndex
+{
+public:
+    struct Entry
+    {
+        QString trashDir;   // ~/.local/share/Trash, <mount>/.Trash-uid or <mount>/.Trash/uid
+        QString name;   // 回收站 files 目录中的名称
+        QString originalPath;
+        qint64 deletionTime { 0 };   // secs since epoch
+        qint64 size { -1 };   // -1 表示尚未统计
+
+        QString filePath() const;
+        QUrl trashUrl() const;
+    };
+
+    static TrashIndex *instance();
+
+    void addEntry(const Entry &entry);
+    void removeEntry(const QUrl &trashUrl);
+    void clear();
+
+    QList<Entry> entries();
+    QList<QUrl> findTrashUrls(const QString &originalPath, qint64 startTime = -1, qint64 endTime = -1);
+    int count();
+    qint64 totalSize();
+
+    void sync();
+
+    static QString homeTrashDir();
+    static QStringList trashDirs();
+    static bool parseTrashInfo(const QString &trashDir, const QByteArray &content, Entry *entry);
+
+private:
+    struct DirIndex
+    {
+        qint64 stamp { -1 };
+        QHash<QString, Entry> entries;   // name -> entry
+    };
+
+    TrashIndex();
+    ~TrashIndex();
+
+    void load();
+    QStringList currentTrashDirs();
+    bool mountTableChanged();
+    void reconcile();
+    void rescanDir(const QString &trashDir, qint64 stamp);
+    void insertLocked(const Entry &entry);
+    void eraseLocked(const QString &trashDir, const QString &name);
+    static qint64 infoDirStamp(const QString &trashDir);
+    static qint64 computeSize(const QString &path);
+    static QString indexFilePath();
+
+    QMutex mutex;
+    QHash<QString, DirIndex> dirs;   // trashDir -> items
+    QMultiHash<QString, QPair<QString, QString>> originIndex;   // originalPath -> (trashDir, name)
+    QStringList activeDirs;
+    int mountsFd { -1 };
+    QElapsedTimer mountsTimer;   // 上次探测回收站目录的时间
+    bool dirty { false };
+};
+
+}
+
+#endif   // TRASHINDEX_H
@@ -115,7 +115,34 @@ void BurnEventReceiver::handlePasteTo(const QList<QUrl> &urls, const QUrl &dest,
         tmpDest = UrlRoute::urlParent(tmpDest);
     QDir().mkpath(tmpDest.toLocalFile());
 
-    BurnEventCaller::sendPasteFiles(urls, tmpDest, isCopy);
+    if (!isCopy || !BurnHelper::isStagingByLinkEnabled()) {
+        BurnEventCaller::sendPasteFiles(urls, tmpDest, isCopy);
+        return;
+    }
+
+    // 同一文件系统中的文件以硬链接加入暂存区，其余文件仍然复制
+    using LinkResult = QPair<QList<QUrl>, QList<QUrl>>;
+    auto watcher = new QFutureWatcher<LinkResult>(this);
+    connect(watcher, &QFutureWatcher<LinkResult>::finished, this, [watcher, urls, tmpDest]() {
+        const LinkResult &result = watcher->result();
+        watcher->deleteLater();
+
+        if (!result.first.isEmpty())
+            BurnHelper::mapStagingFilesPath(result.first, result.second);
+
+        QList<QUrl> restUrls;
+        for (const QUrl &url : urls) {
+            if (!result.first.contains(url))
+                restUrls.append(url);
+        }
+        if (!restUrls.isEmpty())
+            BurnEventCaller::sendPasteFiles(restUrls, tmpDest, true);
+    });
+    watcher->setFuture(QtConcurrent::run([urls, tmpDest]() {
+        QList<QUrl> targetList;
+        const QList<QUrl> &linkedList = BurnHelper::linkFilesToStaging(urls, tmpDest, &targetList);
+        return LinkResult(linkedList, targetList);
+    }));
 }
 
 void BurnEventReceiver::handleCopyFilesResult(const QList<QUrl> &srcUrls, const QList<QUrl> &destUrls, bool ok, const QString &errMsg)
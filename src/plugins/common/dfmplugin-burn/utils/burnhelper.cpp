@@ -21,6 +21,11 @@
 #include <QStandardPaths>
 #include <QRegularExpression>
 #include <QApplication>
+#include <QFile>
+
+#include <climits>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace dfmplugin_burn;
 DWIDGET_USE_NAMESPACE
@@ -225,6 +230,96 @@ bool BurnHelper::isBurnEnabled()
     return ret.isValid() ? ret.toBool() : true;
 }
 
+bool BurnHelper::isStagingByLinkEnabled()
+{
+    const auto &&ret = DConfigManager::instance()->value("org.deepin.dde.file-manager.burn", "stagingByHardLink");
+    return ret.isValid() ? ret.toBool() : true;
+}
+
+static bool linkTreeToStaging(const QString &src, const QString &target)
+{
+    const QByteArray &srcPath = QFile::encodeName(src);
+    const QByteArray &targetPath = QFile::encodeName(target);
+    struct stat st;
+    if (::lstat(srcPath.constData(), &st) != 0)
+        return false;
+
+    if (S_ISREG(st.st_mode))
+        return ::link(srcPath.constData(), targetPath.constData()) == 0;
+
+    if (S_ISLNK(st.st_mode)) {
+        QByteArray linkTarget(PATH_MAX, '\0');
+        const ssize_t len = ::readlink(srcPath.constData(), linkTarget.data(), size_t(linkTarget.size()));
+        if (len <= 0 || len >= linkTarget.size())
+            return false;
+        linkTarget.truncate(int(len));
+        return ::symlink(linkTarget.constData(), targetPath.constData()) == 0;
+    }
+
+    if (S_ISDIR(st.st_mode)) {
+        if (::mkdir(targetPath.constData(), (st.st_mode & 07777) | S_IRWXU) != 0)
+            return false;
+        const QStringList &names = QDir(src).entryList(QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot);
+        for (const QString &name : names) {
+            if (!linkTreeToStaging(src + "/" + name, target + "/" + name))
+                return false;
+        }
+        return true;
+    }
+
+    // 设备文件、管道等交给复制任务处理
+    return false;
+}
+
+/*!
+ * \brief 以硬链接的方式将文件加入暂存区
+ * \note
+ *  刻录时 xorriso 直接从暂存区读取文件写入光盘，暂存区中的文件只需要引用源文件，
+ *  不必复制一份完整数据。只处理与暂存区位于同一文件系统的文件，目录会重建目录结构并逐个链接其中的文件。
+ *  任何一项无法链接（跨文件系统、重名、权限限制等）时撤销该项，交由复制任务处理。
+ * \return 成功加入暂存区的源文件，targetList 返回对应的暂存区文件
+ */
+QList<QUrl> BurnHelper::linkFilesToStaging(const QList<QUrl> &srcList, const QUrl &stagingDir, QList<QUrl> *targetList)
+{
+    Q_ASSERT(targetList);
+
+    QList<QUrl> linkedList;
+    const QString &dirPath = stagingDir.toLocalFile();
+    struct stat dirStat;
+    if (::stat(QFile::encodeName(dirPath).constData(), &dirStat) != 0)
+        return linkedList;
+
+    for (const QUrl &src : srcList) {
+        if (!src.isLocalFile())
+            continue;
+
+        const QString &srcPath = src.toLocalFile();
+        struct stat st;
+        if (::lstat(QFile::encodeName(srcPath).constData(), &st) != 0 || st.st_dev != dirStat.st_dev)
+            continue;
+
+        // 重名时由复制任务处理冲突
+        const QString &target = dirPath + "/" + QFileInfo(srcPath).fileName();
+        struct stat targetStat;
+        if (::lstat(QFile::encodeName(target).constData(), &targetStat) == 0)
+            continue;
+
+        if (linkTreeToStaging(srcPath, target)) {
+            linkedList.append(src);
+            targetList->append(QUrl::fromLocalFile(target));
+            continue;
+        }
+
+        fmInfo() << "Cannot link to staging, fallback to copy:" << srcPath;
+        if (S_ISDIR(st.st_mode))
+            QDir(target).removeRecursively();
+        else
+            QFile::remove(target);
+    }
+
+    return linkedList;
+}
+
 bool BurnHelper::burnIsOnLocalStaging(const QUrl &url)
 {
     if (!url.path().contains("/.cache/deepin/discburn/_dev_"))
@@ -35,6 +35,8 @@ public:
     static void updateBurningStateToPersistence(const QString &id, const QString &dev, bool working);
     static void mapStagingFilesPath(const QList<QUrl> &srcList, const QList<QUrl> &targetList);
     static bool isBurnEnabled();
+    static bool isStagingByLinkEnabled();
+    static QList<QUrl> linkFilesToStaging(const QList<QUrl> &srcList, const QUrl &stagingDir, QList<QUrl> *targetList);
     static bool burnIsOnLocalStaging(const QUrl &url);
     static QFileInfoList localFileInfoList(const QString &path);
     static QFileInfoList localFileInfoListRecursive(const QString &path, QDir::Filters filters = (QDir::Files | QDir::NoSymLinks));
@@ -12,15 +12,44 @@
 
 #include <dfm-framework/event/event.h>
 #include <dfm-io/dfileinfo.h>
+#include <dfm-io/dfmio_utils.h>
 
 #include <QDebug>
+#include <QFile>
 #include <QStandardPaths>
 
+#undef signals
+extern "C" {
+#include <gio/gio.h>
+}
+#define signals public
+
 USING_IO_NAMESPACE
 DFMBASE_USE_NAMESPACE
 DPF_USE_NAMESPACE
 DPEMBLEM_USE_NAMESPACE
 
+static constexpr char kEmblemAttribute[] { "metadata::emblems" };
+static constexpr int kMaxIndexedDirs { 32 };
+static constexpr int kMaxParsedEmblems { 512 };
+static constexpr int kMaxCachedProducts { 10000 };
+// 角标通常由外部工具写入 gvfs 元数据，不一定触发文件监视，索引超时后重新读取
+static constexpr qint64 kIndexTimeout { 60 * 1000 };
+
+static QString emblemStringOfInfo(GFileInfo *info)
+{
+    switch (g_file_info_get_attribute_type(info, kEmblemAttribute)) {
+    case G_FILE_ATTRIBUTE_TYPE_STRINGV: {
+        char **emblems = g_file_info_get_attribute_stringv(info, kEmblemAttribute);
+        return emblems && emblems[0] ? QString::fromUtf8(emblems[0]) : QString();
+    }
+    case G_FILE_ATTRIBUTE_TYPE_STRING:
+        return QString::fromUtf8(g_file_info_get_attribute_string(info, kEmblemAttribute));
+    default:
+        return QString();
+    }
+}
+
 void GioEmblemWorker::onProduce(const FileInfoPointer &info)
 {
     Q_ASSERT(qApp->thread() != QThread::currentThread());
@@ -35,6 +64,9 @@ void GioEmblemWorker::onProduce(const FileInfoPointer &info)
             emit emblemChanged(url, emblems);
         }
     } else {   // save to cache
+        // 只在切换目录时清空，浏览大目录或长时间停留在桌面时限制其大小
+        if (cache.count() >= kMaxCachedProducts)
+            cache.clear();
         cache.insert(url, emblems);
         emit emblemChanged(url, emblems);
     }
@@ -42,18 +74,51 @@ void GioEmblemWorker::onProduce(const FileInfoPointer &info)
 
 void GioEmblemWorker::onClear()
 {
+    // 目录索引由文件监视维护，切换目录时不需要丢弃
     cache.clear();
+    parsedEmblems.clear();
 }
 
-QList<QIcon> GioEmblemWorker::fetchEmblems(const FileInfoPointer &info) const
+void GioEmblemWorker::onFileChanged(const QUrl &url)
+{
+    Q_ASSERT(qApp->thread() != QThread::currentThread());
+
+    if (dirIndexes.contains(url)) {
+        dropDirectory(url);
+        return;
+    }
+
+    const QUrl &dirUrl = DFMIO::DFMUtils::directParentUrl(url);
+    auto it = dirIndexes.find(dirUrl);
+    if (it == dirIndexes.end())
+        return;
+
+    // 只重新读取变化的文件，不重建整个目录的索引
+    g_autoptr(GFile) file = g_file_new_for_path(QFile::encodeName(url.toLocalFile()).constData());
+    g_autoptr(GFileInfo) info = g_file_query_info(file, kEmblemAttribute, G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS, nullptr, nullptr);
+    const QString &emblemsStr = info ? emblemStringOfInfo(info) : QString();
+    if (emblemsStr.isEmpty())
+        it->emblems.remove(url.fileName());
+    else
+        it->emblems.insert(url.fileName(), emblemsStr);
+}
+
+QList<QIcon> GioEmblemWorker::fetchEmblems(const FileInfoPointer &info)
 {
     if (!info)
         return {};
 
     QList<QIcon> emblemList;
 
-    // add gio emblem icons
-    const auto &gioEmblemsMap = getGioEmblems(info);
+    // add gio emblem icons, the same emblem string is shared by many files
+    const QString &emblemsStr = emblemStringOf(info);
+    auto parsed = parsedEmblems.constFind(emblemsStr);
+    if (parsed == parsedEmblems.constEnd()) {
+        if (parsedEmblems.count() >= kMaxParsedEmblems)
+            parsedEmblems.clear();
+        parsed = parsedEmblems.insert(emblemsStr, parseEmblems(emblemsStr));
+    }
+    const auto &gioEmblemsMap = parsed.value();
     QMap<int, QIcon>::const_iterator iter = gioEmblemsMap.begin();
     while (iter != gioEmblemsMap.end()) {
         if (iter.key() == emblemList.count()) {
@@ -76,18 +141,81 @@ QList<QIcon> GioEmblemWorker::fetchEmblems(const FileInfoPointer &info) const
     return emblemList;
 }
 
-QMap<int, QIcon> GioEmblemWorker::getGioEmblems(const FileInfoPointer &info) const
+/*!
+ * \brief 获取文件的角标描述
+ * \note
+ *  本地文件从所在目录的索引中查找，目录第一次被访问时通过一次枚举读取其下所有文件的角标元数据，
+ *  之后每次绘制只需要一次哈希查找。无法建立索引时退回到逐个文件读取。
+ */
+QString GioEmblemWorker::emblemStringOf(const FileInfoPointer &info)
 {
-    QMap<int, QIcon> emblemsMap;
+    const QUrl &url = info->urlOf(UrlInfoType::kUrl);
+    if (url.isLocalFile()) {
+        if (const DirEmblemIndex *index = directoryIndex(DFMIO::DFMUtils::directParentUrl(url)))
+            return index->emblems.value(url.fileName());
+    }
 
-    if (!info)
-        return {};
-    const QStringList &emblemData = info->customAttribute("metadata::emblems", DFileInfo::DFileAttributeType::kTypeStringV).toStringList();
+    const QStringList &emblemData = info->customAttribute(kEmblemAttribute, DFileInfo::DFileAttributeType::kTypeStringV).toStringList();
+    return emblemData.isEmpty() ? QString() : emblemData.first();
+}
 
-    if (emblemData.isEmpty())
-        return emblemsMap;
+const GioEmblemWorker::DirEmblemIndex *GioEmblemWorker::directoryIndex(const QUrl &dirUrl)
+{
+    if (!dirUrl.isValid())
+        return nullptr;
+
+    auto it = dirIndexes.find(dirUrl);
+    if (it != dirIndexes.end()) {
+        if (!it->age.hasExpired(kIndexTimeout)) {
+            dirOrder.move(dirOrder.indexOf(dirUrl), dirOrder.count() - 1);
+            return &it.value();
+        }
+        dropDirectory(dirUrl);
+    }
+
+    g_autoptr(GFile) dir = g_file_new_for_path(QFile::encodeName(dirUrl.toLocalFile()).constData());
+    g_autoptr(GError) error = nullptr;
+    g_autoptr(GFileEnumerator) enumerator = g_file_enumerate_children(dir, "standard::name,metadata::emblems",
+                                                                      G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS, nullptr, &error);
+    if (!enumerator) {
+        fmDebug() << "Emblem: enumerate" << dirUrl << "failed:" << (error ? error->message : "");
+        return nullptr;
+    }
+
+    DirEmblemIndex index;
+    while (true) {
+        GFileInfo *child = nullptr;
+        if (!g_file_enumerator_iterate(enumerator, &child, nullptr, nullptr, &error) || !child)
+            break;
+        const QString &emblemsStr = emblemStringOfInfo(child);
+        if (!emblemsStr.isEmpty())
+            index.emblems.insert(QFile::decodeName(g_file_info_get_name(child)), emblemsStr);
+    }
+    if (error) {
+        fmDebug() << "Emblem: enumerate" << dirUrl << "failed:" << error->message;
+        return nullptr;
+    }
+
+    if (dirOrder.count() >= kMaxIndexedDirs)
+        dropDirectory(dirOrder.first());
 
-    const QString &emblemsStr = emblemData.first();
+    index.age.start();
+    dirOrder.append(dirUrl);
+    it = dirIndexes.insert(dirUrl, index);
+    emit directoryIndexed(dirUrl);
+    return &it.value();
+}
+
+void GioEmblemWorker::dropDirectory(const QUrl &dirUrl)
+{
+    dirIndexes.remove(dirUrl);
+    dirOrder.removeOne(dirUrl);
+    emit directoryDropped(dirUrl);
+}
+
+QMap<int, QIcon> GioEmblemWorker::parseEmblems(const QString &emblemsStr) const
+{
+    QMap<int, QIcon> emblemsMap;
 
     if (!emblemsStr.isEmpty()) {
 #if (QT_VERSION <= QT_VERSION_CHECK(5, 15, 0))
@@ -198,6 +326,10 @@ EmblemHelper::EmblemHelper(QObject *parent)
 
 EmblemHelper::~EmblemHelper()
 {
+    for (const auto &watcher : std::as_const(indexWatchers))
+        watcher->stopWatcher();
+    indexWatchers.clear();
+
     workerThread.quit();
     workerThread.wait();
 }
@@ -288,6 +420,8 @@ bool EmblemHelper::isExtEmblemProhibited(const FileInfoPointer &info, const QUrl
 
 void EmblemHelper::onEmblemChanged(const QUrl &url, const Product &product)
 {
+    if (productQueue.count() >= kMaxCachedProducts && !productQueue.contains(url))
+        productQueue.clear();
     productQueue[url] = product;
     if (product.isEmpty())
         return;
@@ -309,6 +443,37 @@ bool EmblemHelper::onUrlChanged(quint64 windowId, const QUrl &url)
     return false;
 }
 
+void EmblemHelper::onDirectoryIndexed(const QUrl &dirUrl)
+{
+    if (indexWatchers.contains(dirUrl))
+        return;
+
+    // 不使用缓存的监视器，目录索引被丢弃时可以直接停止，不影响其他使用者
+    AbstractFileWatcherPointer watcher { WatcherFactory::create<AbstractFileWatcher>(dirUrl, false) };
+    if (!watcher)
+        return;
+
+    connect(watcher.data(), &AbstractFileWatcher::fileAttributeChanged, this, &EmblemHelper::requestFileChanged);
+    connect(watcher.data(), &AbstractFileWatcher::subfileCreated, this, &EmblemHelper::requestFileChanged);
+    connect(watcher.data(), &AbstractFileWatcher::fileDeleted, this, &EmblemHelper::requestFileChanged);
+    connect(watcher.data(), &AbstractFileWatcher::fileRename, this, [this](const QUrl &oldUrl, const QUrl &newUrl) {
+        emit requestFileChanged(oldUrl);
+        emit requestFileChanged(newUrl);
+    });
+    watcher->startWatcher();
+    indexWatchers.insert(dirUrl, watcher);
+}
+
+void EmblemHelper::onDirectoryDropped(const QUrl &dirUrl)
+{
+    AbstractFileWatcherPointer watcher = indexWatchers.take(dirUrl);
+    if (!watcher)
+        return;
+
+    watcher->disconnect(this);
+    watcher->stopWatcher();
+}
+
 void EmblemHelper::initialize()
 {
     Q_ASSERT(qApp->thread() == QThread::currentThread());
@@ -318,7 +483,10 @@ void EmblemHelper::initialize()
     connect(&workerThread, &QThread::finished, worker, &QObject::deleteLater);
     connect(this, &EmblemHelper::requestProduce, worker, &GioEmblemWorker::onProduce, Qt::QueuedConnection);
     connect(this, &EmblemHelper::requestClear, worker, &GioEmblemWorker::onClear, Qt::QueuedConnection);
+    connect(this, &EmblemHelper::requestFileChanged, worker, &GioEmblemWorker::onFileChanged, Qt::QueuedConnection);
     connect(worker, &GioEmblemWorker::emblemChanged, this, &EmblemHelper::onEmblemChanged, Qt::QueuedConnection);
+    connect(worker, &GioEmblemWorker::directoryIndexed, this, &EmblemHelper::onDirectoryIndexed, Qt::QueuedConnection);
+    connect(worker, &GioEmblemWorker::directoryDropped, this, &EmblemHelper::onDirectoryDropped, Qt::QueuedConnection);
 
     workerThread.start();
 }
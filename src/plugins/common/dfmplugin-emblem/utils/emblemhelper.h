@@ -8,11 +8,13 @@
 #include "dfmplugin_emblem_global.h"
 
 #include <dfm-base/interfaces/fileinfo.h>
+#include <dfm-base/interfaces/abstractfilewatcher.h>
 
 #include <dfm-framework/dpf.h>
 
 #include <QIcon>
 #include <QThread>
+#include <QElapsedTimer>
 
 DPEMBLEM_BEGIN_NAMESPACE
 using Product = QList<QIcon>;   // for a url
@@ -23,23 +25,39 @@ class GioEmblemWorker : public QObject
     Q_OBJECT
 
 public:
-    QList<QIcon> fetchEmblems(const FileInfoPointer &info) const;
+    QList<QIcon> fetchEmblems(const FileInfoPointer &info);
 
 public Q_SLOTS:
     void onProduce(const FileInfoPointer &info);
     void onClear();
+    void onFileChanged(const QUrl &url);
 
 Q_SIGNALS:
     void emblemChanged(const QUrl &url, const Product &product);
+    void directoryIndexed(const QUrl &dirUrl);
+    void directoryDropped(const QUrl &dirUrl);
 
 private:
-    QMap<int, QIcon> getGioEmblems(const FileInfoPointer &info) const;
+    // 一个目录下所有带有 metadata::emblems 的文件，key 为文件名
+    struct DirEmblemIndex
+    {
+        QHash<QString, QString> emblems;
+        QElapsedTimer age;
+    };
+
+    QString emblemStringOf(const FileInfoPointer &info);
+    const DirEmblemIndex *directoryIndex(const QUrl &dirUrl);
+    void dropDirectory(const QUrl &dirUrl);
+    QMap<int, QIcon> parseEmblems(const QString &emblemsStr) const;
     bool parseEmblemString(QIcon *emblem, QString &pos, const QString &emblemStr) const;
     bool iconNamesEqual(const QList<QIcon> &first, const QList<QIcon> &second);
     void setEmblemIntoIcons(const QString &pos, const QIcon &emblem, QMap<int, QIcon> *iconMap) const;
 
 private:
     ProductQueue cache;
+    QHash<QUrl, DirEmblemIndex> dirIndexes;
+    QList<QUrl> dirOrder;   // 最近使用的目录在末尾
+    QHash<QString, QMap<int, QIcon>> parsedEmblems;
 };
 
 class EmblemHelper : public QObject
@@ -62,10 +80,13 @@ public:
 Q_SIGNALS:
     void requestProduce(const FileInfoPointer &info);
     void requestClear();
+    void requestFileChanged(const QUrl &url);
 
 private Q_SLOTS:
     void onEmblemChanged(const QUrl &url, const Product &product);
     bool onUrlChanged(quint64 windowId, const QUrl &url);
+    void onDirectoryIndexed(const QUrl &dirUrl);
+    void onDirectoryDropped(const QUrl &dirUrl);
 
 private:
     void initialize();
@@ -74,6 +95,7 @@ private:
 private:
     GioEmblemWorker *worker { new GioEmblemWorker };
     ProductQueue productQueue;
+    QHash<QUrl, AbstractFileWatcherPointer> indexWatchers;
     QThread workerThread;
 };
 
@@ -8,6 +8,7 @@
 #include "events/emblemeventsequence.h"
 
 #include <dfm-base/base/schemefactory.h>
+#include <dfm-base/utils/iconpixmapcache.h>
 
 #include <QPainter>
 
@@ -57,16 +58,14 @@ bool EmblemManager::paintEmblems(int role, const FileInfoPointer &info, QPainter
     if (emblems.isEmpty())
         return false;
 
+    // NOTE: for some special icons, the QIcon::paint function will cast lots of cpu resource.
+    // so paint the cached composite of all emblems with the drawPixmap function.
     const QList<QRectF> &paintRects = helper->emblemRects(*paintArea);
-    for (int i = 0; i < qMin(paintRects.count(), emblems.count()); ++i) {
-        if (emblems.at(i).isNull())
-            continue;
-        // NOTE: for some special icons, the QIcon::paint function will cast lots of cpu resource.
-        // so use the painter drawPixmap function to paint the emblems.
-        QRect emblemRect = paintRects.at(i).toRect();
-        QPixmap emblemPix = emblems.at(i).pixmap(emblemRect.size());
-        painter->drawPixmap(emblemRect, emblemPix);
-    }
+    const qreal pixelRatio = painter->device() ? painter->device()->devicePixelRatioF() : qApp->devicePixelRatio();
+    QPoint topLeft;
+    const QPixmap &composite = IconPixmapCache::instance()->emblemComposite(emblems, paintRects, pixelRatio, &topLeft);
+    if (!composite.isNull())
+        painter->drawPixmap(topLeft, composite);
 
     return true;
 }
@@ -5,6 +5,8 @@
 #include "fileoperations.h"
 #include "fileoperationsevent/fileoperationseventreceiver.h"
 #include "fileoperationsevent/trashfileeventreceiver.h"
+#include "fileoperations/fileoperationutils/jobscheduler.h"
+#include "fileoperations/fileoperationutils/fileoperationsutils.h"
 
 #include <dfm-base/base/urlroute.h>
 #include <dfm-base/base/schemefactory.h>
@@ -34,6 +36,11 @@ bool FileOperations::start()
     if (!ret)
         fmWarning() << "create dconfig failed: " << err;
 
+    JobScheduler::instance()->registerDBus();
+    // 保险箱插件可能晚于本插件加载，所有插件启动后再获取保险箱解锁目录
+    connect(dpfListener, &dpf::Listener::pluginsStarted, this, [] {
+        FileOperationsUtils::updateVaultUnlockPath();
+    }, Qt::DirectConnection);
     return true;
 }
 
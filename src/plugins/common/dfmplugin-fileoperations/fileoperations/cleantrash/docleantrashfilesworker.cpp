@@ -6,11 +6,13 @@
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/base/standardpaths.h>
 #include <dfm-base/utils/universalutils.h>
+#include <dfm-base/utils/trashindex.h>
 #include <dfm-base/file/local/localfilehandler.h>
 
 #include <dfm-io/denumerator.h>
 
 #include <QUrl>
+#include <QSet>
 #include <QDebug>
 
 DFMBASE_USE_NAMESPACE
@@ -31,7 +33,18 @@ bool DoCleanTrashFilesWorker::doWork()
     if (!AbstractWorker::doWork())
         return false;
 
-    cleanAllTrashFiles();
+    const bool cleanAll = !allFilesList.isEmpty();
+    if (cleanAllTrashFiles() && cleanAll) {
+        // 索引未覆盖的项（如挂载后新建的回收站目录）由 gio 枚举兜底
+        const QSet<QUrl> handled(allFilesList.cbegin(), allFilesList.cend());
+        const auto &leftover = enumerateTrashFiles(handled);
+        if (!leftover.isEmpty()) {
+            fmInfo() << "clean" << leftover.size() << "trash files missing from trash index";
+            allFilesList = leftover;
+            cleanAllTrashFiles();
+        }
+    }
+    TrashIndex::instance()->sync();
 
     endWork();
 
@@ -53,12 +66,18 @@ bool DoCleanTrashFilesWorker::statisticsFilesSize()
     if (sourceUrls.size() == 1) {
         const QUrl &urlSource = sourceUrls[0];
         if (UniversalUtils::urlEquals(urlSource, FileUtils::trashRootUrl())) {
-            DFMIO::DEnumerator enumerator(urlSource);
-            while (enumerator.hasNext()) {
-                auto url = FileUtils::bindUrlTransform(enumerator.next());
-                if (!allFilesList.contains(url))
+            // 回收站索引已记录所有顶层文件，无需遍历回收站
+            const auto &entries = TrashIndex::instance()->entries();
+            QSet<QUrl> added;
+            for (const auto &entry : entries) {
+                auto url = FileUtils::bindUrlTransform(entry.trashUrl());
+                if (!added.contains(url)) {
+                    added.insert(url);
                     allFilesList.append(url);
+                }
             }
+            if (allFilesList.isEmpty())
+                allFilesList = enumerateTrashFiles({});
         }
     }
 
@@ -127,6 +146,22 @@ bool DoCleanTrashFilesWorker::cleanAllTrashFiles()
     }
     return true;
 }
+/*!
+ * \brief DoCleanTrashFilesWorker::enumerateTrashFiles List the trash root with gio
+ * \param excluded urls that are already handled
+ * \return top level trash files not in excluded
+ */
+QList<QUrl> DoCleanTrashFilesWorker::enumerateTrashFiles(const QSet<QUrl> &excluded)
+{
+    QList<QUrl> result;
+    DFMIO::DEnumerator enumerator(FileUtils::trashRootUrl());
+    while (enumerator.hasNext()) {
+        auto url = FileUtils::bindUrlTransform(enumerator.next());
+        if (!excluded.contains(url) && !result.contains(url))
+            result.append(url);
+    }
+    return result;
+}
 /*!
  * \brief DoCleanTrashFilesWorker::clearTrashFile
  * \param fromUrl URL of the source file
@@ -146,6 +181,7 @@ bool DoCleanTrashFilesWorker::clearTrashFile(const FileInfoPointer &trashInfo)
             action = doHandleErrorAndWait(fileUrl, AbstractJobHandler::JobErrorType::kDeleteTrashFileError,
                                           false, localFileHandler->errorString());
         } else {
+            TrashIndex::instance()->removeEntry(fileUrl);
             emit fileDeleted(fileUrl);
         }
 
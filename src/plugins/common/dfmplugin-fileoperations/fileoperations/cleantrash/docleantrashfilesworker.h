@@ -13,6 +13,7 @@
 #include <dfm-base/interfaces/fileinfo.h>
 
 #include <QObject>
+#include <QSet>
 
 DPFILEOPERATIONS_BEGIN_NAMESPACE
 DFMBASE_USE_NAMESPACE
@@ -41,6 +42,7 @@ protected:
 
 private:
     bool deleteFile(const QUrl &url);
+    QList<QUrl> enumerateTrashFiles(const QSet<QUrl> &excluded);
 
 private:
     QAtomicInteger<qint64> cleanTrashFilesCount { 0 };
@@ -7,6 +7,7 @@
 #include <dfm-base/interfaces/abstractdiriterator.h>
 #include <dfm-base/utils/clipboard.h>
 #include <dfm-base/utils/protocolutils.h>
+#include <dfm-base/base/standardpaths.h>
 
 #include <dfm-io/dfmio_utils.h>
 
@@ -16,6 +17,10 @@
 #include <QTime>
 #include <QRegularExpression>
 #include <QProcess>
+#include <QDir>
+#include <QDateTime>
+#include <QFile>
+#include <QTextStream>
 #include <QtConcurrent/QtConcurrent>
 
 #include <syscall.h>
@@ -68,6 +73,7 @@ bool DoCopyFilesWorker::doWork()
 
     // sync
     syncFilesToDevice();
+    copyCompleted = !isStopped();
 
     // end
     endWork();
@@ -124,6 +130,12 @@ bool DoCopyFilesWorker::initArgs()
         workData->needSyncEveryRW = fsType == "cifs" || fsType == "vfat";
     }
 
+    // 校验拷贝：拷贝时计算源文件的校验值，完成后绕过缓存读回目标文件比对，并输出校验清单
+    if (FileOperationsUtils::verifiedCopy()) {
+        workData->verifiedCopy = true;
+        workData->jobFlags.setFlag(AbstractJobHandler::JobFlag::kCopyIntegrityChecking);
+    }
+
     return true;
 }
 
@@ -145,9 +157,51 @@ void DoCopyFilesWorker::endWork()
     // set dirs permissions
     setAllDirPermisson();
 
+    writeCheckSumManifest();
+
     FileOperateBaseWorker::endWork();
 }
 
+/*!
+ * \brief DoCopyFilesWorker::writeCheckSumManifest write the crc32 of the verified
+ * files as a sfv file, the paths are relative to the target directory so that the
+ * file can be checked by sfv tools after it is put into the target directory.
+ * A job that is stopped or failed writes a partial manifest, which only lists the
+ * files verified before it ended.
+ */
+void DoCopyFilesWorker::writeCheckSumManifest()
+{
+    if (!workData->verifiedCopy)
+        return;
+
+    const QMap<QUrl, quint32> &checkSums = workData->verifiedCheckSums.map();
+    if (checkSums.isEmpty())
+        return;
+
+    const QString &dirPath = StandardPaths::location(StandardPaths::kCachePath) + "/verified-copies";
+    QDir().mkpath(dirPath);
+    const QString &fileName = QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss-zzz")
+            + (copyCompleted ? ".sfv" : ".partial.sfv");
+    const QString &filePath = dirPath + "/" + fileName;
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        fmWarning() << "cannot write the checksum manifest:" << filePath << file.errorString();
+        return;
+    }
+
+    const QDir targetDir(targetOrgUrl.path());
+    QTextStream out(&file);
+    out << "; verified copy to " << targetDir.absolutePath() << "\n";
+    if (!copyCompleted)
+        out << "; partial: the copy did not complete, only the files below were verified\n";
+    for (auto iter = checkSums.cbegin(); iter != checkSums.cend(); ++iter)
+        out << targetDir.relativeFilePath(iter.key().path()) << " "
+            << QString("%1").arg(iter.value(), 8, 16, QChar('0')).toUpper() << "\n";
+
+    fmInfo() << (copyCompleted ? "checksum manifest of" : "partial checksum manifest of")
+             << checkSums.count() << "files is written to" << filePath;
+}
+
 bool DoCopyFilesWorker::copyFiles()
 {
     for (const QUrl &url : sourceUrls) {
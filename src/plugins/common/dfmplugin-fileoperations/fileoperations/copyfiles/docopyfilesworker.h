@@ -46,9 +46,13 @@ protected:
 
 protected:
     bool copyFiles();
+    void writeCheckSumManifest();
 
 private slots:
     void onUpdateProgress() override;
+
+private:
+    bool copyCompleted { false };   // all files are copied and synced, the checksum manifest is complete
 };
 DPFILEOPERATIONS_END_NAMESPACE
 
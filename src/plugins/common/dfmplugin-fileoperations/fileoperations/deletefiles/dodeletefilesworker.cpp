@@ -3,11 +3,16 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "dodeletefilesworker.h"
+#include "localdeleteengine.h"
+
 #include <dfm-base/base/schemefactory.h>
+#include <dfm-base/utils/protocolutils.h>
 
 #include <QUrl>
 #include <QDebug>
 
+#include <string.h>
+
 DPFILEOPERATIONS_USE_NAMESPACE
 DoDeleteFilesWorker::DoDeleteFilesWorker(QObject *parent)
     : AbstractWorker(parent)
@@ -126,7 +131,12 @@ bool DoDeleteFilesWorker::deleteFilesOnOtherDevice()
 
         if (info->isAttributes(OptInfoType::kIsSymLink) || info->isAttributes(OptInfoType::kIsFile)) {
             ok = deleteFileOnOtherDevice(url);
+        } else if (deleteDirOnLocalDevice(url)) {
+            ok = true;
         } else {
+            if (isStopped())
+                return false;
+            // 快速删除失败时，剩余部分走逐个删除流程以便处理错误
             ok = deleteDirOnOtherDevice(info);
         }
 
@@ -220,6 +230,32 @@ bool DoDeleteFilesWorker::deleteDirOnOtherDevice(const FileInfoPointer &dir)
     // delete self dir
     return deleteFileOnOtherDevice(dir->urlOf(UrlInfoType::kUrl));
 }
+/*!
+ * \brief DoDeleteFilesWorker::deleteDirOnLocalDevice Delete a local dir tree with
+ * the parallel delete engine, without creating file info for its entries
+ * \param url delete dir url
+ * \return true if the whole tree was removed, false if the caller should fall back
+ */
+bool DoDeleteFilesWorker::deleteDirOnLocalDevice(const QUrl &url)
+{
+    if (!url.isLocalFile() || ProtocolUtils::isRemoteFile(url))
+        return false;
+
+    if (!stateCheck())
+        return false;
+
+    emitCurrentTaskNotify(url, QUrl());
+
+    LocalDeleteEngine engine([this](qint64 count) { deleteFilesCount += count; },
+                             [this] { return stateCheck(); });
+    if (engine.removeTree(url.toLocalFile()))
+        return true;
+
+    if (!isStopped())
+        fmWarning() << "fast delete failed at" << engine.errorPath() << strerror(engine.errorCode())
+                    << ", fall back to per-file delete for" << url;
+    return false;
+}
 /*!
  * \brief DoCopyFilesWorker::doHandleErrorAndWait Blocking handles errors and returns
  * actions supported by the operation
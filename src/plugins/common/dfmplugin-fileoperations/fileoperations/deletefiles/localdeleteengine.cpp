@@ -0,0 +1,211 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "localdeleteengine.h"
+
+#include <QFile>
+#include <QThread>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static constexpr int kMaxDeleteThreads = 8;
+static constexpr qint64 kProgressBatch = 256;   // 每删除多少项上报一次进度
+static constexpr int kStateCheckBatch = 256;   // 每遍历多少项检查一次暂停/停止
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+LocalDeleteEngine::LocalDeleteEngine(ProgressCallback progressCallback, StateChecker checker)
+    : progress(std::move(progressCallback)),
+      stateChecker(std::move(checker))
+{
+    pool.setMaxThreadCount(qBound(2, QThread::idealThreadCount(), kMaxDeleteThreads));
+}
+
+LocalDeleteEngine::~LocalDeleteEngine()
+{
+    pool.waitForDone();
+}
+
+bool LocalDeleteEngine::removeTree(const QString &path)
+{
+    const QByteArray &localPath = QFile::encodeName(path);
+    struct stat st;
+    if (::lstat(localPath.constData(), &st) != 0) {
+        setError(localPath, errno);
+        return false;
+    }
+
+    // 文件和符号链接直接删除
+    if (!S_ISDIR(st.st_mode)) {
+        if (::unlink(localPath.constData()) != 0) {
+            setError(localPath, errno);
+            return false;
+        }
+        if (progress)
+            progress(1);
+        return true;
+    }
+
+    scheduleDir(newNode(localPath, nullptr));
+    pool.waitForDone();
+
+    {
+        QMutexLocker lk(&mutex);
+        nodes.clear();
+    }
+
+    return !failed && !shouldStop();
+}
+
+QString LocalDeleteEngine::errorPath() const
+{
+    QMutexLocker lk(&mutex);
+    return QFile::decodeName(failedPath);
+}
+
+int LocalDeleteEngine::errorCode() const
+{
+    QMutexLocker lk(&mutex);
+    return failedErrno;
+}
+
+LocalDeleteEngine::DirNode *LocalDeleteEngine::newNode(const QByteArray &path, DirNode *parent)
+{
+    auto node = std::make_unique<DirNode>();
+    node->path = path;
+    node->parent = parent;
+
+    QMutexLocker lk(&mutex);
+    nodes.push_back(std::move(node));
+    return nodes.back().get();
+}
+
+void LocalDeleteEngine::scheduleDir(DirNode *node)
+{
+    pool.start([this, node] { scanDir(node); });
+}
+
+void LocalDeleteEngine::scanDir(DirNode *node)
+{
+    if (!checkState())
+        return;
+
+    int fd = ::open(node->path.constData(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) {
+        setError(node->path, errno);
+        return;
+    }
+
+    DIR *dir = ::fdopendir(fd);
+    if (!dir) {
+        setError(node->path, errno);
+        ::close(fd);
+        return;
+    }
+
+    qint64 deleted = 0;
+    int visited = 0;
+    struct dirent *entry = nullptr;
+    while ((entry = ::readdir(dir))) {
+        if (++visited % kStateCheckBatch == 0 ? !checkState() : shouldStop())
+            break;
+
+        const char *name = entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+            continue;
+
+        bool isDir = entry->d_type == DT_DIR;
+        if (entry->d_type == DT_UNKNOWN) {
+            struct stat st;
+            if (::fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                setError(node->path + '/' + name, errno);
+                break;
+            }
+            isDir = S_ISDIR(st.st_mode);
+        }
+
+        if (isDir) {
+            // 子目录作为独立任务并行删除
+            ++node->pending;
+            scheduleDir(newNode(node->path + '/' + name, node));
+            continue;
+        }
+
+        if (::unlinkat(fd, name, 0) != 0) {
+            setError(node->path + '/' + name, errno);
+            break;
+        }
+        addDeleted(deleted);
+    }
+
+    ::closedir(dir);
+    addDeleted(deleted, true);
+
+    if (shouldStop())
+        return;
+
+    childFinished(node);
+}
+
+void LocalDeleteEngine::childFinished(DirNode *node)
+{
+    // 目录的子项全部删除后删除目录本身，并通知上级目录
+    qint64 deleted = 0;
+    while (node && --node->pending == 0) {
+        if (shouldStop())
+            break;
+
+        if (::rmdir(node->path.constData()) != 0) {
+            setError(node->path, errno);
+            break;
+        }
+
+        addDeleted(deleted);
+        node = node->parent;
+    }
+    addDeleted(deleted, true);
+}
+
+void LocalDeleteEngine::addDeleted(qint64 &localCount, bool flush)
+{
+    if (!flush)
+        ++localCount;
+
+    if (localCount > 0 && (flush || localCount >= kProgressBatch)) {
+        if (progress)
+            progress(localCount);
+        localCount = 0;
+    }
+}
+
+bool LocalDeleteEngine::shouldStop() const
+{
+    return failed || cancelled;
+}
+
+bool LocalDeleteEngine::checkState()
+{
+    QMutexLocker lk(&stateMutex);
+    if (shouldStop())
+        return false;
+
+    if (stateChecker && !stateChecker())
+        cancelled = true;
+
+    return !cancelled;
+}
+
+void LocalDeleteEngine::setError(const QByteArray &path, int error)
+{
+    QMutexLocker lk(&mutex);
+    if (failed)
+        return;
+
+    failedPath = path;
+    failedErrno = error;
+    failed = true;
+}
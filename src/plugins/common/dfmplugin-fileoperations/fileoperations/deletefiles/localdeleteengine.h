@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef LOCALDELETEENGINE_H
+#define LOCALDELETEENGINE_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/*!
+ * \brief The LocalDeleteEngine class removes local directory trees in parallel.
+ * Each directory is listed with readdir on its own fd and its entries are
+ * removed with unlinkat relative to that fd, without creating any FileInfo.
+ * Subdirectories become independent tasks on a thread pool, and a directory is
+ * removed as soon as its last child is gone. Deleted entries are reported in
+ * batches. The first error aborts the whole run so that the caller can fall
+ * back to the interactive per-file path. The job state is checked once per
+ * directory and every few hundred entries; the checker may block while the
+ * job is paused and returns false once it is stopped.
+ */
+class LocalDeleteEngine
+{
+public:
+    using ProgressCallback = std::function<void(qint64 count)>;
+    using StateChecker = std::function<bool()>;
+
+    LocalDeleteEngine(ProgressCallback progress, StateChecker stateChecker);
+    ~LocalDeleteEngine();
+
+    bool removeTree(const QString &path);
+    QString errorPath() const;
+    int errorCode() const;
+
+private:
+    struct DirNode
+    {
+        QByteArray path;
+        DirNode *parent { nullptr };
+        // 未删除的子目录数 + 1（目录自身尚未遍历完）
+        std::atomic_int pending { 1 };
+    };
+
+    DirNode *newNode(const QByteArray &path, DirNode *parent);
+    void scheduleDir(DirNode *node);
+    void scanDir(DirNode *node);
+    void childFinished(DirNode *node);
+    void addDeleted(qint64 &localCount, bool flush = false);
+    bool shouldStop() const;
+    bool checkState();
+    void setError(const QByteArray &path, int error);
+
+    ProgressCallback progress;
+    StateChecker stateChecker;
+    QThreadPool pool;
+    // 暂停时只让一个线程进入等待，其余线程阻塞在锁上
+    QMutex stateMutex;
+    std::atomic_bool cancelled { false };
+
+    mutable QMutex mutex;
+    std::vector<std::unique_ptr<DirNode>> nodes;
+    std::atomic_bool failed { false };
+    QByteArray failedPath;
+    int failedErrno { 0 };
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // LOCALDELETEENGINE_H
@@ -5,6 +5,7 @@
 #include "abstractworker.h"
 #include "workerdata.h"
 #include "errormessageandaction.h"
+#include "jobscheduler.h"
 
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/base/schemefactory.h>
@@ -309,6 +310,14 @@ bool AbstractWorker::initArgs()
  */
 void AbstractWorker::endWork()
 {
+    if (!scheduledDevice.isEmpty()) {
+        const bool completed = currentState != AbstractJobHandler::JobState::kStopState;
+        const qint64 bytes = jobType == AbstractJobHandler::JobType::kDeleteType ? 0 : qint64(sourceFilesTotalSize);
+        JobScheduler::instance()->record(scheduledDevice, bytes, queuedTime, timeElapsed.elapsed() - queuedTime, completed);
+        JobScheduler::instance()->release(scheduledDevice);
+        scheduledDevice.clear();
+    }
+
     setStat(AbstractJobHandler::JobState::kStopState);
 
     Q_EMIT removeTaskWidget();
@@ -514,11 +523,43 @@ bool AbstractWorker::doWork()
         endWork();
         return false;
     }
+    // 等待目标磁盘空闲
+    if (!waitForDevice()) {
+        endWork();
+        return false;
+    }
     // 启动统计写入数据大小计时器
     startCountProccess();
 
     return true;
 }
+/*!
+ * \brief AbstractWorker::waitForDevice wait in the worker thread until the disk
+ * the job writes to has a free slot in JobScheduler
+ * \return false if the task is stopped while waiting
+ */
+bool AbstractWorker::waitForDevice()
+{
+    const QString &disk = JobScheduler::deviceOfJob(jobType, sourceUrls, targetUrl);
+    if (disk.isEmpty())
+        return true;
+
+    QElapsedTimer waitTimer;
+    waitTimer.start();
+    const bool acquired = JobScheduler::instance()->acquire(
+            disk, [this] { return isStopped(); },
+            [this] { return currentState == AbstractJobHandler::JobState::kPauseState; });
+    queuedTime = waitTimer.elapsed();
+    if (!acquired) {
+        fmInfo() << "job stopped while waiting for disk" << disk << "waited:" << queuedTime;
+        return false;
+    }
+
+    scheduledDevice = disk;
+    if (queuedTime > 0)
+        fmInfo() << "job got the slot of disk" << disk << "after waiting" << queuedTime << "ms";
+    return true;
+}
 /*!
  * \brief AbstractWorker::stateCheck Blocking waiting for task and check status
  * \return is Correct state
@@ -668,6 +709,8 @@ AbstractWorker::~AbstractWorker()
         delete speedtimer;
         speedtimer = nullptr;
     }
+    if (!scheduledDevice.isEmpty())
+        JobScheduler::instance()->release(scheduledDevice);
 }
 
 /*!
@@ -109,6 +109,7 @@ protected:
     virtual void stop();
     virtual void startCountProccess();
     virtual bool statisticsFilesSize();
+    virtual bool waitForDevice();
     virtual bool stateCheck();
     virtual bool workerWait();
     virtual void setStat(const AbstractJobHandler::JobState &stat);
@@ -185,6 +186,8 @@ public:
     QSharedPointer<DoCopyFileWorker> copyOtherFileWorker { nullptr };
     std::atomic_bool exblockThreadStarted { false };
     QElapsedTimer timeElapsed;
+    QString scheduledDevice;   // disk slot held in JobScheduler
+    qint64 queuedTime { 0 };   // time waited for the disk slot
 
     QWaitCondition waitCondition;
     QMutex mutex;
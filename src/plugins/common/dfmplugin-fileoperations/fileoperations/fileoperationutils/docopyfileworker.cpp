@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "docopyfileworker.h"
+#include "fileoperationsutils.h"
 
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/base/device/deviceutils.h>
@@ -24,6 +25,19 @@
 #include <sys/mman.h>
 
 static const quint32 kMaxBufferLength { 1024 * 1024 * 1 };
+static const size_t kDirectIOAlignment { 4096 };
+static const quint32 kVaultBufferLength { 1024 * 1024 * 4 };
+
+// 保险箱（cryfs）每次写入都要经过一次用户态往返，并按块整体加密，
+// 使用更大的缓冲区可以减少往返次数，并让每次写入覆盖完整的块，避免对块的重复读改写
+static qint64 copyBufferLength(const QUrl &to, qint64 fromSize)
+{
+    const QString &vaultPath = DPFILEOPERATIONS_NAMESPACE::FileOperationsUtils::vaultUnlockPath();
+    qint64 length = kMaxBufferLength;
+    if (!vaultPath.isEmpty() && to.isLocalFile() && to.path().startsWith(vaultPath))
+        length = kVaultBufferLength;
+    return fromSize > length ? length : fromSize;
+}
 
 DPFILEOPERATIONS_USE_NAMESPACE
 USING_IO_NAMESPACE
@@ -239,9 +253,9 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFilePractically(const DFileInfo
     auto toIsSmb = ProtocolUtils::isSMBFile(toInfo->uri());
     if (workData->exBlockSyncEveryWrite || toIsSmb)
         toFd = open(toInfo->uri().path().toUtf8().toStdString().data(), O_RDONLY);
-    qint64 blockSize = fromSize > kMaxBufferLength ? kMaxBufferLength : fromSize;
+    qint64 blockSize = copyBufferLength(toInfo->uri(), fromSize);
     char *data = new char[static_cast<uint>(blockSize + 1)];
-    uLong sourceCheckSum = adler32(0L, nullptr, 0);
+    uLong sourceCheckSum = crc32(0L, nullptr, 0);
     qint64 sizeRead = 0;
 
     do {
@@ -263,7 +277,7 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFilePractically(const DFileInfo
         }
 
         if (Q_LIKELY(workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyIntegrityChecking))) {
-            sourceCheckSum = adler32(sourceCheckSum, reinterpret_cast<Bytef *>(data), static_cast<uInt>(sizeRead));
+            sourceCheckSum = crc32(sourceCheckSum, reinterpret_cast<Bytef *>(data), static_cast<uInt>(sizeRead));
         }
 
         // 执行同步策略
@@ -289,7 +303,7 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFilePractically(const DFileInfo
 
     // 校验文件完整性
     if (skip)
-        *skip = verifyFileIntegrity(blockSize, sourceCheckSum, fromInfo, toInfo, toDevice);
+        *skip = verifyFileIntegrity(sourceCheckSum, fromInfo, toInfo);
     toInfo->refresh();
 
     if (skip && *skip)
@@ -790,47 +804,30 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doWriteFileErrorRetry(const DFileInfo
     return NextDo::kDoCopyReDoCurrentFile;
 }
 
-bool DoCopyFileWorker::verifyFileIntegrity(const qint64 &blockSize, const ulong &sourceCheckSum,
-                                           const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo,
-                                           QSharedPointer<DFMIO::DFile> &toDevice)
+bool DoCopyFileWorker::verifyFileIntegrity(const ulong &sourceCheckSum, const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo)
 {
     if (!workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyIntegrityChecking))
         return true;
-    char *data = new char[static_cast<uint>(blockSize + 1)];
     QElapsedTimer t;
-    ulong targetCheckSum = adler32(0L, nullptr, 0);
-    Q_FOREVER {
-        qint64 size = toDevice->read(data, blockSize);
-
-        if (Q_UNLIKELY(size <= 0)) {
-            if (size == 0 && toInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong() == toDevice->pos()) {
-                break;
-            }
-
-            AbstractJobHandler::SupportAction actionForCheckRead = doHandleErrorAndWait(fromInfo->uri(),
-                                                                                        toInfo->uri(),
-                                                                                        AbstractJobHandler::JobErrorType::kIntegrityCheckingError,
-                                                                                        true,
-                                                                                        toDevice->lastError().errorMsg());
-            if (!isStopped() && AbstractJobHandler::SupportAction::kRetryAction == actionForCheckRead) {
-                continue;
-            } else {
-                checkRetry();
-                return actionForCheckRead == AbstractJobHandler::SupportAction::kSkipAction;
-            }
-        }
-
-        targetCheckSum = adler32(targetCheckSum, reinterpret_cast<Bytef *>(data), static_cast<uInt>(size));
-
-        if (Q_UNLIKELY(!stateCheck())) {
-            delete[] data;
-            data = nullptr;
+    t.start();
+    ulong targetCheckSum = 0;
+    QString errorMsg;
+    while (!readTargetCheckSum(toInfo->uri().path(), &targetCheckSum, &errorMsg)) {
+        if (isStopped())
             return false;
+
+        AbstractJobHandler::SupportAction actionForCheckRead = doHandleErrorAndWait(fromInfo->uri(),
+                                                                                    toInfo->uri(),
+                                                                                    AbstractJobHandler::JobErrorType::kIntegrityCheckingError,
+                                                                                    true,
+                                                                                    errorMsg);
+        if (isStopped() || AbstractJobHandler::SupportAction::kRetryAction != actionForCheckRead) {
+            checkRetry();
+            return actionForCheckRead == AbstractJobHandler::SupportAction::kSkipAction;
         }
     }
-    delete[] data;
 
-    fmDebug("Time spent of integrity check of the file: %d", t.elapsed());
+    fmDebug("Time spent of integrity check of the file: %lld", t.elapsed());
 
     if (sourceCheckSum != targetCheckSum) {
         fmWarning("Failed on file integrity checking, source file: 0x%lx, target file: 0x%lx", sourceCheckSum, targetCheckSum);
@@ -841,6 +838,85 @@ bool DoCopyFileWorker::verifyFileIntegrity(const qint64 &blockSize, const ulong
         return actionForCheck == AbstractJobHandler::SupportAction::kSkipAction;
     }
 
+    if (workData->verifiedCopy)
+        workData->verifiedCheckSums.insert(toInfo->uri(), static_cast<quint32>(targetCheckSum));
+    return true;
+}
+
+/*!
+ * \brief DoCopyFileWorker::readTargetCheckSum 从磁盘读回目标文件并计算 crc32
+ * 使用 O_DIRECT 绕过页缓存，否则读到的只是刚写入的缓存，无法发现介质上的错误；
+ * 文件系统不支持 O_DIRECT 时，同步后丢弃该文件的缓存再读取
+ * \return false if reading failed or the job is stopped
+ */
+bool DoCopyFileWorker::readTargetCheckSum(const QString &path, ulong *checkSum, QString *errorMsg)
+{
+    Q_ASSERT(checkSum && errorMsg);
+    const QByteArray &localPath = path.toUtf8();
+    auto openTarget = [&localPath](bool direct) {
+        int fd = open(localPath.constData(), direct ? O_RDONLY | O_DIRECT : O_RDONLY);
+        if (fd >= 0 && !direct) {
+            fdatasync(fd);
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        }
+        return fd;
+    };
+
+    bool direct = true;
+    int fd = openTarget(direct);
+    if (fd < 0 && errno == EINVAL) {
+        direct = false;
+        fd = openTarget(direct);
+    }
+    if (fd < 0) {
+        *errorMsg = strerror(errno);
+        return false;
+    }
+    FinallyUtil releaseFd([&] {
+        if (fd >= 0)
+            close(fd);
+    });
+
+    void *buffer = nullptr;
+    if (posix_memalign(&buffer, kDirectIOAlignment, kMaxBufferLength) != 0) {
+        *errorMsg = strerror(ENOMEM);
+        return false;
+    }
+    FinallyUtil releaseBuffer([&] {
+        free(buffer);
+    });
+
+    ulong sum = crc32(0L, nullptr, 0);
+    qint64 offset = 0;
+    Q_FOREVER {
+        ssize_t size = read(fd, buffer, kMaxBufferLength);
+        if (size < 0 && errno == EINTR)
+            continue;
+        // some file systems accept O_DIRECT on open but refuse it on read
+        if (size < 0 && errno == EINVAL && direct && offset == 0) {
+            close(fd);
+            direct = false;
+            fd = openTarget(direct);
+            if (fd < 0) {
+                *errorMsg = strerror(errno);
+                return false;
+            }
+            continue;
+        }
+        if (size < 0) {
+            *errorMsg = strerror(errno);
+            return false;
+        }
+        if (size == 0)
+            break;
+
+        sum = crc32(sum, static_cast<const Bytef *>(buffer), static_cast<uInt>(size));
+        offset += size;
+        if (Q_UNLIKELY(!stateCheck()))
+            return false;
+    }
+
+    *checkSum = sum;
     return true;
 }
 
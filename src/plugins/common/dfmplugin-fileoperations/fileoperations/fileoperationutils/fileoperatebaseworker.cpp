@@ -785,6 +785,9 @@ void FileOperateBaseWorker::initCopyWay()
         workData->signalThread = (sourceFilesCount > 1 || sourceFilesTotalSize > FileOperationsUtils::bigFileSize()) && FileUtils::getCpuProcessCount() > 4
                 ? false
                 : true;
+        // 多线程拷贝使用 dfmio 拷贝，无法在拷贝时计算校验值
+        if (workData->verifiedCopy)
+            workData->signalThread = true;
         if (!workData->signalThread)
             threadCount = FileUtils::getCpuProcessCount() >= 8 ? FileUtils::getCpuProcessCount() : 8;
     }
@@ -919,8 +922,10 @@ bool FileOperateBaseWorker::doCopyOtherFile(const DFileInfoPointer fromInfo, con
     initSignalCopyWorker();
     const QString &targetUrl = toInfo->uri().toString();
 
+    // 校验拷贝只能使用读写拷贝，在数据流经时计算源文件的校验值
+    const bool verified = workData->verifiedCopy;
     bool ok { false };
-    if (workData->copyFileRange) {
+    if (workData->copyFileRange && !verified) {
         ok = doCopyLocalByRange(fromInfo, toInfo, skip);
         return ok;
     }
@@ -928,7 +933,7 @@ bool FileOperateBaseWorker::doCopyOtherFile(const DFileInfoPointer fromInfo, con
     FileUtils::cacheCopyingFileUrl(targetUrl);
     const auto fromSize = fromInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong();
     DoCopyFileWorker::NextDo nextDo { DoCopyFileWorker::NextDo::kDoCopyNext };
-    if (fromSize > bigFileSize || !supportDfmioCopy || workData->exBlockSyncEveryWrite) {
+    if (verified || fromSize > bigFileSize || !supportDfmioCopy || workData->exBlockSyncEveryWrite) {
         do {
             nextDo = copyOtherFileWorker->doCopyFilePractically(fromInfo, toInfo, skip);
         } while (nextDo == DoCopyFileWorker::NextDo::kDoCopyReDoCurrentFile && !isStopped());
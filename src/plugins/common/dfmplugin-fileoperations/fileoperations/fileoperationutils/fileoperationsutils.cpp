@@ -7,6 +7,8 @@
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/base/configs/dconfig/dconfigmanager.h>
 
+#include <dfm-framework/dpf.h>
+
 #include <QDirIterator>
 #include <QUrl>
 #include <QDebug>
@@ -32,7 +34,10 @@ inline constexpr char kFileOperations[] { "org.deepin.dde.file-manager.operation
 inline constexpr char kFileBigSize[] { "file.operation.bigfilesize" };
 inline constexpr char kBlockEverySync[] { "file.operation.blockeverysync" };
 inline constexpr char kBroadcastPaste[] { "file.operation.broadcastpastevent" };
+inline constexpr char kVerifiedCopy[] { "file.operation.verifiedcopy" };
 QMutex FileOperationsUtils::mutex;
+QString FileOperationsUtils::unlockedVaultPath;
+QMutex FileOperationsUtils::vaultPathMutex;
 
 /*!
  * \brief FileOperationsUtils::statisticsFilesSize 使用c库统计文件大小
@@ -169,6 +174,11 @@ bool FileOperationsUtils::blockSync()
     return sync;
 }
 
+bool FileOperationsUtils::verifiedCopy()
+{
+    return DConfigManager::instance()->value(kFileOperations, kVerifiedCopy, false).toBool();
+}
+
 QUrl FileOperationsUtils::parentUrl(const QUrl &url)
 {
     auto parent = url.adjusted(QUrl::StripTrailingSlash);
@@ -185,3 +195,23 @@ bool FileOperationsUtils::canBroadcastPaste()
     // 组策略中配置
     return DConfigManager::instance()->value(kFileOperations, kBroadcastPaste, false).toBool();
 }
+
+QString FileOperationsUtils::vaultUnlockPath()
+{
+    QMutexLocker lk(&vaultPathMutex);
+    return unlockedVaultPath;
+}
+
+/*!
+ * \brief FileOperationsUtils::updateVaultUnlockPath 从保险箱插件获取解锁目录并缓存
+ * 拷贝线程中不能直接调用插件的槽函数，需在主线程所有插件启动后调用一次
+ */
+void FileOperationsUtils::updateVaultUnlockPath()
+{
+    QString path = dpfSlotChannel->push("dfmplugin_vault", "slot_Vault_UnlockPath").toString();
+    if (!path.isEmpty() && !path.endsWith('/'))
+        path.append('/');
+
+    QMutexLocker lk(&vaultPathMutex);
+    unlockedVaultPath = path;
+}
@@ -68,6 +68,11 @@ class FileOperationsUtils
     friend class FileOperateBaseWorker;
     friend class ErrorMessageAndAction;
 
+public:
+    // 保险箱解锁目录由保险箱插件提供，未加载保险箱插件时为空
+    static QString vaultUnlockPath();
+    static void updateVaultUnlockPath();
+
 private:
     static SizeInfoPointer statisticsFilesSize(const QList<QUrl> &files, const bool &isRecordUrl = false);
     static bool isFilesSizeOutLimit(const QUrl &url, const qint64 limitSize);
@@ -76,12 +81,15 @@ private:
     static bool isFileOnDisk(const QUrl &url);
     static qint64 bigFileSize();
     static bool blockSync();
+    static bool verifiedCopy();
     static QUrl parentUrl(const QUrl &url);
     static bool canBroadcastPaste();
 
 private:
     static QSet<QString> fileNameUsing;
     static QMutex mutex;
+    static QString unlockedVaultPath;
+    static QMutex vaultPathMutex;
 };
 DPFILEOPERATIONS_END_NAMESPACE
 
@@ -0,0 +1,249 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "jobscheduler.h"
+
+#include <dfm-base/utils/fileutils.h>
+#include <dfm-base/base/configs/dconfig/dconfigmanager.h>
+
+#include <dfm-io/dfmio_utils.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDBusConnection>
+#include <QDBusError>
+
+#include <limits>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+DFMBASE_USE_NAMESPACE
+
+inline constexpr char kFileOperations[] { "org.deepin.dde.file-manager.operations" };
+inline constexpr char kJobsPerDevice[] { "file.operation.jobsperdevice" };
+inline constexpr char kSchedulerObjPath[] { "/org/deepin/Filemanager/FileOperations/Scheduler" };
+
+// 排队的任务定时检查自己是否已被取消
+static constexpr int kStopCheckIntervalMs { 200 };
+
+static const std::array<qint64, 5> kThroughputBounds { 1, 4, 16, 64, 256 };   // MiB/s
+static const std::array<qint64, 5> kLatencyBounds { 10, 100, 1000, 10000, 60000 };   // ms
+
+JobScheduler *JobScheduler::instance()
+{
+    static JobScheduler ins;
+    return &ins;
+}
+
+JobScheduler::JobScheduler(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void JobScheduler::registerDBus()
+{
+    // 文件管理器和桌面进程都会加载此插件，只注册对象不注册服务名，通过各自的连接名访问
+    QDBusConnection conn = QDBusConnection::sessionBus();
+    if (!conn.registerObject(kSchedulerObjPath, this, QDBusConnection::ExportScriptableSlots))
+        fmWarning() << "cannot register the job scheduler to D-Bus:" << conn.lastError().message();
+}
+
+/*!
+ * \brief JobScheduler::deviceOfJob
+ * \return the disk which the job mainly writes to, or empty if the job is not scheduled.
+ * A cut job inside one file system only renames files, so it is not scheduled.
+ */
+QString JobScheduler::deviceOfJob(AbstractJobHandler::JobType type, const QList<QUrl> &sources, const QUrl &target)
+{
+    QUrl url;
+    switch (type) {
+    case AbstractJobHandler::JobType::kCopyType:
+        url = target;
+        break;
+    case AbstractJobHandler::JobType::kCutType:
+        if (!sources.isEmpty() && FileUtils::isSameDevice(sources.first(), target))
+            return {};
+        url = target;
+        break;
+    case AbstractJobHandler::JobType::kDeleteType:
+        if (!sources.isEmpty())
+            url = sources.first();
+        break;
+    default:
+        return {};
+    }
+
+    if (!url.isValid() || !url.isLocalFile())
+        return {};
+
+    const QString &device = DFMIO::DFMUtils::deviceNameFromUrl(url);
+    if (!device.startsWith("/dev/"))
+        return {};
+    return diskOf(device);
+}
+
+/*!
+ * \brief JobScheduler::diskOf
+ * \return the name of the whole disk of a block device, the partitions of the
+ * same disk share one schedule.
+ */
+QString JobScheduler::diskOf(const QString &device)
+{
+    QString name = QFileInfo(device).canonicalFilePath();
+    if (name.isEmpty())
+        name = device;
+    name = QFileInfo(name).fileName();
+
+    const QString sysPath = QString("/sys/class/block/") + name;
+    if (!QFile::exists(sysPath + "/partition"))
+        return name;
+    // /sys/class/block/sdb1 -> /sys/devices/.../block/sdb/sdb1
+    return QFileInfo(QFileInfo(sysPath).canonicalFilePath()).dir().dirName();
+}
+
+/*!
+ * \brief JobScheduler::acquire blocks the worker thread until the job can run on the disk.
+ * A job paused while queued keeps its place but does not take a slot, the jobs
+ * queued after it go first until it is resumed.
+ * \return false if the job is stopped while waiting.
+ */
+bool JobScheduler::acquire(const QString &disk, const std::function<bool()> &isStopped,
+                           const std::function<bool()> &isPaused)
+{
+    QMutexLocker locker(&mutex);
+    quint64 ticket = 0;
+    {
+        DiskState &state = disks[disk];
+        if (state.limit <= 0)
+            state.limit = limitOf(disk);
+        ticket = state.nextTicket++;
+        state.waiting.append(ticket);
+    }
+
+    bool logged = false;
+    forever {
+        // the hash may be rehashed while waiting, look up the state again
+        DiskState &state = disks[disk];
+        if (isStopped && isStopped()) {
+            state.waiting.removeOne(ticket);
+            state.paused.remove(ticket);
+            slotReleased.wakeAll();
+            return false;
+        }
+
+        const bool pausedNow = isPaused && isPaused();
+        if (pausedNow != state.paused.contains(ticket)) {
+            if (pausedNow)
+                state.paused.insert(ticket);
+            else
+                state.paused.remove(ticket);
+            slotReleased.wakeAll();   // the order of the queue is changed
+        }
+
+        if (!pausedNow && state.running < state.limit && firstRunnable(state) == ticket) {
+            state.waiting.removeOne(ticket);
+            ++state.running;
+            slotReleased.wakeAll();   // the next one may also be allowed
+            return true;
+        }
+
+        if (!logged) {
+            logged = true;
+            fmInfo() << "job is queued on disk" << disk << "running:" << state.running << "limit:" << state.limit;
+        }
+        slotReleased.wait(&mutex, kStopCheckIntervalMs);
+    }
+}
+
+quint64 JobScheduler::firstRunnable(const DiskState &state)
+{
+    for (quint64 ticket : state.waiting) {
+        if (!state.paused.contains(ticket))
+            return ticket;
+    }
+    return std::numeric_limits<quint64>::max();
+}
+
+void JobScheduler::release(const QString &disk)
+{
+    QMutexLocker locker(&mutex);
+    auto iter = disks.find(disk);
+    if (iter == disks.end() || iter->running <= 0)
+        return;
+    --iter->running;
+    slotReleased.wakeAll();
+}
+
+void JobScheduler::record(const QString &disk, qint64 bytes, qint64 waitMs, qint64 runMs, bool completed)
+{
+    QMutexLocker locker(&mutex);
+    DiskState &state = disks[disk];
+    state.waitTime.add(waitMs, kLatencyBounds);
+    if (!completed) {
+        ++state.stoppedJobs;
+        return;
+    }
+
+    ++state.finishedJobs;
+    state.runTime.add(runMs, kLatencyBounds);
+    if (bytes > 0 && runMs > 0)
+        state.throughput.add(bytes * 1000 / runMs / 1024 / 1024, kThroughputBounds);
+}
+
+QVariantMap JobScheduler::Statistics()
+{
+    QMutexLocker locker(&mutex);
+    QVariantMap result;
+    for (auto iter = disks.cbegin(); iter != disks.cend(); ++iter) {
+        const DiskState &state = iter.value();
+        result.insert(iter.key(), QVariantMap { { "limit", state.limit },
+                                                { "running", state.running },
+                                                { "queued", state.waiting.count() },
+                                                { "paused", state.paused.count() },
+                                                { "finished", state.finishedJobs },
+                                                { "stopped", state.stoppedJobs },
+                                                { "throughput", state.throughput.toMap(kThroughputBounds, "MiB/s") },
+                                                { "waitTime", state.waitTime.toMap(kLatencyBounds, "ms") },
+                                                { "runTime", state.runTime.toMap(kLatencyBounds, "ms") } });
+    }
+    return result;
+}
+
+/*!
+ * \brief JobScheduler::limitOf
+ * 0 in config means automatic: removable and rotational disks run one job at a
+ * time, since concurrent writes make them seek back and forth.
+ */
+int JobScheduler::limitOf(const QString &disk)
+{
+    int limit = DConfigManager::instance()->value(kFileOperations, kJobsPerDevice, 0).toInt();
+    if (limit > 0)
+        return limit;
+
+    auto readFlag = [&disk](const QString &file) {
+        QFile flag(QString("/sys/class/block/%1/%2").arg(disk, file));
+        return flag.open(QIODevice::ReadOnly) && flag.readAll().trimmed() == "1";
+    };
+    return (readFlag("removable") || readFlag("queue/rotational")) ? 1 : 2;
+}
+
+void JobScheduler::Histogram::add(qint64 value, const Bounds &bounds)
+{
+    size_t i = 0;
+    while (i < bounds.size() && value >= bounds[i])
+        ++i;
+    ++counts[i];
+}
+
+QVariantMap JobScheduler::Histogram::toMap(const Bounds &bounds, const QString &unit) const
+{
+    QVariantMap map;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        const QString &key = i < bounds.size()
+                ? QString("<%1%2").arg(bounds[i]).arg(unit)
+                : QString(">=%1%2").arg(bounds.back()).arg(unit);
+        map.insert(key, counts[i]);
+    }
+    return map;
+}
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef JOBSCHEDULER_H
+#define JOBSCHEDULER_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <dfm-base/interfaces/abstractjobhandler.h>
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVariantMap>
+
+#include <array>
+#include <functional>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/*!
+ * \brief The JobScheduler class limits how many copy, cut and delete jobs run
+ * on the same disk at once, the others wait in order in their worker threads.
+ * The limit applies per process, the file manager and the desktop schedule
+ * their own jobs separately.
+ *
+ * It also keeps the throughput and latency histograms of finished jobs per
+ * disk, which can be queried over D-Bus.
+ */
+class JobScheduler : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.deepin.Filemanager.FileOperations.Scheduler")
+    Q_DISABLE_COPY(JobScheduler)
+
+public:
+    static JobScheduler *instance();
+    void registerDBus();
+
+    static QString deviceOfJob(DFMBASE_NAMESPACE::AbstractJobHandler::JobType type,
+                               const QList<QUrl> &sources, const QUrl &target);
+    static QString diskOf(const QString &device);
+
+    bool acquire(const QString &disk, const std::function<bool()> &isStopped,
+                 const std::function<bool()> &isPaused = nullptr);
+    void release(const QString &disk);
+    void record(const QString &disk, qint64 bytes, qint64 waitMs, qint64 runMs, bool completed);
+
+public Q_SLOTS:
+    Q_SCRIPTABLE QVariantMap Statistics();
+
+private:
+    explicit JobScheduler(QObject *parent = nullptr);
+    static int limitOf(const QString &disk);
+
+    using Bounds = std::array<qint64, 5>;
+    // bucket i counts the values below bounds[i], the last one counts the rest
+    struct Histogram
+    {
+        std::array<qint64, 6> counts {};
+        void add(qint64 value, const Bounds &bounds);
+        QVariantMap toMap(const Bounds &bounds, const QString &unit) const;
+    };
+
+    struct DiskState
+    {
+        int limit { 0 };
+        int running { 0 };
+        quint64 nextTicket { 0 };
+        QList<quint64> waiting;   // tickets in arrival order
+        QSet<quint64> paused;   // queued tickets whose jobs are paused, later ones may pass them
+        qint64 finishedJobs { 0 };
+        qint64 stoppedJobs { 0 };
+        Histogram throughput;   // MiB/s
+        Histogram waitTime;   // ms
+        Histogram runTime;   // ms
+    };
+    static quint64 firstRunnable(const DiskState &state);
+
+    QMutex mutex;
+    QWaitCondition slotReleased;
+    QHash<QString, DiskState> disks;
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // JOBSCHEDULER_H
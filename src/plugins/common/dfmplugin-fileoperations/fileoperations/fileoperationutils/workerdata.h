@@ -66,6 +66,8 @@ public:
     QAtomicInteger<qint64> completeFileCount { 0 };   // copy complete file count
     std::atomic_bool signalThread { true };
     DThreadMap<QUrl, qint64> everyFileWriteSize;
+    bool verifiedCopy { false };   // file.operation.verifiedcopy, copies through the read/write loop only
+    DThreadMap<QUrl, quint32> verifiedCheckSums;   // crc32 of the target files verified by a verified copy
     DThreadList<QSharedPointer<DPFILEOPERATIONS_NAMESPACE::WorkerData::BlockFileCopyInfo>> blockCopyInfoQueue;
 };
 DPFILEOPERATIONS_END_NAMESPACE
@@ -7,6 +7,7 @@
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/base/standardpaths.h>
 #include <dfm-base/utils/universalutils.h>
+#include <dfm-base/utils/trashindex.h>
 #include <dfm-base/base/device/deviceutils.h>
 
 #include <dfm-io/dfmio_utils.h>
@@ -21,6 +22,9 @@
 #include <unistd.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <string.h>
+
+static constexpr int kLocalTrashBatchSize = 512;
 
 USING_IO_NAMESPACE
 DPFILEOPERATIONS_USE_NAMESPACE
@@ -45,6 +49,7 @@ bool DoMoveToTrashFilesWorker::doWork()
         return false;
 
     doMoveToTrash();
+    TrashIndex::instance()->sync();
 
     endWork();
 
@@ -74,6 +79,10 @@ bool DoMoveToTrashFilesWorker::doMoveToTrash()
     bool result = false;
     DFMBASE_NAMESPACE::LocalFileHandler fileHandler;
     static QString homeTrashFileDir = dfmbase::StandardPaths::location(StandardPaths::StandardLocation::kTrashLocalFilesPath);
+    static QString homeTrashInfoDir = dfmbase::StandardPaths::location(StandardPaths::StandardLocation::kTrashLocalInfoPath);
+    // 与家目录回收站同设备的文件批量 rename，其余文件逐个走 gio
+    localEngine.reset(new LocalTrashEngine(homeTrashFileDir, homeTrashInfoDir));
+
     // 总大小使用源文件个数
     for (const auto &url : sourceUrls) {
         QUrl urlSource = url;
@@ -105,57 +114,132 @@ bool DoMoveToTrashFilesWorker::doMoveToTrash()
             return false;
         }
 
-        const auto &fileInfo = InfoFactory::create<FileInfo>(urlSource, Global::CreateFileInfoType::kCreateFileInfoSync);
-        if (!fileInfo) {
-            // pause and emit error msg
-            if (AbstractJobHandler::SupportAction::kSkipAction != doHandleErrorAndWait(urlSource, targetUrl, AbstractJobHandler::JobErrorType::kProrogramError)) {
+        if (localEngine->canTrash(urlSource)) {
+            localBatch.append({ url, urlSource });
+            if (localBatch.size() >= kLocalTrashBatchSize && !flushLocalBatch(&fileHandler))
                 return false;
-            } else {
-                completeFilesCount++;
-                continue;
-            }
+            continue;
         }
 
-        emitCurrentTaskNotify(urlSource, targetUrl);
+        if (!trashFileByHandler(url, urlSource, &fileHandler))
+            return false;
+    }
 
-        AbstractJobHandler::SupportAction action = AbstractJobHandler::SupportAction::kNoAction;
-        do {
-            action = AbstractJobHandler::SupportAction::kNoAction;
-            QString trashTime = fileHandler.trashFile(urlSource);
-            if (!trashTime.isEmpty()) {
-                QUrl trashUrl = urlSource;
-                trashUrl.setUserInfo(trashTime);
+    return flushLocalBatch(&fileHandler);
+}
 
-                completeTargetFiles.append(trashUrl);
-                emitProgressChangedNotify(completeFilesCount);
-                completeSourceFiles.append(urlSource);
-                auto targetTash = trashTargetUrl(trashUrl);
-                if (targetTash.isValid())
-                    emit fileRenamed(urlSource, targetTash);
-                continue;
-            } else {
-                // pause and emit error msg
-                auto errmsg = QString("Unknown error");
-                if (fileHandler.errorCode() == DFMIOErrorCode::DFM_IO_ERROR_NOT_SUPPORTED) {
-                    errmsg = QString("The file can't be put into trash, you can use \"Shift+Del\" to delete the file completely.");
-                } else if (fileHandler.errorCode() != DFMIOErrorCode::DFM_IO_ERROR_NONE) {
-                    errmsg = fileHandler.errorString();
-                }
-                action = doHandleErrorAndWait(url, QUrl(),
-                                              AbstractJobHandler::JobErrorType::kFileMoveToTrashError, false,
-                                              fileHandler.errorCode() == DFMIOErrorCode::DFM_IO_ERROR_NONE ? "Unknown error"
-                                                                                                           : fileHandler.errorString());
+/*!
+ * \brief DoMoveToTrashFilesWorker::trashFileByHandler move one file to trash by gio
+ * \return false if the job should abort
+ */
+bool DoMoveToTrashFilesWorker::trashFileByHandler(const QUrl &url, const QUrl &urlSource, LocalFileHandler *fileHandler)
+{
+    const auto &fileInfo = InfoFactory::create<FileInfo>(urlSource, Global::CreateFileInfoType::kCreateFileInfoSync);
+    if (!fileInfo) {
+        // pause and emit error msg
+        if (AbstractJobHandler::SupportAction::kSkipAction != doHandleErrorAndWait(urlSource, targetUrl, AbstractJobHandler::JobErrorType::kProrogramError)) {
+            return false;
+        } else {
+            completeFilesCount++;
+            return true;
+        }
+    }
+
+    emitCurrentTaskNotify(urlSource, targetUrl);
+
+    AbstractJobHandler::SupportAction action = AbstractJobHandler::SupportAction::kNoAction;
+    do {
+        action = AbstractJobHandler::SupportAction::kNoAction;
+        QString trashTime = fileHandler->trashFile(urlSource);
+        if (!trashTime.isEmpty()) {
+            QUrl trashUrl = urlSource;
+            trashUrl.setUserInfo(trashTime);
+
+            completeTargetFiles.append(trashUrl);
+            emitProgressChangedNotify(completeFilesCount);
+            completeSourceFiles.append(urlSource);
+            auto targetTash = trashTargetUrl(trashUrl);
+            if (targetTash.isValid())
+                emit fileRenamed(urlSource, targetTash);
+            return true;
+        } else {
+            // pause and emit error msg
+            auto errmsg = QString("Unknown error");
+            if (fileHandler->errorCode() == DFMIOErrorCode::DFM_IO_ERROR_NOT_SUPPORTED) {
+                errmsg = QString("The file can't be put into trash, you can use \"Shift+Del\" to delete the file completely.");
+            } else if (fileHandler->errorCode() != DFMIOErrorCode::DFM_IO_ERROR_NONE) {
+                errmsg = fileHandler->errorString();
             }
-        } while (action == AbstractJobHandler::SupportAction::kRetryAction && !isStopped());
+            action = doHandleErrorAndWait(url, QUrl(),
+                                          AbstractJobHandler::JobErrorType::kFileMoveToTrashError, false,
+                                          fileHandler->errorCode() == DFMIOErrorCode::DFM_IO_ERROR_NONE ? "Unknown error"
+                                                                                                        : fileHandler->errorString());
+        }
+    } while (action == AbstractJobHandler::SupportAction::kRetryAction && !isStopped());
 
-        if (action == AbstractJobHandler::SupportAction::kNoAction
-            || action == AbstractJobHandler::SupportAction::kSkipAction) {
-            completeFilesCount++;
+    if (action == AbstractJobHandler::SupportAction::kNoAction
+        || action == AbstractJobHandler::SupportAction::kSkipAction) {
+        completeFilesCount++;
+        return true;
+    }
+
+    return false;
+}
+
+/*!
+ * \brief DoMoveToTrashFilesWorker::flushLocalBatch rename the pending same device files into
+ * home trash at once, and report progress once for the whole batch. Files that failed in the
+ * fast path are retried one by one by gio, which also reports the error to the user.
+ * \return false if the job should abort
+ */
+bool DoMoveToTrashFilesWorker::flushLocalBatch(LocalFileHandler *fileHandler)
+{
+    if (localBatch.isEmpty())
+        return true;
+
+    const auto pending = localBatch;
+    localBatch.clear();
+
+    QList<LocalTrashEngine::Item> items;
+    items.reserve(pending.size());
+    for (const auto &pair : pending)
+        items.append({ pair.second, QUrl(), 0 });
+
+    emitCurrentTaskNotify(items.first().source, targetUrl);
+    const QString &trashTime = localEngine->trashBatch(&items);
+
+    QList<int> failed;
+    for (int i = 0; i < items.size(); ++i) {
+        const auto &item = items.at(i);
+        if (item.error != 0) {
+            fmDebug() << "fast trash failed, fallback to gio:" << item.source << strerror(item.error);
+            failed.append(i);
             continue;
         }
 
-        return false;
+        TrashIndex::Entry entry;
+        entry.trashDir = TrashIndex::homeTrashDir();
+        entry.name = item.trashUrl.path().mid(1);
+        entry.originalPath = item.source.path();
+        entry.deletionTime = trashTime.section('-', 0, 0).toLongLong();
+        TrashIndex::instance()->addEntry(entry);
+
+        QUrl trashUrl = item.source;
+        trashUrl.setUserInfo(trashTime);
+        completeTargetFiles.append(trashUrl);
+        completeSourceFiles.append(item.source);
+        completeFilesCount++;
+        emit fileRenamed(item.source, item.trashUrl);
+    }
+    emitProgressChangedNotify(completeFilesCount);
+
+    for (int i : failed) {
+        if (!stateCheck())
+            return false;
+        if (!trashFileByHandler(pending.at(i).first, pending.at(i).second, fileHandler))
+            return false;
     }
+
     return true;
 }
 
@@ -207,10 +291,15 @@ QUrl DoMoveToTrashFilesWorker::trashTargetUrl(const QUrl &url)
     if (isStopped())
         return QUrl();
 
+    fileUrl.setUserInfo("");
+    const auto &indexed = TrashIndex::instance()->findTrashUrls(fileUrl.path(), deleteInfo.first().toLongLong(),
+                                                                deleteInfo.at(1).toLongLong());
+    if (!indexed.isEmpty())
+        return indexed.first();
+
     QSharedPointer<TrashHelper::DeleteTimeInfo> info(new TrashHelper::DeleteTimeInfo);
     info->startTime = deleteInfo.first().toInt();
     info->endTime = deleteInfo.at(1).toInt();
-    fileUrl.setUserInfo("");
     targetUrls.insert(fileUrl, info);
 
     QString errorMsg;
@@ -7,6 +7,7 @@
 
 #include "dfmplugin_fileoperations_global.h"
 #include "fileoperations/fileoperationutils/fileoperatebaseworker.h"
+#include "localtrashengine.h"
 
 #include <dfm-base/interfaces/abstractjobhandler.h>
 #include <dfm-base/interfaces/fileinfo.h>
@@ -37,6 +38,8 @@ protected:
     bool doMoveToTrash();
     bool isCanMoveToTrash(const QUrl &url, bool *result);
     QUrl trashTargetUrl(const QUrl &url);
+    bool trashFileByHandler(const QUrl &url, const QUrl &urlSource, DFMBASE_NAMESPACE::LocalFileHandler *fileHandler);
+    bool flushLocalBatch(DFMBASE_NAMESPACE::LocalFileHandler *fileHandler);
 
 private:
     FileInfoPointer targetFileInfo { nullptr };   // target file information
@@ -45,6 +48,8 @@ private:
     QString trashLocalDir;   // the trash file locak dir
     QSharedPointer<StorageInfo> trashStorageInfo { nullptr };   // target file's device infor
     QMap<QString, QString> fstabMap;
+    QScopedPointer<LocalTrashEngine> localEngine;   // same device fast path into home trash
+    QList<QPair<QUrl, QUrl>> localBatch;   // (original url, source url)
 };
 DPFILEOPERATIONS_END_NAMESPACE
 
@@ -8,12 +8,14 @@
 #include <dfm-base/base/standardpaths.h>
 #include <dfm-base/base/urlroute.h>
 #include <dfm-base/utils/universalutils.h>
+#include <dfm-base/utils/trashindex.h>
 
 #include <dfm-io/dfmio_utils.h>
 #include <dfm-io/denumerator.h>
 #include <dfm-io/trashhelper.h>
 
 #include <QUrl>
+#include <QSet>
 #include <QDebug>
 #include <QMutex>
 #include <QSettings>
@@ -37,8 +39,21 @@ bool DoRestoreTrashFilesWorker::doWork()
     if (!AbstractWorker::doWork())
         return false;
 
-    if (translateUrls())
-        doRestoreTrashFiles();
+    const bool restoreAll = !allFilesList.isEmpty();
+    if (translateUrls() && doRestoreTrashFiles() && restoreAll) {
+        // 与清空回收站一致，索引未覆盖的项（如其他程序移入回收站的文件）由 gio 枚举兜底
+        QSet<QUrl> handled;
+        for (const auto &url : allFilesList)
+            handled.insert(FileUtils::bindUrlTransform(url));
+        const auto &leftover = enumerateTrashFiles(handled);
+        if (!leftover.isEmpty()) {
+            fmInfo() << "restore" << leftover.size() << "trash files missing from trash index";
+            allFilesList = leftover;
+            sourceFilesCount += leftover.size();
+            doRestoreTrashFiles();
+        }
+    }
+    TrashIndex::instance()->sync();
     // 完成
     endWork();
 
@@ -56,9 +71,12 @@ bool DoRestoreTrashFilesWorker::statisticsFilesSize()
     if (sourceUrls.size() == 1) {
         const QUrl &urlSource = sourceUrls[0];
         if (UniversalUtils::urlEquals(urlSource, FileUtils::trashRootUrl())) {
-            DFMIO::DEnumerator enumerator(urlSource);
-            while (enumerator.hasNext())
-                allFilesList.append(enumerator.next());
+            const auto &entries = TrashIndex::instance()->entries();
+            for (const auto &entry : entries)
+                allFilesList.append(entry.trashUrl());
+            // 索引为空时仍按 gio 枚举，避免索引缺失导致无法还原
+            if (allFilesList.isEmpty())
+                allFilesList = enumerateTrashFiles({});
             sourceFilesCount = allFilesList.size();
         }
     }
@@ -113,6 +131,23 @@ bool DoRestoreTrashFilesWorker::translateUrls()
     if (targetUrls.size() < 0)
         return false;
 
+    // 优先从回收站索引中按原路径查找，找不到的再交给 TrashHelper 遍历回收站
+    QList<QUrl> indexedUrls;
+    for (auto it = targetUrls.begin(); it != targetUrls.end();) {
+        const auto &found = TrashIndex::instance()->findTrashUrls(it.key().path(), it.value()->startTime, it.value()->endTime);
+        if (found.isEmpty()) {
+            ++it;
+            continue;
+        }
+        indexedUrls.append(found);
+        it = targetUrls.erase(it);
+    }
+
+    if (!indexedUrls.isEmpty() && targetUrls.isEmpty()) {
+        sourceUrls = indexedUrls;
+        return true;
+    }
+
     QString errorMsg;
 
     AbstractJobHandler::SupportAction action = AbstractJobHandler::SupportAction::kNoAction;
@@ -122,6 +157,7 @@ bool DoRestoreTrashFilesWorker::translateUrls()
         action = AbstractJobHandler::SupportAction::kNoAction;
         if (!trashHelper.getTrashUrls(&sourceUrls, &errorMsg))
             return false;
+        sourceUrls.append(indexedUrls);
         if (sourceUrls.length() <= 0)
             action = doHandleErrorAndWait(targetUrls.keys().length() > 0 ? targetUrls.keys().first() : FileUtils::trashRootUrl(), QUrl(),
                                           AbstractJobHandler::JobErrorType::kFailedObtainTrashOriginalFile, false, errorMsg);
@@ -199,6 +235,7 @@ bool DoRestoreTrashFilesWorker::doRestoreTrashFiles()
             }
             if (!completeTargetFiles.contains(restoreInfo->uri()))
                 completeTargetFiles.append(restoreInfo->uri());
+            TrashIndex::instance()->removeEntry(url);
             emit fileRenamed(fileUrl, newTargetInfo->uri());
         } else {
             auto errorCode = fileHandler.errorCode();
@@ -224,6 +261,23 @@ bool DoRestoreTrashFilesWorker::doRestoreTrashFiles()
     return true;
 }
 
+/*!
+ * \brief DoRestoreTrashFilesWorker::enumerateTrashFiles List the trash root with gio
+ * \param excluded urls that are already handled
+ * \return top level trash files not in excluded
+ */
+QList<QUrl> DoRestoreTrashFilesWorker::enumerateTrashFiles(const QSet<QUrl> &excluded)
+{
+    QList<QUrl> result;
+    DFMIO::DEnumerator enumerator(FileUtils::trashRootUrl());
+    while (enumerator.hasNext()) {
+        const QUrl &url = enumerator.next();
+        if (!excluded.contains(FileUtils::bindUrlTransform(url)))
+            result.append(url);
+    }
+    return result;
+}
+
 DFileInfoPointer DoRestoreTrashFilesWorker::createParentDir(const QUrl &fromUrl,
                                                             const DFileInfoPointer &restoreInfo,
                                                             bool *result)
@@ -14,6 +14,7 @@
 #include <dfm-io/dfile.h>
 
 #include <QObject>
+#include <QSet>
 
 class QStorageInfo;
 USING_IO_NAMESPACE
@@ -42,6 +43,7 @@ protected:
     DFileInfoPointer checkRestoreInfo(const QUrl &url);
 
 private:
+    QList<QUrl> enumerateTrashFiles(const QSet<QUrl> &excluded);
     bool mergeDir(const QUrl &urlSource, const QUrl &urlTarget, dfmio::DFile::CopyFlag flag);
 
 private:
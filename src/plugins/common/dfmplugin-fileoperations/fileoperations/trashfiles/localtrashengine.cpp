@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "localtrashengine.h"
+
+#include <dfm-base/dfm_global_defines.h>
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <QtConcurrent>
+
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static constexpr int kMaxTrashThreads = 8;
+static constexpr int kMaxNameAttempts = 10000;
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+static int renameNoReplace(const char *from, int toDir, const char *to)
+{
+#ifdef RENAME_NOREPLACE
+    // 文件系统不支持 RENAME_NOREPLACE 时返回 EINVAL，由调用方回退到 gio，
+    // 不能退化为 renameat，否则会覆盖回收站中的同名项
+    return ::renameat2(AT_FDCWD, from, toDir, to, RENAME_NOREPLACE);
+#else
+    errno = EINVAL;
+    return -1;
+#endif
+}
+
+static bool writeAll(int fd, const QByteArray &data)
+{
+    qint64 written = 0;
+    while (written < data.size()) {
+        ssize_t ret = ::write(fd, data.constData() + written, static_cast<size_t>(data.size() - written));
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        written += ret;
+    }
+    return true;
+}
+
+LocalTrashEngine::LocalTrashEngine(const QString &filesPath, const QString &infoPath)
+{
+    pool.setMaxThreadCount(qBound(2, QThread::idealThreadCount(), kMaxTrashThreads));
+
+    // 回收站目录不存在时按规范以 0700 创建
+    ::mkdir(QFile::encodeName(QFileInfo(filesPath).absolutePath()).constData(), 0700);
+    ::mkdir(QFile::encodeName(filesPath).constData(), 0700);
+    ::mkdir(QFile::encodeName(infoPath).constData(), 0700);
+
+    filesFd = ::open(QFile::encodeName(filesPath).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    infoFd = ::open(QFile::encodeName(infoPath).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    struct stat filesStat;
+    struct stat infoStat;
+    if (filesFd < 0 || infoFd < 0
+        || ::fstat(filesFd, &filesStat) != 0 || ::fstat(infoFd, &infoStat) != 0
+        || filesStat.st_dev != infoStat.st_dev) {
+        if (filesFd >= 0)
+            ::close(filesFd);
+        if (infoFd >= 0)
+            ::close(infoFd);
+        filesFd = infoFd = -1;
+        return;
+    }
+
+    trashDev = filesStat.st_dev;
+}
+
+LocalTrashEngine::~LocalTrashEngine()
+{
+    pool.waitForDone();
+    if (filesFd >= 0)
+        ::close(filesFd);
+    if (infoFd >= 0)
+        ::close(infoFd);
+}
+
+bool LocalTrashEngine::isValid() const
+{
+    return filesFd >= 0 && infoFd >= 0;
+}
+
+/*!
+ * \brief LocalTrashEngine::canTrash 文件与回收站位于同一设备时才能直接 rename
+ */
+bool LocalTrashEngine::canTrash(const QUrl &url) const
+{
+    if (!isValid() || !url.isLocalFile())
+        return false;
+
+    struct stat st;
+    if (::lstat(QFile::encodeName(url.path()).constData(), &st) != 0)
+        return false;
+
+    return st.st_dev == trashDev;
+}
+
+/*!
+ * \brief LocalTrashEngine::trashBatch 批量移入回收站
+ * \param items 待处理的文件，失败项的 error 被置为对应 errno
+ * \return 本批次的删除时间区间 "start-end"（秒），与 gio trashFile 返回值格式一致
+ */
+QString LocalTrashEngine::trashBatch(QList<Item> *items)
+{
+    const qint64 startTime = QDateTime::currentSecsSinceEpoch();
+    // DeletionDate 为本地时间，同一批次共用
+    const QByteArray &deletionDate = QDateTime::currentDateTime().toString("yyyy-MM-ddThh:mm:ss").toLatin1();
+
+    QtConcurrent::blockingMap(&pool, *items, [this, &deletionDate](Item &item) {
+        trashItem(&item, deletionDate);
+    });
+
+    const qint64 endTime = QDateTime::currentSecsSinceEpoch();
+    return QString("%1-%2").arg(startTime).arg(endTime);
+}
+
+void LocalTrashEngine::trashItem(Item *item, const QByteArray &deletionDate)
+{
+    const QString &sourcePath = item->source.path();
+    const QByteArray &localPath = QFile::encodeName(sourcePath);
+    const QByteArray &baseName = QFile::encodeName(item->source.fileName());
+    if (baseName.isEmpty()) {
+        item->error = EINVAL;
+        return;
+    }
+
+    QByteArray record;
+    record.reserve(localPath.size() * 3 + 64);
+    record.append("[Trash Info]\nPath=");
+    record.append(QUrl::toPercentEncoding(sourcePath, "/"));
+    record.append("\nDeletionDate=");
+    record.append(deletionDate);
+    record.append('\n');
+
+    // 与 gio 保持一致的重名规则：序号插在第一个 '.' 之前，report.pdf, report.2.pdf, report.3.pdf ...
+    const int dot = baseName.indexOf('.');
+    const QByteArray &stem = dot < 0 ? baseName : baseName.left(dot);
+    const QByteArray &suffix = dot < 0 ? QByteArray() : baseName.mid(dot);
+    for (int i = 1; i <= kMaxNameAttempts; ++i) {
+        const QByteArray &trashName = i == 1 ? baseName : stem + '.' + QByteArray::number(i) + suffix;
+        const QByteArray &infoName = trashName + ".trashinfo";
+
+        int fd = ::openat(infoFd, infoName.constData(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            if (errno == EEXIST)
+                continue;
+            item->error = errno;
+            return;
+        }
+
+        bool ok = writeAll(fd, record);
+        int writeErr = errno;
+        ::close(fd);
+        if (!ok) {
+            ::unlinkat(infoFd, infoName.constData(), 0);
+            item->error = writeErr;
+            return;
+        }
+
+        if (renameNoReplace(localPath.constData(), filesFd, trashName.constData()) == 0) {
+            QUrl trashUrl;
+            trashUrl.setScheme(DFMBASE_NAMESPACE::Global::Scheme::kTrash);
+            trashUrl.setPath("/" + QFile::decodeName(trashName));
+            item->trashUrl = trashUrl;
+            return;
+        }
+
+        int renameErr = errno;
+        ::unlinkat(infoFd, infoName.constData(), 0);
+        // files 目录中存在没有 .trashinfo 的残留项，换下一个名称
+        if (renameErr == EEXIST || renameErr == ENOTEMPTY)
+            continue;
+
+        item->error = renameErr;
+        return;
+    }
+
+    item->error = EEXIST;
+}
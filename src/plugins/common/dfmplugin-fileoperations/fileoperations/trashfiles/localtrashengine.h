@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef LOCALTRASHENGINE_H
+#define LOCALTRASHENGINE_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QList>
+#include <QString>
+#include <QThreadPool>
+#include <QUrl>
+
+#include <sys/types.h>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/*!
+ * \brief The LocalTrashEngine class moves batches of local files into a trash
+ * directory that lives on the same device. The trash directories are opened
+ * once, every .trashinfo record is composed in memory and reserved with a
+ * single O_EXCL create + write, and the files are renamed in parallel with
+ * renameat2(RENAME_NOREPLACE) relative to the trash fd. Items that cannot be
+ * handled here (other device, rename failure, no RENAME_NOREPLACE support)
+ * are reported back with their errno so the caller can use the generic gio
+ * trash path instead.
+ */
+class LocalTrashEngine
+{
+public:
+    struct Item
+    {
+        QUrl source;
+        QUrl trashUrl;   // trash:///<name>
+        int error { 0 };
+    };
+
+    LocalTrashEngine(const QString &filesPath, const QString &infoPath);
+    ~LocalTrashEngine();
+
+    bool isValid() const;
+    bool canTrash(const QUrl &url) const;
+    QString trashBatch(QList<Item> *items);
+
+private:
+    void trashItem(Item *item, const QByteArray &deletionDate);
+
+    int filesFd { -1 };
+    int infoFd { -1 };
+    dev_t trashDev { 0 };
+    QThreadPool pool;
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // LOCALTRASHENGINE_H
@@ -15,6 +15,7 @@
 #include <dfm-base/utils/clipboard.h>
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/utils/iconutils.h>
+#include <dfm-base/utils/iconpixmapcache.h>
 #include <dfm-base/dfm_event_defines.h>
 #include <dfm-base/utils/universalutils.h>
 
@@ -529,19 +530,7 @@ void CanvasItemDelegate::drawExpandText(QPainter *painter, const QStyleOptionVie
 QPixmap CanvasItemDelegate::getIconPixmap(const QIcon &icon, const QSize &size,
                                           qreal pixelRatio, QIcon::Mode mode, QIcon::State state)
 {
-    if (icon.isNull())
-        return QPixmap();
-
-    // 确保当前参数参入获取图片大小大于0
-    if (size.width() <= 0 || size.height() <= 0)
-        return QPixmap();
-
-    // 根据设备像素比获取合适大小的pixmap
-    QSize deviceSize = size * pixelRatio;
-    auto px = icon.pixmap(deviceSize, mode, state);
-    px.setDevicePixelRatio(pixelRatio);
-
-    return px;
+    return IconPixmapCache::instance()->pixmap(icon, size, pixelRatio, mode, state);
 }
 
 CanvasView *CanvasItemDelegate::parent() const
@@ -7,6 +7,7 @@
 #include "filedialogmanageradaptor.h"
 #include "views/filedialog.h"
 #include "menus/filedialogmenuscene.h"
+#include "utils/filedialogpool.h"
 
 #include "plugins/common/dfmplugin-menu/menu_eventinterface_helper.h"
 
@@ -76,6 +77,8 @@ void Core::onAllPluginsStarted()
 
     dfmplugin_menu_util::menuSceneRegisterScene(FileDialogMenuCreator::name(), new FileDialogMenuCreator);
     bindScene("WorkspaceMenu");
+
+    FileDialogPool::instance().warmUp();
 }
 
 void Core::bindScene(const QString &parentScene)
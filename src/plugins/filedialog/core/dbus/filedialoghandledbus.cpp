@@ -170,6 +170,16 @@ quint32 FileDialogHandleDBus::windowFlags() const
     return widget()->windowFlags();
 }
 
+void FileDialogHandleDBus::pauseHeartbeat()
+{
+    curHeartbeatTimer.stop();
+}
+
+void FileDialogHandleDBus::resumeHeartbeat()
+{
+    curHeartbeatTimer.start();
+}
+
 void FileDialogHandleDBus::setHeartbeatInterval(int interval)
 {
     curHeartbeatTimer.setInterval(interval);
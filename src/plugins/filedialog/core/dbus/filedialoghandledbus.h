@@ -28,6 +28,10 @@ public:
     explicit FileDialogHandleDBus(QWidget *parent = nullptr);
     virtual ~FileDialogHandleDBus();
 
+    // a pre-created dialog has no client yet, so it must not time out
+    void pauseHeartbeat();
+    void resumeHeartbeat();
+
 public slots:
     QString directory() const;
 
@@ -6,6 +6,7 @@
 #include "dbus/filedialoghandledbus.h"
 #include "filedialogadaptor.h"
 #include "utils/appexitcontroller.h"
+#include "utils/filedialogpool.h"
 
 #include <dfm-base/dfm_event_defines.h>
 #include <dfm-base/base/application/application.h>
@@ -36,15 +37,15 @@ QDBusObjectPath FileDialogManagerDBus::createDialog(QString key)
     if (key.isEmpty())
         key = QUuid::createUuid().toRfc4122().toHex();
 
-    FileDialogHandleDBus *handle = new FileDialogHandleDBus();
-    Q_UNUSED(new FiledialogAdaptor(handle));
-
     const QDBusObjectPath path("/com/deepin/filemanager/filedialog/" + key);
 
     if (curDialogObjectMap.contains(path)) {
         return path;
     }
 
+    FileDialogHandleDBus *handle = DIALOGCORE_NAMESPACE::FileDialogPool::instance().take();
+    Q_UNUSED(new FiledialogAdaptor(handle));
+
     if (!QDBusConnection::sessionBus().registerObject(path.path(), handle)) {
         fmCritical("File Dialog: Cannot register to the D-Bus object.\n");
         handle->deleteLater();
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "filedialogpool.h"
+#include "dbus/filedialoghandledbus.h"
+
+#include <dfm-framework/dpf.h>
+
+using namespace filedialog_core;
+
+// 每个隐藏的对话框都持有完整的窗口和视图，保留一个即可覆盖连续的请求
+static constexpr int kPoolSize { 1 };
+// 取走对话框后延迟补充，避免和正在显示的对话框争抢主线程
+static constexpr int kRefillDelayMs { 3000 };
+// 最近访问的目录保留在工作区的缓存中，切回这些目录时不需要重新遍历
+static constexpr int kRecentRootCount { 3 };
+
+FileDialogPool &FileDialogPool::instance()
+{
+    static FileDialogPool ins;
+    return ins;
+}
+
+FileDialogPool::FileDialogPool(QObject *parent)
+    : QObject(parent)
+{
+    fillTimer.setSingleShot(true);
+    connect(&fillTimer, &QTimer::timeout, this, &FileDialogPool::fill);
+}
+
+FileDialogHandleDBus *FileDialogPool::take()
+{
+    FileDialogHandleDBus *handle { nullptr };
+    while (!handles.isEmpty() && !handle)
+        handle = handles.takeFirst();
+
+    FileDialog *dialog { nullptr };
+    if (handle) {
+        fmDebug() << "File Dialog: take a pre-created dialog" << handle->winId();
+        handle->resumeHeartbeat();
+        // the dialog was created before the last request, go to the directory that request left
+        dialog = qobject_cast<FileDialog *>(handle->widget());
+        if (dialog && lastVisitedUrl.isValid() && dialog->currentUrl() != lastVisitedUrl)
+            dialog->cd(lastVisitedUrl);
+    } else {
+        handle = new FileDialogHandleDBus();
+        dialog = qobject_cast<FileDialog *>(handle->widget());
+    }
+
+    if (dialog) {
+        connect(dialog, &FileDialog::currentUrlChanged, this, [this](const QUrl &url) {
+            lastVisitedUrl = url;
+        });
+    }
+
+    fillTimer.start(kRefillDelayMs);
+    return handle;
+}
+
+void FileDialogPool::warmUp()
+{
+    dpfSlotChannel->push("dfmplugin_workspace", "slot_Model_KeepRecentRoots", kRecentRootCount);
+    fillTimer.start(0);
+}
+
+void FileDialogPool::fill()
+{
+    handles.removeAll(nullptr);
+    if (handles.count() >= kPoolSize)
+        return;
+
+    handles.append(create());
+    // create one dialog each time the event loop is idle
+    if (handles.count() < kPoolSize)
+        fillTimer.start(0);
+}
+
+FileDialogHandleDBus *FileDialogPool::create()
+{
+    FileDialogHandleDBus *handle = new FileDialogHandleDBus();
+    handle->pauseHeartbeat();
+    fmInfo() << "File Dialog: pre-create a dialog" << handle->winId();
+    return handle;
+}
@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FILEDIALOGPOOL_H
+#define FILEDIALOGPOOL_H
+
+#include "filedialogplugin_core_global.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QUrl>
+
+class FileDialogHandleDBus;
+
+namespace filedialog_core {
+
+/*!
+ * \brief The FileDialogPool class keeps hidden dialogs constructed ahead of
+ * the D-Bus requests, so that a request only needs to show a dialog which has
+ * already loaded the last visited directory.
+ *
+ * Dialogs are created when the event loop is idle and the pool is refilled a
+ * while after one is taken.
+ */
+class FileDialogPool : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(FileDialogPool)
+
+public:
+    static FileDialogPool &instance();
+
+    FileDialogHandleDBus *take();
+    void warmUp();
+
+private:
+    explicit FileDialogPool(QObject *parent = nullptr);
+    void fill();
+    FileDialogHandleDBus *create();
+
+private:
+    QList<QPointer<FileDialogHandleDBus>> handles;
+    QUrl lastVisitedUrl;
+    QTimer fillTimer;
+};
+
+}
+
+#endif   // FILEDIALOGPOOL_H
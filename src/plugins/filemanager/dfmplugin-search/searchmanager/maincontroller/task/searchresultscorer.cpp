@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "searchresultscorer.h"
+
+#include <cmath>
+
+DPSEARCH_USE_NAMESPACE
+
+namespace {
+// 各项权重
+constexpr float kExactMatchScore = 100.0f;
+constexpr float kPrefixMatchScore = 60.0f;
+constexpr float kContainsMatchScore = 30.0f;
+constexpr float kMaxPositionPenalty = 20.0f;
+constexpr float kDepthPenalty = 2.0f;
+constexpr float kMaxDepthPenalty = 20.0f;
+constexpr float kMaxRecencyScore = 20.0f;
+constexpr float kRecencyHalfLifeDays = 7.0f;
+constexpr float kSearcherScoreWeight = 50.0f;
+}
+
+SearchResultScorer::SearchResultScorer(const QUrl &searchRoot, const QString &key)
+    : rootPath(searchRoot.path()),
+      now(QDateTime::currentDateTime())
+{
+    // 通配符不参与名称匹配打分
+    keyword = key;
+    keyword.remove(QLatin1Char('*')).remove(QLatin1Char('?'));
+    keyword = keyword.trimmed();
+
+    if (!rootPath.endsWith(QLatin1Char('/')))
+        rootPath.append(QLatin1Char('/'));
+}
+
+float SearchResultScorer::score(const QUrl &url, float searcherScore, const QDateTime &lastModified) const
+{
+    return score(url.fileName(), depthOf(url.path()), lastModified, searcherScore);
+}
+
+float SearchResultScorer::score(const QString &fileName, int depth, const QDateTime &lastModified, float searcherScore) const
+{
+    float total = nameScore(fileName);
+
+    total -= qMin(kMaxDepthPenalty, kDepthPenalty * qMax(0, depth));
+
+    if (lastModified.isValid()) {
+        const float days = qMax<qint64>(0, lastModified.secsTo(now)) / 86400.0f;
+        total += kMaxRecencyScore * std::exp2(-days / kRecencyHalfLifeDays);
+    }
+
+    // Lucene 等外部得分没有统一的量纲，压缩到 [0, 1) 后再加权
+    if (searcherScore > 0)
+        total += kSearcherScoreWeight * (searcherScore / (searcherScore + 1.0f));
+
+    return total;
+}
+
+bool SearchResultScorer::greater(const ScoredUrl &left, const ScoredUrl &right)
+{
+    return left.score > right.score;
+}
+
+float SearchResultScorer::nameScore(const QString &fileName) const
+{
+    if (keyword.isEmpty() || fileName.isEmpty())
+        return 0;
+
+    if (fileName.compare(keyword, Qt::CaseInsensitive) == 0)
+        return kExactMatchScore;
+
+    // 忽略后缀的完全匹配也视为精确匹配
+    const int dot = fileName.lastIndexOf(QLatin1Char('.'));
+    if (dot > 0 && QStringView(fileName).left(dot).compare(keyword, Qt::CaseInsensitive) == 0)
+        return kExactMatchScore - 1;
+
+    const int pos = fileName.indexOf(keyword, 0, Qt::CaseInsensitive);
+    if (pos == 0)
+        return kPrefixMatchScore;
+    if (pos > 0)
+        return kContainsMatchScore - qMin(kMaxPositionPenalty, static_cast<float>(pos));
+
+    return 0;
+}
+
+int SearchResultScorer::depthOf(const QString &path) const
+{
+    if (!path.startsWith(rootPath))
+        return path.count(QLatin1Char('/'));
+
+    return QStringView(path).mid(rootPath.length()).count(QLatin1Char('/'));
+}
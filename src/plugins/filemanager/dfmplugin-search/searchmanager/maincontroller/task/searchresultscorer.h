@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SEARCHRESULTSCORER_H
+#define SEARCHRESULTSCORER_H
+
+#include "dfmplugin_search_global.h"
+
+#include <QUrl>
+#include <QString>
+#include <QDateTime>
+
+DPSEARCH_BEGIN_NAMESPACE
+
+/*!
+ * \brief The SearchResultScorer class computes a relevance score for a search hit.
+ * The score combines the keyword match in the file name (exact, prefix or contained,
+ * and the position of the match), the depth of the file below the search root,
+ * how recently it was modified and the score reported by the searcher itself
+ * (e.g. the Lucene score of full-text hits). Higher is better.
+ * The scorer never touches the file system, the modification time is only used
+ * when the searcher already knows it.
+ */
+class SearchResultScorer
+{
+public:
+    struct ScoredUrl
+    {
+        QUrl url;
+        float score { 0 };
+    };
+
+    SearchResultScorer(const QUrl &searchRoot, const QString &keyword);
+
+    float score(const QUrl &url, float searcherScore = 0, const QDateTime &lastModified = QDateTime()) const;
+    float score(const QString &fileName, int depth, const QDateTime &lastModified, float searcherScore = 0) const;
+
+    static bool greater(const ScoredUrl &left, const ScoredUrl &right);
+
+private:
+    float nameScore(const QString &fileName) const;
+    int depthOf(const QString &path) const;
+
+    QString rootPath;
+    QString keyword;
+    QDateTime now;
+};
+
+DPSEARCH_END_NAMESPACE
+
+#endif   // SEARCHRESULTSCORER_H
@@ -11,6 +11,9 @@
 
 #include <QtConcurrent>
 
+#include <algorithm>
+#include <vector>
+
 DPSEARCH_USE_NAMESPACE
 
 TaskCommanderPrivate::TaskCommanderPrivate(TaskCommander *parent)
@@ -50,7 +53,10 @@ void TaskCommanderPrivate::onUnearthed(AbstractSearcher *searcher)
     Q_ASSERT(searcher);
 
     if (allSearchers.contains(searcher) && searcher->hasItem()) {
-        auto results = searcher->takeAll();
+        auto results = rankResults(searcher, searcher->takeAll());
+        if (results.isEmpty())
+            return;
+
         QWriteLocker lk(&rwLock);
         bool isEmpty = resultList.isEmpty();
 
@@ -61,6 +67,38 @@ void TaskCommanderPrivate::onUnearthed(AbstractSearcher *searcher)
     }
 }
 
+QList<QUrl> TaskCommanderPrivate::rankResults(AbstractSearcher *searcher, QList<QUrl> results)
+{
+    QMutexLocker lk(&rankMutex);
+    searcherScores.insert(searcher->takeScores());
+    searcherModifiedTimes.insert(searcher->takeModifiedTimes());
+
+    std::vector<SearchResultScorer::ScoredUrl> batch;
+    batch.reserve(static_cast<size_t>(results.size()));
+    for (const auto &url : results) {
+        const float extScore = searcherScores.take(url);
+        const qint64 modified = searcherModifiedTimes.take(url);
+        // 多个搜索器命中同一文件（如文件名和全文），只保留一份结果
+        if (rankedUrls.contains(url))
+            continue;
+
+        rankedUrls.insert(url);
+        const float score = scorer->score(url, extScore,
+                                          modified > 0 ? QDateTime::fromSecsSinceEpoch(modified) : QDateTime());
+        batch.push_back({ url, score });
+    }
+
+    // 每批结果按相关性降序推送，不阻塞结果的流式输出
+    std::stable_sort(batch.begin(), batch.end(), SearchResultScorer::greater);
+
+    QList<QUrl> ranked;
+    ranked.reserve(static_cast<int>(batch.size()));
+    for (const auto &item : batch)
+        ranked.append(item.url);
+
+    return ranked;
+}
+
 void TaskCommanderPrivate::onFinished()
 {
     // 工作线程退出，若之前调用了deleteSelf那么在这里执行释放，否则发送结束信号
@@ -80,6 +118,7 @@ TaskCommander::TaskCommander(QString taskId, const QUrl &url, const QString &key
       d(new TaskCommanderPrivate(this))
 {
     d->taskId = taskId;
+    d->scorer.reset(new SearchResultScorer(url, keyword));
     createSearcher(url, keyword);
 }
 
@@ -7,10 +7,15 @@
 
 #include "taskcommander.h"
 #include "searchmanager/searcher/abstractsearcher.h"
+#include "searchresultscorer.h"
 
 #include <QFutureWatcher>
 #include <QUrl>
 #include <QReadWriteLock>
+#include <QMutex>
+#include <QSet>
+
+#include <memory>
 
 DPSEARCH_BEGIN_NAMESPACE
 
@@ -26,6 +31,7 @@ public:
 private:
     static void working(AbstractSearcher *searcher);
     AbstractSearcher *createFileNameSearcher(const QUrl &url, const QString &keyword);
+    QList<QUrl> rankResults(AbstractSearcher *searcher, QList<QUrl> results);
 
 private slots:
     void onUnearthed(AbstractSearcher *searcher);
@@ -40,6 +46,13 @@ private:
     QReadWriteLock rwLock;
     QList<QUrl> resultList;
 
+    // 相关性排序：已命中的结果、搜索器给出的得分和修改时间
+    QMutex rankMutex;
+    std::unique_ptr<SearchResultScorer> scorer;
+    QSet<QUrl> rankedUrls;
+    QHash<QUrl, float> searcherScores;
+    QHash<QUrl, qint64> searcherModifiedTimes;
+
     bool deleted = false;
     bool finished = false;   //保证结束信号只发一次
 
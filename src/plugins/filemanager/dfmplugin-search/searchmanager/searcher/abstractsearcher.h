@@ -9,6 +9,7 @@
 
 #include <QObject>
 #include <QUrl>
+#include <QHash>
 
 DPSEARCH_BEGIN_NAMESPACE
 
@@ -28,6 +29,10 @@ public:
     virtual void stop() = 0;
     virtual bool hasItem() const = 0;
     virtual QList<QUrl> takeAll() = 0;
+    // 搜索器自身给出的相关性得分（如Lucene得分），需在takeAll之后调用
+    virtual QHash<QUrl, float> takeScores() { return {}; }
+    // 搜索器已获取的修改时间（秒），用于相关性排序，避免排序时再次读取文件属性
+    virtual QHash<QUrl, qint64> takeModifiedTimes() { return {}; }
 signals:
     void unearthed(AbstractSearcher *searcher);
 
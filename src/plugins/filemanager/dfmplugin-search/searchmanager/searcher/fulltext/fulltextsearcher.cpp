@@ -4,6 +4,7 @@
 
 #include "fulltextsearcher.h"
 #include "fulltextsearcher_p.h"
+#include "indexreaderpool.h"
 #include "fulltext/chineseanalyzer.h"
 #include "utils/searchhelper.h"
 
@@ -57,11 +58,6 @@ IndexWriterPtr FullTextSearcherPrivate::newIndexWriter(bool create)
                                   IndexWriter::MaxFieldLengthLIMITED);
 }
 
-IndexReaderPtr FullTextSearcherPrivate::newIndexReader()
-{
-    return IndexReader::open(FSDirectory::open(indexStorePath().toStdWString()), true);
-}
-
 void FullTextSearcherPrivate::tryNotify()
 {
     int cur = notifyTimer.elapsed();
@@ -83,12 +79,14 @@ bool FullTextSearcherPrivate::doSearch(const QString &path, const QString &keywo
         hasTransform = true;
 
     try {
-        IndexReaderPtr reader = newIndexReader();
-        SearcherPtr searcher = newLucene<IndexSearcher>(reader);
-        AnalyzerPtr analyzer = newLucene<ChineseAnalyzer>();
-        QueryParserPtr parser = newLucene<QueryParser>(LuceneVersion::LUCENE_CURRENT, L"contents", analyzer);
-        // 设定第一个* 可以匹配
-        parser->setAllowLeadingWildcard(true);
+        // reader、searcher和analyzer在各查询间共享，仅在索引变化时重新加载
+        auto pool = IndexReaderPool::instance();
+        IndexReaderPool::Lease lease = pool->acquire();
+        if (!lease.isValid())
+            return false;
+
+        SearcherPtr searcher = lease.indexSearcher();
+        QueryParserPtr parser = pool->newQueryParser(L"contents");
         QueryPtr query = parser->parse(keyword.toStdWString());
 
         // create query filter
@@ -128,8 +126,11 @@ bool FullTextSearcherPrivate::doSearch(const QString &path, const QString &keywo
                     if (!SearchHelper::instance()->isHiddenFile(StringUtils::toUTF8(resultPath).c_str(), hiddenFileHash, searchPath)) {
                         if (hasTransform)
                             resultPath.replace(0, static_cast<unsigned long>(searchPath.length()), path.toStdWString());
+                        const QUrl &resultUrl = QUrl::fromLocalFile(StringUtils::toUTF8(resultPath).c_str());
                         QMutexLocker lk(&mutex);
-                        allResults.append(QUrl::fromLocalFile(StringUtils::toUTF8(resultPath).c_str()));
+                        allResults.append(resultUrl);
+                        allScores.insert(resultUrl, static_cast<float>(scoreDoc->score));
+                        allModifiedTimes.insert(resultUrl, modifyTime.toSecsSinceEpoch());
                     }
 
                     // 推送
@@ -138,8 +139,6 @@ bool FullTextSearcherPrivate::doSearch(const QString &path, const QString &keywo
             }
         }
 
-        reader->close();
-
         // 如果有无效的索引路径，一次性启动移除任务
         if (!invalidIndexPaths.isEmpty()) {
             auto client = TextIndexClient::instance();
@@ -150,6 +149,9 @@ bool FullTextSearcherPrivate::doSearch(const QString &path, const QString &keywo
 
     } catch (const LuceneException &e) {
         fmWarning() << QString::fromStdWString(e.getError());
+        // 索引可能已损坏或被重建，下次查询时重新打开；关键字解析错误等不影响reader
+        if (IndexReaderPool::isIndexBroken(e))
+            IndexReaderPool::instance()->invalidate();
     } catch (const std::exception &e) {
         fmWarning() << QString(e.what());
     } catch (...) {
@@ -358,3 +360,15 @@ QList<QUrl> FullTextSearcher::takeAll()
     QMutexLocker lk(&d->mutex);
     return std::move(d->allResults);
 }
+
+QHash<QUrl, float> FullTextSearcher::takeScores()
+{
+    QMutexLocker lk(&d->mutex);
+    return std::move(d->allScores);
+}
+
+QHash<QUrl, qint64> FullTextSearcher::takeModifiedTimes()
+{
+    QMutexLocker lk(&d->mutex);
+    return std::move(d->allModifiedTimes);
+}
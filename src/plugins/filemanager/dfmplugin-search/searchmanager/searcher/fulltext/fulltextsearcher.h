@@ -31,6 +31,8 @@ private:
     void stop() override;
     bool hasItem() const override;
     QList<QUrl> takeAll() override;
+    QHash<QUrl, float> takeScores() override;
+    QHash<QUrl, qint64> takeModifiedTimes() override;
     static bool isSupport(const QUrl &url);
 
 private Q_SLOTS:
@@ -23,6 +23,7 @@ class FullTextSearcherPrivate : public QObject
 {
     Q_OBJECT
     friend class FullTextSearcher;
+    friend class IndexReaderPool;
 
 public:
     enum WordType {
@@ -49,7 +50,6 @@ public:
 
 private:
     Lucene::IndexWriterPtr newIndexWriter(bool create = false);
-    Lucene::IndexReaderPtr newIndexReader();
 
     bool doSearch(const QString &path, const QString &keyword);
     inline static QString indexStorePath()
@@ -68,6 +68,8 @@ private:
     QMutex taskMutex;
     QWaitCondition taskCondition;
     QList<QUrl> allResults;
+    QHash<QUrl, float> allScores;
+    QHash<QUrl, qint64> allModifiedTimes;
     mutable QMutex mutex;
     static bool isIndexCreating;
     QMap<QString, QString> bindPathTable;
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "indexreaderpool.h"
+#include "fulltextsearcher_p.h"
+#include "fulltext/chineseanalyzer.h"
+
+using namespace Lucene;
+DPSEARCH_USE_NAMESPACE
+
+IndexReaderPool::Lease::Lease(IndexReaderPtr r, SearcherPtr s)
+    : reader(std::move(r)),
+      searcher(std::move(s))
+{
+}
+
+IndexReaderPool::Lease::Lease(Lease &&other) noexcept
+    : reader(std::move(other.reader)),
+      searcher(std::move(other.searcher))
+{
+    other.reader.reset();
+    other.searcher.reset();
+}
+
+IndexReaderPool::Lease &IndexReaderPool::Lease::operator=(Lease &&other) noexcept
+{
+    if (this != &other) {
+        release();
+        reader = std::move(other.reader);
+        searcher = std::move(other.searcher);
+        other.reader.reset();
+        other.searcher.reset();
+    }
+    return *this;
+}
+
+IndexReaderPool::Lease::~Lease()
+{
+    release();
+}
+
+void IndexReaderPool::Lease::release()
+{
+    if (!reader)
+        return;
+
+    try {
+        // 引用计数归零时reader会被关闭
+        reader->decRef();
+    } catch (const LuceneException &e) {
+        fmWarning() << "Release index reader failed:" << QString::fromStdWString(e.getError());
+    }
+    reader.reset();
+    searcher.reset();
+}
+
+IndexReaderPool *IndexReaderPool::instance()
+{
+    static IndexReaderPool ins;
+    return &ins;
+}
+
+IndexReaderPool::IndexReaderPool()
+    : storePath(FullTextSearcherPrivate::indexStorePath())
+{
+}
+
+IndexReaderPool::~IndexReaderPool()
+{
+    QMutexLocker lk(&mutex);
+    closeLocked();
+}
+
+IndexReaderPool::Lease IndexReaderPool::acquire()
+{
+    QMutexLocker lk(&mutex);
+    if (!refreshLocked())
+        return {};
+
+    reader->incRef();
+    return Lease(reader, searcher);
+}
+
+AnalyzerPtr IndexReaderPool::analyzer()
+{
+    QMutexLocker lk(&mutex);
+    // Analyzer内部按线程复用分词流，可在多个查询间共享
+    if (!sharedAnalyzer)
+        sharedAnalyzer = newLucene<ChineseAnalyzer>();
+    return sharedAnalyzer;
+}
+
+QueryParserPtr IndexReaderPool::newQueryParser(const String &field)
+{
+    // QueryParser有解析状态，不能跨线程共享，但构造开销很小
+    QueryParserPtr parser = newLucene<QueryParser>(LuceneVersion::LUCENE_CURRENT, field, analyzer());
+    // 设定第一个* 可以匹配
+    parser->setAllowLeadingWildcard(true);
+    return parser;
+}
+
+void IndexReaderPool::invalidate()
+{
+    QMutexLocker lk(&mutex);
+    closeLocked();
+}
+
+/*!
+ * \brief IndexReaderPool::isIndexBroken
+ * \return true if the exception means the index files can no longer be read through
+ * the pooled reader. Errors caused by the query itself, such as a parse error of the
+ * user input, keep the reader.
+ */
+bool IndexReaderPool::isIndexBroken(const LuceneException &e)
+{
+    switch (e.getType()) {
+    case LuceneException::IO:
+    case LuceneException::CorruptIndex:
+    case LuceneException::FileNotFound:
+    case LuceneException::NoSuchDirectory:
+    case LuceneException::AlreadyClosed:
+    case LuceneException::StaleReader:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool IndexReaderPool::refreshLocked()
+{
+    try {
+        if (!reader) {
+            reader = IndexReader::open(FSDirectory::open(storePath.toStdWString()), true);
+            searcher = newLucene<IndexSearcher>(reader);
+            return true;
+        }
+
+        if (reader->isCurrent())
+            return true;
+
+        // 索引已变化，仅重新加载变化的段，旧reader在所有租用结束后关闭
+        IndexReaderPtr newReader = reader->reopen();
+        if (newReader != reader) {
+            reader->decRef();
+            reader = newReader;
+            searcher = newLucene<IndexSearcher>(reader);
+        }
+        return true;
+    } catch (const LuceneException &e) {
+        fmWarning() << "Open index reader failed:" << QString::fromStdWString(e.getError());
+    } catch (const std::exception &e) {
+        fmWarning() << "Open index reader failed:" << e.what();
+    }
+
+    closeLocked();
+    return false;
+}
+
+void IndexReaderPool::closeLocked()
+{
+    if (!reader)
+        return;
+
+    try {
+        reader->decRef();
+    } catch (...) {
+        // 忽略关闭时的异常
+    }
+    reader.reset();
+    searcher.reset();
+}
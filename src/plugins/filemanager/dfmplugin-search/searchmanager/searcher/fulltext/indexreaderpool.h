@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INDEXREADERPOOL_H
+#define INDEXREADERPOOL_H
+
+#include "dfmplugin_search_global.h"
+
+#include <lucene++/LuceneHeaders.h>
+
+#include <QMutex>
+#include <QString>
+
+DPSEARCH_BEGIN_NAMESPACE
+
+/*!
+ * \brief The IndexReaderPool class shares one long-lived Lucene reader,
+ * searcher and analyzer between all full-text search tasks.
+ * Opening a large index is expensive, so the reader is opened once and only
+ * reopened (IndexReader::reopen) when the index on disk has changed.
+ * A reader handed out through a Lease stays valid until the lease is gone,
+ * even if the pool switches to a newer reader in the meantime.
+ */
+class IndexReaderPool
+{
+    Q_DISABLE_COPY(IndexReaderPool)
+
+public:
+    class Lease
+    {
+    public:
+        Lease() = default;
+        Lease(Lucene::IndexReaderPtr reader, Lucene::SearcherPtr searcher);
+        Lease(Lease &&other) noexcept;
+        Lease &operator=(Lease &&other) noexcept;
+        ~Lease();
+
+        bool isValid() const { return reader != nullptr; }
+        Lucene::IndexReaderPtr indexReader() const { return reader; }
+        Lucene::SearcherPtr indexSearcher() const { return searcher; }
+
+    private:
+        void release();
+
+        Lucene::IndexReaderPtr reader;
+        Lucene::SearcherPtr searcher;
+    };
+
+    static IndexReaderPool *instance();
+
+    Lease acquire();
+    Lucene::AnalyzerPtr analyzer();
+    Lucene::QueryParserPtr newQueryParser(const Lucene::String &field);
+    void invalidate();
+    static bool isIndexBroken(const Lucene::LuceneException &e);
+
+private:
+    IndexReaderPool();
+    ~IndexReaderPool();
+
+    bool refreshLocked();
+    void closeLocked();
+
+    QMutex mutex;
+    QString storePath;
+    Lucene::IndexReaderPtr reader;
+    Lucene::SearcherPtr searcher;
+    Lucene::AnalyzerPtr sharedAnalyzer;
+};
+
+DPSEARCH_END_NAMESPACE
+
+#endif   // INDEXREADERPOOL_H
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "iteratorsearcher.h"
+#include "localdirwalker.h"
 #include "utils/searchhelper.h"
 
 #include <dfm-base/utils/fileutils.h>
@@ -12,6 +13,13 @@
 
 static int kEmitInterval = 50;   // 推送时间间隔（ms
 static constexpr char kFilterFolders[] = "^/(dev|proc|sys|run|tmpfs).*$";
+static constexpr char kDesktopSuffix[] = ".desktop";
+
+static const QRegularExpression &filterFoldersRegex()
+{
+    static const QRegularExpression reg(kFilterFolders);
+    return reg;
+}
 
 DFMBASE_USE_NAMESPACE
 DPSEARCH_USE_NAMESPACE
@@ -21,6 +29,10 @@ IteratorSearcher::IteratorSearcher(const QUrl &url, const QString &key, QObject
 {
     searchPathList << url;
     regex = QRegularExpression(keyword, QRegularExpression::CaseInsensitiveOption);
+    // 多线程匹配前提前编译
+    regex.optimize();
+    // 仅在过滤目录下进行搜索时，过滤目录下的内容才能被检索
+    searchInFilterFolder = url.isLocalFile() && filterFoldersRegex().match(url.toLocalFile()).hasMatch();
 }
 
 bool IteratorSearcher::search()
@@ -62,15 +74,64 @@ QList<QUrl> IteratorSearcher::takeAll()
 
 void IteratorSearcher::tryNotify()
 {
-    int cur = notifyTimer.elapsed();
-    if (hasItem() && (cur - lastEmit) > kEmitInterval) {
+    int cur = static_cast<int>(notifyTimer.elapsed());
+    {
+        // 本地搜索时由多个线程调用
+        QMutexLocker lk(&mutex);
+        if (allResults.isEmpty() || (cur - lastEmit) <= kEmitInterval)
+            return;
         lastEmit = cur;
-        fmDebug() << "IteratorSearcher unearthed, current spend:" << cur;
-        emit unearthed(this);
     }
+
+    fmDebug() << "IteratorSearcher unearthed, current spend:" << cur;
+    emit unearthed(this);
 }
 
 void IteratorSearcher::doSearch()
+{
+    if (searchUrl.isLocalFile())
+        doLocalSearch();
+    else
+        doIteratorSearch();
+}
+
+void IteratorSearcher::doLocalSearch()
+{
+    LocalDirWalker walker([this](const QString &dirPath, const QString &fileName) { onLocalEntry(dirPath, fileName); },
+                          [this](const QString &dirPath) { return !isFilteredDir(dirPath); },
+                          [this] { return status.loadAcquire() != kRuning; });
+    walker.walk(searchUrl.toLocalFile());
+}
+
+bool IteratorSearcher::isFilteredDir(const QString &dirPath) const
+{
+    return !searchInFilterFolder && filterFoldersRegex().match(dirPath).hasMatch();
+}
+
+void IteratorSearcher::onLocalEntry(const QString &dirPath, const QString &fileName)
+{
+    const QString &filePath = dirPath.endsWith('/') ? dirPath + fileName : dirPath + '/' + fileName;
+
+    // 名称先匹配，仅desktop文件需要通过FileInfo获取显示名称
+    bool matched = regex.match(fileName).hasMatch();
+    if (!matched && fileName.endsWith(kDesktopSuffix)) {
+        auto info = InfoFactory::create<FileInfo>(QUrl::fromLocalFile(filePath));
+        matched = info && regex.match(info->displayOf(DisPlayInfoType::kFileDisplayName)).hasMatch();
+    }
+
+    if (!matched)
+        return;
+
+    {
+        QMutexLocker lk(&mutex);
+        allResults << QUrl::fromLocalFile(filePath);
+    }
+
+    // 推送
+    tryNotify();
+}
+
+void IteratorSearcher::doIteratorSearch()
 {
     forever {
         if (searchPathList.isEmpty() || status.loadAcquire() != kRuning)
@@ -85,13 +146,8 @@ void IteratorSearcher::doSearch()
                                      standard::size,standard::is-symlink,standard::symlink-target,access::*,time::*");
 
         // 仅在过滤目录下进行搜索时，过滤目录下的内容才能被检索
-        if (url.isLocalFile()) {
-            QRegularExpression reg(kFilterFolders);
-            const auto &searchRootPath = searchUrl.toLocalFile();
-            const auto &filePath = url.toLocalFile();
-            if (!reg.match(searchRootPath).hasMatch() && reg.match(filePath).hasMatch())
-                continue;
-        }
+        if (url.isLocalFile() && isFilteredDir(url.toLocalFile()))
+            continue;
 
         while (iterator->hasNext()) {
             // 中断
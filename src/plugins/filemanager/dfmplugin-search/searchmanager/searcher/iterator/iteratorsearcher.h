@@ -28,6 +28,10 @@ private:
     QList<QUrl> takeAll() override;
     void tryNotify();
     void doSearch();
+    void doLocalSearch();
+    void doIteratorSearch();
+    bool isFilteredDir(const QString &dirPath) const;
+    void onLocalEntry(const QString &dirPath, const QString &fileName);
 
 private:
     QAtomicInt status = kReady;
@@ -35,6 +39,7 @@ private:
     mutable QMutex mutex;
     QList<QUrl> searchPathList;
     QRegularExpression regex;
+    bool searchInFilterFolder = false;
 
     //计时
     QElapsedTimer notifyTimer;
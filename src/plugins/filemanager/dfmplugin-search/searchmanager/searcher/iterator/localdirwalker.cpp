@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "localdirwalker.h"
+
+#include <QFile>
+#include <QThread>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
+static constexpr int kMaxLocalWorkers = 4;   // 本地设备最大并发
+static constexpr int kRemoteWorkers = 1;   // 网络/FUSE设备并发
+
+// statfs f_type
+static constexpr long kNfsMagic = 0x6969;
+static constexpr long kSmbMagic = 0x517B;
+static constexpr long kCifsMagic = 0xFF534D42;
+static constexpr long kSmb2Magic = 0xFE534D42;
+static constexpr long kFuseMagic = 0x65735546;
+
+DPSEARCH_USE_NAMESPACE
+
+LocalDirWalker::LocalDirWalker(EntryHandler entryHandler, DirFilter dirFilter, StopChecker stopChecker)
+    : handler(std::move(entryHandler)),
+      filter(std::move(dirFilter)),
+      stopped(std::move(stopChecker))
+{
+    // 线程数由各设备的配额限制，线程池本身不做限制
+    pool.setMaxThreadCount(qMax(QThread::idealThreadCount(), kMaxLocalWorkers) * 2);
+}
+
+LocalDirWalker::~LocalDirWalker()
+{
+    pool.waitForDone();
+}
+
+void LocalDirWalker::walk(const QString &rootPath)
+{
+    const QByteArray &path = QFile::encodeName(rootPath);
+    struct stat st;
+    if (::stat(path.constData(), &st) != 0 || !S_ISDIR(st.st_mode))
+        return;
+
+    {
+        QMutexLocker lk(&mutex);
+        enqueue(st.st_dev, path);
+    }
+
+    pool.waitForDone();
+}
+
+int LocalDirWalker::workerCountOf(const QByteArray &path)
+{
+    struct statfs fs;
+    if (::statfs(path.constData(), &fs) == 0) {
+        switch (static_cast<long>(fs.f_type)) {
+        case kNfsMagic:
+        case kSmbMagic:
+        case kCifsMagic:
+        case kSmb2Magic:
+        case kFuseMagic:
+            return kRemoteWorkers;
+        default:
+            break;
+        }
+    }
+
+    return qBound(1, QThread::idealThreadCount(), kMaxLocalWorkers);
+}
+
+void LocalDirWalker::enqueue(quint64 device, const QByteArray &path)
+{
+    // 调用方持有锁
+    auto &queue = queues[device];
+    if (queue.maxWorkers == 0)
+        queue.maxWorkers = workerCountOf(path);
+
+    queue.dirs.enqueue(path);
+    if (queue.workers < queue.maxWorkers) {
+        ++queue.workers;
+        pool.start([this, device] { work(device); });
+    }
+}
+
+void LocalDirWalker::work(quint64 device)
+{
+    forever {
+        QByteArray path;
+        {
+            QMutexLocker lk(&mutex);
+            auto &queue = queues[device];
+            // 队列为空时退出，后续有新目录入队时会重新启动工作线程
+            if (queue.dirs.isEmpty() || stopped()) {
+                --queue.workers;
+                return;
+            }
+            path = queue.dirs.dequeue();
+        }
+
+        scanDir(path);
+    }
+}
+
+void LocalDirWalker::scanDir(const QByteArray &path)
+{
+    int fd = ::open(path.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+        return;
+
+    DIR *dir = ::fdopendir(fd);
+    if (!dir) {
+        ::close(fd);
+        return;
+    }
+
+    const QString &dirPath = QFile::decodeName(path);
+    const QByteArray &prefix = path.endsWith('/') ? path : path + '/';
+    struct dirent *entry = nullptr;
+    while ((entry = ::readdir(dir))) {
+        if (stopped())
+            break;
+
+        // 与 DirIterator 的 NoDotAndDotDot | Dirs | Files 一致，跳过隐藏文件，也不进入 .git、.cache 等隐藏目录
+        const char *name = entry->d_name;
+        if (name[0] == '.')
+            continue;
+
+        handler(dirPath, QFile::decodeName(name));
+
+        if (entry->d_type != DT_DIR && entry->d_type != DT_UNKNOWN)
+            continue;
+
+        // 不跟随符号链接
+        struct stat st;
+        if (::fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0 || !S_ISDIR(st.st_mode))
+            continue;
+
+        const QByteArray &childPath = prefix + name;
+        if (filter && !filter(QFile::decodeName(childPath)))
+            continue;
+
+        QMutexLocker lk(&mutex);
+        enqueue(st.st_dev, childPath);
+    }
+
+    ::closedir(dir);
+}
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef LOCALDIRWALKER_H
+#define LOCALDIRWALKER_H
+
+#include "dfmplugin_search_global.h"
+
+#include <QHash>
+#include <QQueue>
+#include <QMutex>
+#include <QThreadPool>
+
+#include <functional>
+
+DPSEARCH_BEGIN_NAMESPACE
+
+/*!
+ * \brief The LocalDirWalker class walks a local directory tree in parallel.
+ * Entries are read with readdir on dirfd-relative handles, so callers see raw
+ * names without any FileInfo being created. Directories are queued per backing
+ * device and every device gets its own worker quota: local disks are walked
+ * by several threads while network and FUSE mounts get a single one, so a
+ * slow mount never starves the others. Hidden entries are skipped and hidden
+ * directories are not descended into.
+ */
+class LocalDirWalker
+{
+public:
+    // called from worker threads for every entry
+    using EntryHandler = std::function<void(const QString &dirPath, const QString &fileName)>;
+    // return false to skip descending into a directory
+    using DirFilter = std::function<bool(const QString &dirPath)>;
+    using StopChecker = std::function<bool()>;
+
+    LocalDirWalker(EntryHandler entryHandler, DirFilter dirFilter, StopChecker stopChecker);
+    ~LocalDirWalker();
+
+    void walk(const QString &rootPath);
+    static int workerCountOf(const QByteArray &path);
+
+private:
+    struct DeviceQueue
+    {
+        QQueue<QByteArray> dirs;
+        int workers { 0 };
+        int maxWorkers { 0 };
+    };
+
+    void enqueue(quint64 device, const QByteArray &path);
+    void work(quint64 device);
+    void scanDir(const QByteArray &path);
+
+    EntryHandler handler;
+    DirFilter filter;
+    StopChecker stopped;
+
+    QMutex mutex;
+    QHash<quint64, DeviceQueue> queues;
+    QThreadPool pool;
+};
+
+DPSEARCH_END_NAMESPACE
+
+#endif   // LOCALDIRWALKER_H
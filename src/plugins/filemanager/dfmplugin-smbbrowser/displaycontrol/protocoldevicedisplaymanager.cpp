@@ -8,6 +8,7 @@
 #include "displaycontrol/info/protocolvirtualentryentity.h"
 #include "displaycontrol/menu/virtualentrymenuscene.h"
 #include "displaycontrol/utilities/protocoldisplayutilities.h"
+#include "utils/smbsharecache.h"
 
 #include "plugins/common/dfmplugin-menu/menu_eventinterface_helper.h"
 
@@ -111,12 +112,15 @@ void ProtocolDeviceDisplayManager::onDevMounted(const QString &id, const QString
     if (!ProtocolUtils::isSMBFile(QUrl(id)))
         return;
 
+    // keep the mounted share in the share listing of its host, so that it can be shown when the host is offline.
+    const QString &stdSmbPath = getStandardSmbPath(id);
+    SmbShareCache::instance()->addShare(QUrl(stdSmbPath));
+
     if (!isShowOfflineItem())
         return;
 
     // obtain the display name of `id`
     const QString &displayName = getDisplayNameOf(id);
-    const QString &stdSmbPath = getStandardSmbPath(id);
     VirtualEntryDbHandler::instance()->saveAggregatedAndSperated(stdSmbPath, displayName);
 
     const QUrl &vEntryUrl = makeVEntryUrl(stdSmbPath);
@@ -4,6 +4,8 @@
 
 #include "traversprehandler.h"
 #include "utils/smbbrowserutils.h"
+#include "utils/smbsharecache.h"
+#include "utils/smbhostprober.h"
 #include "displaycontrol/utilities/protocoldisplayutilities.h"
 #include "displaycontrol/datahelper/virtualentrydbhandler.h"
 #include "displaycontrol/protocoldevicedisplaymanager.h"
@@ -89,6 +91,27 @@ void travers_prehandler::networkAccessPrehandler(quint64 winId, const QUrl &url,
         return sets.value(QString("%1/%2").arg(kRecordGroup).arg(key), "").toString();
     };
 
+    // 有缓存的主机直接显示缓存的共享列表，主机可达时再在后台挂载并刷新列表，
+    // 不可达时不再等待挂载超时，也不弹出错误
+    if (isSmb && SmbShareCache::isCacheable(url) && SmbShareCache::instance()->hasListing(url)) {
+        if (after)
+            after();
+        SmbHostProber::instance()->probeAsync(url, qApp, [=](bool reachable) {
+            if (!reachable) {
+                fmInfo() << "host is unreachable, show cached shares only:" << url;
+                return;
+            }
+            DevMngIns->mountNetworkDeviceAsync(mountSource, [=](bool ok, const DFMMOUNT::OperationErrorInfo &err, const QString &) {
+                fmInfo() << "mount cached host done: " << url << ok << err.code << err.message;
+                if (ok || err.code == DFMMOUNT::DeviceError::kGIOErrorAlreadyMounted) {
+                    onSmbRootMounted(mountSource, nullptr);
+                    SmbShareCache::instance()->refreshAsync(url, true);
+                }
+            });
+        });
+        return;
+    }
+
     DevMngIns->mountNetworkDeviceAsync(mountSource, [=](bool ok, const DFMMOUNT::OperationErrorInfo &err, const QString &mpt) {
         fmInfo() << "mount done: " << url << ok << err.code << err.message << mpt;
         if (!mpt.isEmpty()) {
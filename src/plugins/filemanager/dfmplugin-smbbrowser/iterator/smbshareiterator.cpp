@@ -5,6 +5,8 @@
 #include "smbshareiterator.h"
 #include "private/smbshareiterator_p.h"
 #include "utils/smbbrowserutils.h"
+#include "utils/smbsharecache.h"
+#include "utils/smbhostprober.h"
 
 using namespace dfmplugin_smbbrowser;
 DFMBASE_USE_NAMESPACE
@@ -37,27 +39,24 @@ SmbShareIterator::~SmbShareIterator()
 
 QUrl SmbShareIterator::next()
 {
-    d->enumerator->next();
-    auto info = d->enumerator->fileInfo();
-    if (!info)
-        return {};
-
-    // TODO(xust) TODO(lanxs) if url contains '#', wrong info is returned
-    QUrl url = QUrl::fromPercentEncoding(info->attribute(DFileInfo::AttributeID::kStandardTargetUri).toString().toLocal8Bit());
-    QStringList icons = info->attribute(DFileInfo::AttributeID::kStandardIcon).toStringList();
-    QString icon = icons.count() > 0 ? icons.first() : "folder-remote";
-    QString name = info->attribute(DFileInfo::AttributeID::kStandardDisplayName).toString();
-
-    int serverPort = d->rootUrl.port();
-    if (serverPort != -1)
-        url.setPort(serverPort);
+    SmbShareNode node;
+    if (d->fromCache) {
+        if (d->cacheIndex >= d->smbShares.count())
+            return {};
+        node = d->smbShares.at(d->cacheIndex++);
+    } else {
+        d->enumerator->next();
+        auto info = d->enumerator->fileInfo();
+        if (!info)
+            return {};
+
+        node = SmbShareCache::makeNode(d->rootUrl, info);
+        d->smbShares.append(node);
+    }
 
+    QUrl url(node.url);
     {
         QMutexLocker locker(&smb_browser_utils::nodesMutex());
-        SmbShareNode node;
-        node.url = url.toString();
-        node.iconType = icon;
-        node.displayName = name;
         smb_browser_utils::shareNodes().insert(url, node);
     }
 
@@ -66,7 +65,15 @@ QUrl SmbShareIterator::next()
 
 bool SmbShareIterator::hasNext() const
 {
-    return d->enumerator->hasNext();
+    if (d->fromCache)
+        return d->cacheIndex < d->smbShares.count();
+
+    bool has = d->enumerator->hasNext();
+    if (!has && d->enumerated && !d->stored && !d->smbShares.isEmpty()) {
+        d->stored = true;
+        SmbShareCache::instance()->store(d->rootUrl, d->smbShares);
+    }
+    return has;
 }
 
 QString SmbShareIterator::fileName() const
@@ -91,7 +98,22 @@ QUrl SmbShareIterator::url() const
 
 bool SmbShareIterator::initIterator()
 {
+    if (SmbShareCache::isCacheable(d->rootUrl)) {
+        // 先显示缓存的共享列表，过期的列表在后台刷新
+        if (SmbShareCache::instance()->listing(d->rootUrl, &d->smbShares)) {
+            d->fromCache = true;
+            SmbShareCache::instance()->refreshAsync(d->rootUrl);
+            return true;
+        }
+
+        // 没有缓存时先探测主机，不可达的主机不再等待 gvfs 超时
+        if (!SmbHostProber::instance()->probe(d->rootUrl).result()) {
+            fmWarning() << "host is unreachable:" << d->rootUrl;
+            return false;
+        }
+    }
+
     if (d->enumerator)
-        return d->enumerator->initEnumerator(oneByOne());
-    return false;
+        d->enumerated = d->enumerator->initEnumerator(oneByOne());
+    return d->enumerated;
 }
@@ -32,6 +32,12 @@ private:
     SmbShareNodes smbShares;
     QScopedPointer<DFMIO::DEnumerator> enumerator { nullptr };
     QUrl rootUrl;
+
+    // 有缓存时直接返回缓存的共享，否则枚举完成后写入缓存
+    bool fromCache { false };
+    int cacheIndex { 0 };
+    bool enumerated { false };
+    bool stored { false };
 };
 
 DPSMBBROWSER_END_NAMESPACE
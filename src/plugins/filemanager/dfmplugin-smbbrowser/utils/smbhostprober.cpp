@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "smbhostprober.h"
+
+#include <dfm-base/dfm_global_defines.h>
+
+#include <QUrl>
+#include <QTcpSocket>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+DPSMBBROWSER_USE_NAMESPACE
+DFMBASE_USE_NAMESPACE
+
+static constexpr int kMaxParallelProbes { 4 };
+// 没有历史记录的主机使用最长的超时，之后按上次的连接耗时调整
+static constexpr int kMaxProbeTimeoutMs { 3000 };
+static constexpr int kMinProbeTimeoutMs { 500 };
+static constexpr qint64 kReachableTtlMs { 30 * 1000 };
+static constexpr qint64 kUnreachableTtlMs { 10 * 1000 };
+
+SmbHostProber *SmbHostProber::instance()
+{
+    static SmbHostProber ins;
+    return &ins;
+}
+
+SmbHostProber::SmbHostProber(QObject *parent)
+    : QObject(parent)
+{
+    pool.setMaxThreadCount(kMaxParallelProbes);
+}
+
+QFuture<bool> SmbHostProber::probe(const QUrl &url)
+{
+    const QString &key = hostKey(url);
+    if (key.isEmpty())
+        return QtConcurrent::run(&pool, [] { return true; });
+
+    QMutexLocker locker(&mutex);
+    auto result = results.constFind(key);
+    if (result != results.cend()) {
+        const qint64 ttl = result->reachable ? kReachableTtlMs : kUnreachableTtlMs;
+        if (result->age.elapsed() < ttl) {
+            const bool reachable = result->reachable;
+            return QtConcurrent::run(&pool, [reachable] { return reachable; });
+        }
+    }
+
+    auto pending = pendingProbes.constFind(key);
+    if (pending != pendingProbes.cend())
+        return pending.value();
+
+    const QString &host = url.host();
+    const int port = url.port(defaultPort(url.scheme()));
+    const int timeout = timeoutOf(key);
+    auto future = QtConcurrent::run(&pool, [this, key, host, port, timeout] {
+        return doProbe(key, host, port, timeout);
+    });
+    pendingProbes.insert(key, future);
+    return future;
+}
+
+void SmbHostProber::probeAsync(const QUrl &url, QObject *context, std::function<void(bool)> callback)
+{
+    auto watcher = new QFutureWatcher<bool>(context);
+    connect(watcher, &QFutureWatcher<bool>::finished, watcher, [watcher, callback] {
+        if (callback)
+            callback(watcher->result());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(probe(url));
+}
+
+QString SmbHostProber::hostKey(const QUrl &url)
+{
+    if (url.host().isEmpty())
+        return {};
+    return url.scheme() + "://" + url.host() + ":" + QString::number(url.port(defaultPort(url.scheme())));
+}
+
+int SmbHostProber::defaultPort(const QString &scheme)
+{
+    static const QHash<QString, int> kPorts {
+        { Global::Scheme::kSmb, 445 },
+        { Global::Scheme::kFtp, 21 },
+        { Global::Scheme::kSFtp, 22 },
+        { Global::Scheme::kDav, 80 },
+        { Global::Scheme::kDavs, 443 },
+        { Global::Scheme::kNfs, 2049 }
+    };
+    return kPorts.value(scheme, 445);
+}
+
+bool SmbHostProber::doProbe(const QString &key, const QString &host, int port, int timeout)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // 只有连接超时或网络不通才认为不可达：连接被拒绝说明主机在线，gvfs 会很快返回；
+    // 无法解析的名称（如 NetBIOS 名称）交给 gvfs 处理
+    QTcpSocket socket;
+    socket.connectToHost(host, quint16(port));
+    bool reachable = socket.waitForConnected(timeout);
+    if (!reachable) {
+        const auto error = socket.error();
+        reachable = error != QAbstractSocket::SocketTimeoutError && error != QAbstractSocket::NetworkError;
+    }
+    socket.abort();
+
+    ProbeResult result;
+    result.reachable = reachable;
+    result.connectMs = reachable ? timer.elapsed() : -1;
+    result.age.start();
+    fmDebug() << "probe" << key << "reachable:" << reachable << "elapsed:" << timer.elapsed() << "timeout:" << timeout;
+
+    QMutexLocker locker(&mutex);
+    results.insert(key, result);
+    pendingProbes.remove(key);
+    return reachable;
+}
+
+int SmbHostProber::timeoutOf(const QString &key) const
+{
+    auto result = results.constFind(key);
+    if (result == results.cend() || result->connectMs < 0)
+        return kMaxProbeTimeoutMs;
+    return int(qBound<qint64>(kMinProbeTimeoutMs, result->connectMs * 4, kMaxProbeTimeoutMs));
+}
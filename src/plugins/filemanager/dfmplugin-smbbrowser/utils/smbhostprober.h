@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SMBHOSTPROBER_H
+#define SMBHOSTPROBER_H
+
+#include "dfmplugin_smbbrowser_global.h"
+
+#include <QObject>
+#include <QFuture>
+#include <QHash>
+#include <QMutex>
+#include <QThreadPool>
+#include <QElapsedTimer>
+
+#include <functional>
+
+DPSMBBROWSER_BEGIN_NAMESPACE
+
+/*!
+ * \brief The SmbHostProber class checks whether the server of a network url
+ * accepts connections, without touching gvfs.
+ *
+ * Probes run in a small dedicated pool so that slow servers cannot occupy the
+ * global pool, concurrent probes of the same host are merged, and results are
+ * kept for a while. The timeout of each host follows its last connect time.
+ */
+class SmbHostProber : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(SmbHostProber)
+
+public:
+    static SmbHostProber *instance();
+
+    QFuture<bool> probe(const QUrl &url);
+    void probeAsync(const QUrl &url, QObject *context, std::function<void(bool)> callback);
+
+    static QString hostKey(const QUrl &url);
+    static int defaultPort(const QString &scheme);
+
+private:
+    explicit SmbHostProber(QObject *parent = nullptr);
+    bool doProbe(const QString &key, const QString &host, int port, int timeout);
+    int timeoutOf(const QString &key) const;   // requires mutex locked
+
+    struct ProbeResult
+    {
+        bool reachable { false };
+        qint64 connectMs { -1 };
+        QElapsedTimer age;
+    };
+
+    QThreadPool pool;
+    mutable QMutex mutex;
+    QHash<QString, QFuture<bool>> pendingProbes;
+    QHash<QString, ProbeResult> results;
+};
+
+DPSMBBROWSER_END_NAMESPACE
+
+#endif   // SMBHOSTPROBER_H
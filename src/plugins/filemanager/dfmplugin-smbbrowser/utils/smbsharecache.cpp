@@ -0,0 +1,298 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "smbsharecache.h"
+#include "smbhostprober.h"
+
+#include <dfm-base/dfm_global_defines.h>
+#include <dfm-base/base/standardpaths.h>
+
+#include <dfm-framework/dpf.h>
+
+#include <dfm-io/denumerator.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+DPSMBBROWSER_USE_NAMESPACE
+DFMBASE_USE_NAMESPACE
+USING_IO_NAMESPACE
+
+// 在这段时间内更新过的列表不再刷新，避免刷新视图后再次触发刷新
+static constexpr qint64 kFreshMs { 30 * 1000 };
+static constexpr int kMaxCachedHosts { 64 };
+
+namespace cache_keys {
+static constexpr char kUpdateTime[] { "updateTime" };
+static constexpr char kShares[] { "shares" };
+static constexpr char kUrl[] { "url" };
+static constexpr char kName[] { "name" };
+static constexpr char kIcon[] { "icon" };
+}   // namespace cache_keys
+
+static bool sameNodes(const SmbShareNodes &a, const SmbShareNodes &b)
+{
+    return std::equal(a.cbegin(), a.cend(), b.cbegin(), b.cend(),
+                      [](const SmbShareNode &x, const SmbShareNode &y) {
+                          return x.url == y.url && x.displayName == y.displayName && x.iconType == y.iconType;
+                      });
+}
+
+SmbShareCache *SmbShareCache::instance()
+{
+    static SmbShareCache ins;
+    return &ins;
+}
+
+SmbShareCache::SmbShareCache(QObject *parent)
+    : QObject(parent)
+{
+    cacheFile = StandardPaths::location(StandardPaths::kCachePath) + "/smbshares.json";
+    load();
+}
+
+bool SmbShareCache::listing(const QUrl &root, SmbShareNodes *nodes, qint64 *age) const
+{
+    QMutexLocker locker(&mutex);
+    auto iter = listings.constFind(keyOf(root));
+    if (iter == listings.cend())
+        return false;
+
+    if (nodes)
+        *nodes = iter->nodes;
+    if (age)
+        *age = QDateTime::currentMSecsSinceEpoch() - iter->updateTime;
+    return true;
+}
+
+bool SmbShareCache::hasListing(const QUrl &root) const
+{
+    return listing(root, nullptr);
+}
+
+void SmbShareCache::store(const QUrl &root, const SmbShareNodes &nodes, bool notify)
+{
+    const QString &key = keyOf(root);
+    if (key.isEmpty())
+        return;
+
+    bool changed = true;
+    {
+        QMutexLocker locker(&mutex);
+        auto iter = listings.find(key);
+        if (iter != listings.end()) {
+            changed = !sameNodes(iter->nodes, nodes);
+        } else if (listings.count() >= kMaxCachedHosts) {
+            auto oldest = std::min_element(listings.begin(), listings.end(),
+                                           [](const Listing &a, const Listing &b) { return a.updateTime < b.updateTime; });
+            listings.erase(oldest);
+        }
+
+        Listing &cached = listings[key];
+        cached.nodes = nodes;
+        cached.updateTime = QDateTime::currentMSecsSinceEpoch();
+        save();
+    }
+
+    if (changed && notify) {
+        fmInfo() << "share listing changed, refresh views of" << root;
+        dpfSlotChannel->push("dfmplugin_workspace", "slot_RefreshDir", QList<QUrl> { root });
+    }
+}
+
+void SmbShareCache::addShare(const QUrl &shareUrl)
+{
+    QUrl root(shareUrl);
+    root.setPath("");
+    const QString &key = keyOf(root);
+    if (key.isEmpty())
+        return;
+
+    QString url = shareUrl.toString();
+    while (url.endsWith("/"))
+        url.chop(1);
+
+    QMutexLocker locker(&mutex);
+    Listing &cached = listings[key];   // a partial listing is created with time 0, so it is refreshed on first use
+    bool exists = std::any_of(cached.nodes.cbegin(), cached.nodes.cend(), [&url](const SmbShareNode &node) {
+        return node.url == url || node.url == url + "/";
+    });
+    if (exists)
+        return;
+
+    SmbShareNode node;
+    node.url = url;
+    node.displayName = QUrl(url).fileName();
+    node.iconType = "folder-remote";
+    cached.nodes.append(node);
+    save();
+}
+
+void SmbShareCache::remove(const QUrl &root)
+{
+    QMutexLocker locker(&mutex);
+    if (listings.remove(keyOf(root)) > 0)
+        save();
+}
+
+void SmbShareCache::refreshAsync(const QUrl &root, bool force)
+{
+    // 可能在遍历线程中调用，回到主线程发起探测和刷新
+    QMetaObject::invokeMethod(this, [this, root, force] { doRefresh(root, force); });
+}
+
+bool SmbShareCache::isCacheable(const QUrl &url)
+{
+    return url.scheme() == Global::Scheme::kSmb
+            && !url.host().isEmpty()
+            && (url.path().isEmpty() || url.path() == "/");
+}
+
+SmbShareNode SmbShareCache::makeNode(const QUrl &root, const QSharedPointer<DFileInfo> &info)
+{
+    // TODO(xust) TODO(lanxs) if url contains '#', wrong info is returned
+    QUrl url = QUrl::fromPercentEncoding(info->attribute(DFileInfo::AttributeID::kStandardTargetUri).toString().toLocal8Bit());
+    QStringList icons = info->attribute(DFileInfo::AttributeID::kStandardIcon).toStringList();
+
+    int serverPort = root.port();
+    if (serverPort != -1)
+        url.setPort(serverPort);
+
+    SmbShareNode node;
+    node.url = url.toString();
+    node.iconType = icons.count() > 0 ? icons.first() : "folder-remote";
+    node.displayName = info->attribute(DFileInfo::AttributeID::kStandardDisplayName).toString();
+    return node;
+}
+
+void SmbShareCache::doRefresh(const QUrl &root, bool force)
+{
+    const QString &key = keyOf(root);
+    if (key.isEmpty())
+        return;
+
+    {
+        QMutexLocker locker(&mutex);
+        if (refreshing.contains(key))
+            return;
+        auto iter = listings.constFind(key);
+        if (!force && iter != listings.cend() && QDateTime::currentMSecsSinceEpoch() - iter->updateTime < kFreshMs)
+            return;
+        refreshing.insert(key);
+    }
+
+    SmbHostProber::instance()->probeAsync(root, this, [this, root, key](bool reachable) {
+        if (!reachable) {
+            fmInfo() << "host is unreachable, keep the cached shares of" << root;
+            QMutexLocker locker(&mutex);
+            refreshing.remove(key);
+            return;
+        }
+
+        using FetchResult = QPair<bool, SmbShareNodes>;
+        auto watcher = new QFutureWatcher<FetchResult>(this);
+        connect(watcher, &QFutureWatcher<FetchResult>::finished, this, [this, watcher, root, key] {
+            const FetchResult &result = watcher->result();
+            watcher->deleteLater();
+            {
+                QMutexLocker locker(&mutex);
+                refreshing.remove(key);
+            }
+            // 未授权或枚举失败时保留原来的列表
+            if (result.first && !result.second.isEmpty())
+                store(root, result.second, true);
+        });
+        watcher->setFuture(QtConcurrent::run([root] {
+            SmbShareNodes nodes;
+            bool ok = fetch(root, &nodes);
+            return FetchResult { ok, nodes };
+        }));
+    });
+}
+
+bool SmbShareCache::fetch(const QUrl &root, SmbShareNodes *nodes)
+{
+    Q_ASSERT(nodes);
+    DEnumerator enumerator(root);
+    if (!enumerator.initEnumerator(true)) {
+        fmWarning() << "cannot enumerate shares of" << root;
+        return false;
+    }
+
+    while (enumerator.hasNext()) {
+        enumerator.next();
+        auto info = enumerator.fileInfo();
+        if (info)
+            nodes->append(makeNode(root, info));
+    }
+    return true;
+}
+
+QString SmbShareCache::keyOf(const QUrl &url)
+{
+    if (url.host().isEmpty())
+        return {};
+    QString key = url.scheme() + "://" + url.host().toLower();
+    if (url.port() != -1)
+        key += ":" + QString::number(url.port());
+    return key;
+}
+
+void SmbShareCache::load()
+{
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    using namespace cache_keys;
+    const QJsonObject &root = QJsonDocument::fromJson(file.readAll()).object();
+    QMutexLocker locker(&mutex);
+    for (auto iter = root.begin(); iter != root.end(); ++iter) {
+        const QJsonObject &obj = iter.value().toObject();
+        Listing cached;
+        cached.updateTime = qint64(obj.value(kUpdateTime).toDouble());
+        const QJsonArray &shares = obj.value(kShares).toArray();
+        for (const auto &share : shares) {
+            const QJsonObject &item = share.toObject();
+            SmbShareNode node;
+            node.url = item.value(kUrl).toString();
+            node.displayName = item.value(kName).toString();
+            node.iconType = item.value(kIcon).toString();
+            cached.nodes.append(node);
+        }
+        listings.insert(iter.key(), cached);
+    }
+    fmDebug() << "smb share listings loaded:" << listings.keys();
+}
+
+void SmbShareCache::save() const
+{
+    using namespace cache_keys;
+    QJsonObject root;
+    for (auto iter = listings.cbegin(); iter != listings.cend(); ++iter) {
+        QJsonArray shares;
+        for (const auto &node : iter->nodes) {
+            shares.append(QJsonObject { { kUrl, node.url },
+                                        { kName, node.displayName },
+                                        { kIcon, node.iconType } });
+        }
+        root.insert(iter.key(), QJsonObject { { kUpdateTime, double(iter->updateTime) },
+                                              { kShares, shares } });
+    }
+
+    QDir().mkpath(QFileInfo(cacheFile).absolutePath());
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        fmWarning() << "cannot save smb share listings:" << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+}
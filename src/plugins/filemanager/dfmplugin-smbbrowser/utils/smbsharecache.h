@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SMBSHARECACHE_H
+#define SMBSHARECACHE_H
+
+#include "dfmplugin_smbbrowser_global.h"
+#include "typedefines.h"
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QUrl>
+
+#include <dfm-io/dfileinfo.h>
+
+DPSMBBROWSER_BEGIN_NAMESPACE
+
+/*!
+ * \brief The SmbShareCache class keeps the share listing of each smb host and
+ * persists it to disk.
+ *
+ * A cached listing is shown at once when a host is opened, even if the host is
+ * offline. Stale listings are refreshed in the background after a reachability
+ * probe, and the views showing the host are refreshed when the listing changed.
+ */
+class SmbShareCache : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(SmbShareCache)
+
+public:
+    static SmbShareCache *instance();
+
+    bool listing(const QUrl &root, SmbShareNodes *nodes, qint64 *age = nullptr) const;
+    bool hasListing(const QUrl &root) const;
+    void store(const QUrl &root, const SmbShareNodes &nodes, bool notify = false);
+    void addShare(const QUrl &shareUrl);
+    void remove(const QUrl &root);
+    void refreshAsync(const QUrl &root, bool force = false);
+
+    static bool isCacheable(const QUrl &url);
+    static SmbShareNode makeNode(const QUrl &root, const QSharedPointer<DFMIO::DFileInfo> &info);
+
+private:
+    explicit SmbShareCache(QObject *parent = nullptr);
+    void doRefresh(const QUrl &root, bool force);
+    static bool fetch(const QUrl &root, SmbShareNodes *nodes);
+    static QString keyOf(const QUrl &url);
+
+    void load();
+    void save() const;   // requires mutex locked
+
+    struct Listing
+    {
+        SmbShareNodes nodes;
+        qint64 updateTime { 0 };   // msecs since epoch, 0 means never fetched
+    };
+
+    mutable QMutex mutex;
+    QHash<QString, Listing> listings;
+    QSet<QString> refreshing;
+    QString cacheFile;
+};
+
+DPSMBBROWSER_END_NAMESPACE
+
+#endif   // SMBSHARECACHE_H
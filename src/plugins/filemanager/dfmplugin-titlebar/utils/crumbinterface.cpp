@@ -13,9 +13,29 @@
 
 #include <dfm-framework/event/event.h>
 
+#include <QDateTime>
+
 using namespace dfmplugin_titlebar;
 DFMBASE_USE_NAMESPACE
 
+namespace {
+// 目录列表的短时缓存，在同一目录下连续输入或回退时不必重新枚举
+constexpr qint64 kCompletionCacheTTL { 5000 };
+constexpr int kCompletionCacheCount { 16 };
+
+struct CompletionCacheEntry
+{
+    QStringList names;   // 已排序
+    qint64 timestamp { 0 };
+};
+
+QHash<QUrl, CompletionCacheEntry> &completionCache()
+{
+    static QHash<QUrl, CompletionCacheEntry> cache;
+    return cache;
+}
+}
+
 CrumbInterface::CrumbInterface(QObject *parent)
     : QObject(parent)
 {
@@ -90,17 +110,41 @@ QList<CrumbData> CrumbInterface::seprateUrl(const QUrl &url)
  * function will start a completion request and the completion list item will be sent
  * via signal completionFound. When user no longer need current completion list and
  * the transmission isn't completed, you should call cancelCompletionListTransmission.
- * When transmission completed, it will send completionListTransmissionCompleted signal.
+ * When transmission completed, it will send the whole sorted list via completionListReady
+ * and then the completionListTransmissionCompleted signal. Listings are cached for a few
+ * seconds, a cached listing is sent in one completionFound group followed by the same
+ * signals as an uncached listing.
  *
  * \sa completionFound, completionListTransmissionCompleted, cancelCompletionListTransmission
  */
 void CrumbInterface::requestCompletionList(const QUrl &url)
 {
+    const quint64 serial = ++completionSerial;
     if (folderCompleterJobPointer) {
         folderCompleterJobPointer->disconnect();
         folderCompleterJobPointer->stopAndDeleteLater();
         folderCompleterJobPointer->setParent(nullptr);
     }
+    completionUrl = url;
+    completionNames.clear();
+
+    auto &cache = completionCache();
+    auto it = cache.constFind(url);
+    if (it != cache.constEnd() && QDateTime::currentMSecsSinceEpoch() - it->timestamp < kCompletionCacheTTL) {
+        const QStringList names = it->names;
+        QMetaObject::invokeMethod(
+                this, [this, serial, names]() {
+                    if (serial != completionSerial)
+                        return;
+                    // 只监听 completionFound 的调用方（如面包屑子目录弹窗）同样需要拿到列表
+                    emit completionFound(names);
+                    emit completionListReady(names);
+                    emit completionListTransmissionCompleted();
+                },
+                Qt::QueuedConnection);
+        return;
+    }
+
     folderCompleterJobPointer = new TraversalDirThread(url, QStringList(),
                                                        QDir::AllDirs | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::NoIteratorFlags);
     folderCompleterJobPointer->setQueryAttributes("standard::standard::name");
@@ -113,7 +157,10 @@ void CrumbInterface::requestCompletionList(const QUrl &url)
 
     connect(
             folderCompleterJobPointer.data(), &TraversalDirThread::finished, this,
-            [this]() {
+            [this, serial]() {
+                if (serial != completionSerial)
+                    return;
+                finishCompletionList();
                 emit completionListTransmissionCompleted();
             },
             Qt::QueuedConnection);
@@ -130,16 +177,43 @@ void CrumbInterface::requestCompletionList(const QUrl &url)
  */
 void CrumbInterface::cancelCompletionListTransmission()
 {
+    ++completionSerial;
     if (folderCompleterJobPointer)
         folderCompleterJobPointer->stop();
 }
 
 void CrumbInterface::onUpdateChildren(QList<QUrl> children)
 {
+    // 已被新的请求替换的枚举线程，其排队中的结果直接丢弃
+    if (sender() != folderCompleterJobPointer.data())
+        return;
+
     QStringList list;
 
     for (const auto &child : children) {
         list.append(child.fileName());
     }
+    completionNames.append(list);
     emit completionFound(list);
 }
+
+void CrumbInterface::finishCompletionList()
+{
+    // 排序后 QCompleter 可以按前缀二分查找，目录再大每次按键的过滤开销也是常数级
+    std::sort(completionNames.begin(), completionNames.end());
+    completionNames.erase(std::unique(completionNames.begin(), completionNames.end()), completionNames.end());
+    completionNames.removeAll(QString());
+
+    auto &cache = completionCache();
+    if (cache.size() >= kCompletionCacheCount && !cache.contains(completionUrl)) {
+        auto oldest = cache.begin();
+        for (auto it = cache.begin(); it != cache.end(); ++it) {
+            if (it->timestamp < oldest->timestamp)
+                oldest = it;
+        }
+        cache.erase(oldest);
+    }
+    cache.insert(completionUrl, { completionNames, QDateTime::currentMSecsSinceEpoch() });
+
+    emit completionListReady(completionNames);
+}
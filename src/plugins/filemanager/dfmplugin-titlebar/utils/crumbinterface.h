@@ -42,14 +42,20 @@ signals:
     void keepAddressBar(const QUrl &url);
     void hideAddrAndUpdateCrumbs(const QUrl &url);
     void completionFound(const QStringList &completions);   //< emit multiple times with less or equials to 10 items in a group.
+    void completionListReady(const QStringList &completions);   //< emit once with the whole sorted list before transmission completed.
     void completionListTransmissionCompleted();   //< emit when all avaliable completions has been sent.
 
 private slots:
     void onUpdateChildren(QList<QUrl> children);
 
 private:
+    void finishCompletionList();
+
     QString curScheme;
     QPointer<DFMBASE_NAMESPACE::TraversalDirThread> folderCompleterJobPointer;
+    QUrl completionUrl;
+    QStringList completionNames;
+    quint64 completionSerial { 0 };   // 每次请求或取消时递增，丢弃过期的结果
 };
 
 }
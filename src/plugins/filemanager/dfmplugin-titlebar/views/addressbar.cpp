@@ -12,6 +12,7 @@
 #include <dfm-base/widgets/filemanagerwindowsmanager.h>
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/utils/fileutils.h>
+#include <dfm-base/utils/protocolutils.h>
 #include <dfm-base/base/configs/dconfig/dconfigmanager.h>
 #include <dfm-base/base/application/application.h>
 
@@ -157,6 +158,9 @@ void AddressBarPrivate::setCompleter(QCompleter *c)
 
 void AddressBarPrivate::clearCompleterModel()
 {
+    // 枚举过程中分批追加的条目是无序的，完整列表到达后再切换为有序模型
+    if (urlCompleter)
+        urlCompleter->setModelSorting(QCompleter::UnsortedModel);
     completerModel.setStringList(QStringList());
 }
 
@@ -232,6 +236,13 @@ void AddressBarPrivate::appendToCompleterModel(const QStringList &stringList)
     }
 }
 
+void AddressBarPrivate::onCompletionListReady(const QStringList &completions)
+{
+    // 列表已按区分大小写的顺序排好，QCompleter 按前缀二分查找，不再逐项过滤
+    urlCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
+    completerModel.setStringList(completions);
+}
+
 void AddressBarPrivate::onTravelCompletionListFinished()
 {
     if (urlCompleter->completionCount() > 0) {
@@ -267,6 +278,7 @@ void AddressBarPrivate::requestCompleteByUrl(const QUrl &url)
         crumbController->setParent(q);
         // connections
         connect(crumbController, &CrumbInterface::completionFound, this, &AddressBarPrivate::appendToCompleterModel);
+        connect(crumbController, &CrumbInterface::completionListReady, this, &AddressBarPrivate::onCompletionListReady);
         connect(crumbController, &CrumbInterface::completionListTransmissionCompleted, this, &AddressBarPrivate::onTravelCompletionListFinished);
     }
     crumbController->requestCompletionList(url);
@@ -275,6 +287,7 @@ void AddressBarPrivate::requestCompleteByUrl(const QUrl &url)
 void AddressBarPrivate::completeIpAddress(const QString &text)
 {
     // set completion prefix.
+    urlCompleter->setModelSorting(QCompleter::UnsortedModel);
     urlCompleter->setCompletionPrefix("");
 
     // Set Base String
@@ -305,9 +318,12 @@ void AddressBarPrivate::completeIpAddress(const QString &text)
 void AddressBarPrivate::completeLocalPath(const QString &text, const QUrl &url, int slashIndex)
 {
     // Check if (now is parent) url exist.
-    auto info = InfoFactory::create<FileInfo>(url);
-    if (url.isValid() && info && !info->exists())
-        return;
+    // 远程目录在主线程上检查会阻塞输入，交给后台枚举，不存在时结果为空
+    if (!ProtocolUtils::isRemoteFile(url)) {
+        auto info = InfoFactory::create<FileInfo>(url);
+        if (url.isValid() && info && !info->exists())
+            return;
+    }
 
     // Check if we should start a new completion transmission.
     if (this->completerBaseString == text.left(slashIndex + 1)
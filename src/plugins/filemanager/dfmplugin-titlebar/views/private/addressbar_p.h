@@ -96,6 +96,7 @@ public Q_SLOTS:
     void updateIndicatorIcon();
     void onCompletionModelCountChanged();
     void appendToCompleterModel(const QStringList &stringList);
+    void onCompletionListReady(const QStringList &completions);
     void onTravelCompletionListFinished();
     void onIndicatorTriggerd();
 
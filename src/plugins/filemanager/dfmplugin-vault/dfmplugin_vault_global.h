@@ -165,6 +165,8 @@ inline constexpr char kAcEditVaultSetUnlockRepeatPassword[] { "edit_vault_setUnl
 inline constexpr char kAcLabelVaultSetUnlockHint[] { "label_vault_setUnlock_hint" };
 inline constexpr char kAcEditVaultSetUnlockHint[] { "edit_vault_setUnlock_hint" };
 inline constexpr char kAcLabelVaultSetUnlockText[] { "label_vault_setUnlock_text" };
+inline constexpr char kAcLabelVaultSetUnlockBlockSize[] { "label_vault_setUnlock_blockSize" };
+inline constexpr char kAcComboVaultSetUnlockBlockSize[] { "combo_vault_setUnlock_blockSize" };
 inline constexpr char kAcBtnVaultSetUnlockNext[] { "btn_vault_setUnlock_next" };
 
 inline constexpr char kAcLabelVaultSaveKeyTitle[] { "label_vault_saveKey_Title" };
@@ -233,6 +235,12 @@ enum class Connectivity {
 };
 
 inline constexpr char kVaultDConfigName[] { "org.deepin.dde.file-manager.vault" };
+inline constexpr char kVaultDConfigKeyBlockSize[] { "vaultBlockSize" };
+
+// cryfs 块大小，单位字节，只在创建保险箱时生效
+inline constexpr int kVaultDefaultBlockSize { 32 * 1024 };
+inline constexpr int kVaultMinBlockSize { 4 * 1024 };
+inline constexpr int kVaultMaxBlockSize { 4 * 1024 * 1024 };
 }
 
 #endif   // DFMPLUGIN_VAULT_GLOBAL_H
@@ -70,6 +70,8 @@ void VaultEventReceiver::connectEvent()
     dpfHookSequence->follow("dfmplugin_fileoperations", "hook_Operation_SetPermission", VaultFileHelper::instance(), &VaultFileHelper::setPermision);
     dpfHookSequence->follow("dfmplugin_propertydialog", "hook_PermissionView_Ash", this, &VaultEventReceiver::handlePermissionViewAsh);
     dpfHookSequence->follow("dfmplugin_tag", "hook_CanTaged", this, &VaultEventReceiver::handleFileCanTaged);
+
+    dpfSlotChannel->connect("dfmplugin_vault", "slot_Vault_UnlockPath", this, &VaultEventReceiver::handleVaultUnlockPath);
 }
 
 void VaultEventReceiver::computerOpenItem(quint64 winId, const QUrl &url)
@@ -241,3 +243,8 @@ bool VaultEventReceiver::handleFileCanTaged(const QUrl &url, bool *canTag)
 
     return false;
 }
+
+QString VaultEventReceiver::handleVaultUnlockPath()
+{
+    return PathManager::vaultUnlockPath();
+}
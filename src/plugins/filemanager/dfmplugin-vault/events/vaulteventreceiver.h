@@ -34,6 +34,7 @@ public slots:
     bool fileDropHandleWithAction(const QList<QUrl> &fromUrls, const QUrl &toUrl, Qt::DropAction *action);
     bool handlePermissionViewAsh(const QUrl &url, bool *isAsh);
     bool handleFileCanTaged(const QUrl &url, bool *canTag);
+    QString handleVaultUnlockPath();
 };
 }
 #endif   // VAULTEVENTRECEIVER_H
@@ -20,6 +20,7 @@ inline constexpr char kConfigKeyUseUserPassWord[] { "use_user_password" };
 inline constexpr char kConfigVaultVersion[] { "new" };
 inline constexpr char kConfigVaultVersion1050[] { "1050" };
 inline constexpr char kConfigKeyAlgoName[] { "algoName" };
+inline constexpr char kConfigKeyBlockSize[] { "blockSize" };
 inline constexpr char kConfigKeyEncryptionMethod[] { "encryption_method" };
 inline constexpr char kConfigValueMethodKey[] { "key_encryption" };
 inline constexpr char kConfigValueMethodTransparent[] { "transparent_encryption" };
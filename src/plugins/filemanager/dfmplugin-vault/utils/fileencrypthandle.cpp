@@ -72,6 +72,11 @@ void FileEncryptHandle::createVault(const QString &lockBaseDir, const QString &u
     if (!(createDirIfNotExist(lockBaseDir) && createDirIfNotExist(unlockFileDir)))
         return;
 
+    if (!isValidBlockSize(blockSize)) {
+        fmWarning() << "Vault: invalid block size:" << blockSize << ", use default";
+        blockSize = kVaultDefaultBlockSize;
+    }
+
     d->mutex->lock();
     d->activeState.insert(1, static_cast<int>(ErrorCode::kSuccess));
 
@@ -79,6 +84,7 @@ void FileEncryptHandle::createVault(const QString &lockBaseDir, const QString &u
     DConfigManager::instance()->setValue(kDefaultCfgPath, kGroupPolicyKeyVaultAlgoName, algoName);
     VaultConfig config;
     config.set(kConfigNodeName, kConfigKeyAlgoName, QVariant(algoName));
+    config.set(kConfigNodeName, kConfigKeyBlockSize, QVariant(blockSize));
 
     int flg = d->runVaultProcess(lockBaseDir, unlockFileDir, passWord, type, blockSize);
     if (d->activeState.value(1) != static_cast<int>(ErrorCode::kSuccess)) {
@@ -235,6 +241,19 @@ EncryptType FileEncryptHandle::encryptAlgoTypeOfGroupPolicy()
     return d->encryptAlgoTypeOfGroupPolicy();
 }
 
+int FileEncryptHandle::blockSizeOfConfig()
+{
+    return d->blockSizeOfConfig();
+}
+
+/*!
+ * \brief 块大小只接受 4KiB ~ 4MiB 之间的 2 的幂
+ */
+bool FileEncryptHandle::isValidBlockSize(int blockSize)
+{
+    return blockSize >= kVaultMinBlockSize && blockSize <= kVaultMaxBlockSize && (blockSize & (blockSize - 1)) == 0;
+}
+
 /*!
  * \brief 进程执行错误时执行并发送signalReadError信号
  * \note
@@ -571,6 +590,23 @@ EncryptType FileEncryptHandlerPrivate::encryptAlgoTypeOfGroupPolicy()
     return type;
 }
 
+/*!
+ * \brief 读取配置中的 cryfs 块大小
+ * \note
+ *  块越大，顺序读写时 FUSE 往返和逐块加解密的次数越少，但每个小文件至少占用一个块。
+ *  只接受 4KiB ~ 4MiB 之间的 2 的幂，非法值回退到默认的 32KiB。
+ */
+int FileEncryptHandlerPrivate::blockSizeOfConfig()
+{
+    bool ok { false };
+    const int blockSize = DConfigManager::instance()->value(kVaultDConfigName, kVaultDConfigKeyBlockSize, kVaultDefaultBlockSize).toInt(&ok);
+    if (!ok || !FileEncryptHandle::isValidBlockSize(blockSize)) {
+        fmWarning() << "Vault: invalid block size in config:" << blockSize << ", use default";
+        return kVaultDefaultBlockSize;
+    }
+    return blockSize;
+}
+
 void FileEncryptHandlerPrivate::setEnviroment(const QPair<QString, QString> &value)
 {
     // Just append enviroment value, not replace.
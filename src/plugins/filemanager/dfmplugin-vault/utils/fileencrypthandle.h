@@ -21,7 +21,7 @@ public:
     static FileEncryptHandle *instance();
 
     void createVault(const QString &lockBaseDir, const QString &unlockFileDir, const QString &DSecureString,
-                     EncryptType type = EncryptType::AES_256_GCM, int blockSize = 32768);
+                     EncryptType type = EncryptType::AES_256_GCM, int blockSize = kVaultDefaultBlockSize);
     bool unlockVault(const QString &lockBaseDir, const QString &unlockFileDir, const QString &DSecureString);
     bool lockVault(QString unlockFileDir, bool isForced);
     bool createDirIfNotExist(QString path);
@@ -29,6 +29,8 @@ public:
     bool updateState(VaultState curState);
 
     EncryptType encryptAlgoTypeOfGroupPolicy();
+    int blockSizeOfConfig();
+    static bool isValidBlockSize(int blockSize);
 signals:
     void signalReadError(QString error);
     void signalReadOutput(QString msg);
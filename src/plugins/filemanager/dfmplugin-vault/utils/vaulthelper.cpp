@@ -316,10 +316,17 @@ QUrl VaultHelper::vaultToLocalUrl(const QUrl &url)
     }
 }
 
-void VaultHelper::createVault(QString &password)
+/*!
+ * \brief 创建保险箱
+ * \param password   保险箱密码
+ * \param blockSize  创建时选择的 cryfs 块大小，未选择或非法时使用配置中的块大小
+ */
+void VaultHelper::createVault(QString &password, int blockSize)
 {
     const EncryptType &type = FileEncryptHandle::instance()->encryptAlgoTypeOfGroupPolicy();
-    FileEncryptHandle::instance()->createVault(PathManager::vaultLockPath(), PathManager::vaultUnlockPath(), password, type);
+    if (!FileEncryptHandle::isValidBlockSize(blockSize))
+        blockSize = FileEncryptHandle::instance()->blockSizeOfConfig();
+    FileEncryptHandle::instance()->createVault(PathManager::vaultLockPath(), PathManager::vaultUnlockPath(), password, type, blockSize);
 }
 
 bool VaultHelper::unlockVault(const QString &password)
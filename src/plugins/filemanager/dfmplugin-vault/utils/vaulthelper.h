@@ -83,7 +83,7 @@ public:
 public slots:
     void slotlockVault(int state);
 
-    void createVault(QString &password);
+    void createVault(QString &password, int blockSize = 0);
 
     bool unlockVault(const QString &password);
 
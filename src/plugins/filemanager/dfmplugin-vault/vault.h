@@ -21,6 +21,9 @@ class Vault : public dpf::Plugin
     DPF_EVENT_REG_SIGNAL(signal_ReportLog_Commit)
     DPF_EVENT_REG_SIGNAL(signal_ReportLog_MenuData)
 
+    // slot events
+    DPF_EVENT_REG_SLOT(slot_Vault_UnlockPath)
+
 public:
     virtual void initialize() override;
     virtual bool start() override;
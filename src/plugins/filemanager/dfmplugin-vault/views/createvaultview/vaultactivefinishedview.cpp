@@ -238,7 +238,8 @@ void VaultActiveFinishedView::slotCheckAuthorizationFinished(bool result)
                         fmWarning() << "Vault: Get encryption method failed, can't create vault!";
                     }
                     if (!password.isEmpty()) {
-                        VaultHelper::instance()->createVault(password);
+                        const int blockSize = config.get(kConfigNodeName, kConfigKeyBlockSize, QVariant(0)).toInt();
+                        VaultHelper::instance()->createVault(password, blockSize);
                         OperatorCenter::getInstance()->clearSaltAndPasswordCipher();
                     } else {
                         fmWarning() << "Vault: Get password is empty, failed to create the vault!";
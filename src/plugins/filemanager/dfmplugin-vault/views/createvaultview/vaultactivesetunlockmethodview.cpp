@@ -6,6 +6,7 @@
 #include "utils/encryption/operatorcenter.h"
 #include "utils/vaulthelper.h"
 #include "utils/encryption/vaultconfig.h"
+#include "utils/fileencrypthandle.h"
 
 #include <dfm-framework/event/event.h>
 
@@ -79,6 +80,11 @@ void VaultActiveSetUnlockMethodView::initUi()
     transEncryptTextLay->setContentsMargins(10, 0, 0, 0);
     transEncryptTextLay->addWidget(transEncryptionText);
 
+    // cryfs block size, only takes effect when the vault is created
+    blockSizeLabel = new DLabel(tr("Block size"), this);
+    blockSizeCombo = new DComboBox(this);
+    initBlockSizeCombo();
+
     nextBtn = new DSuggestButton(tr("Next"), this);
     nextBtn->setFixedWidth(200);
     nextBtn->setEnabled(false);
@@ -99,6 +105,9 @@ void VaultActiveSetUnlockMethodView::initUi()
     gridLayout->addWidget(passwordHintLabel, 3, 0, 1, 1, Qt::AlignLeft);
     gridLayout->addWidget(tipsEdit, 3, 1, 1, 5);
 
+    gridLayout->addWidget(blockSizeLabel, 4, 0, 1, 1, Qt::AlignLeft);
+    gridLayout->addWidget(blockSizeCombo, 4, 1, 1, 5);
+
     QVBoxLayout *play = new QVBoxLayout(this);
     play->setContentsMargins(0, 0, 0, 0);
     play->addWidget(titleLabel);
@@ -120,10 +129,29 @@ void VaultActiveSetUnlockMethodView::initUi()
     AddATTag(qobject_cast<QWidget *>(passwordHintLabel), AcName::kAcLabelVaultSetUnlockHint);
     AddATTag(qobject_cast<QWidget *>(tipsEdit), AcName::kAcEditVaultSetUnlockHint);
     AddATTag(qobject_cast<QWidget *>(transEncryptionText), AcName::kAcLabelVaultSetUnlockText);
+    AddATTag(qobject_cast<QWidget *>(blockSizeLabel), AcName::kAcLabelVaultSetUnlockBlockSize);
+    AddATTag(qobject_cast<QWidget *>(blockSizeCombo), AcName::kAcComboVaultSetUnlockBlockSize);
     AddATTag(qobject_cast<QWidget *>(nextBtn), AcName::kAcBtnVaultSetUnlockNext);
 #endif
 }
 
+void VaultActiveSetUnlockMethodView::initBlockSizeCombo()
+{
+    // 块越大顺序读写越快，但每个小文件至少占用一个块
+    blockSizeCombo->addItem(tr("32 KiB (recommended)"), kVaultDefaultBlockSize);
+    blockSizeCombo->addItem(tr("256 KiB"), 256 * 1024);
+    blockSizeCombo->addItem(tr("1 MiB"), 1024 * 1024);
+    blockSizeCombo->addItem(tr("4 MiB"), kVaultMaxBlockSize);
+
+    const int blockSize = FileEncryptHandle::instance()->blockSizeOfConfig();
+    int index = blockSizeCombo->findData(blockSize);
+    if (index < 0) {
+        blockSizeCombo->addItem(tr("%1 KiB").arg(blockSize / 1024), blockSize);
+        index = blockSizeCombo->count() - 1;
+    }
+    blockSizeCombo->setCurrentIndex(index);
+}
+
 void VaultActiveSetUnlockMethodView::initUiForSizeMode()
 {
 #ifdef DTKWIDGET_CLASS_DSizeMode
@@ -262,6 +290,7 @@ void VaultActiveSetUnlockMethodView::slotNextBtnClicked()
 {
     VaultConfig config;
     config.set(kConfigNodeName, kConfigKeyUseUserPassWord, QVariant("Yes"));
+    config.set(kConfigNodeName, kConfigKeyBlockSize, blockSizeCombo->currentData());
 
     if (typeCombo->currentIndex() == 0) {   // key encryption
         QString strPassword = passwordEdit->text();
@@ -63,6 +63,8 @@ private:
     void initUi();
     void initUiForSizeMode();
     void initConnect();
+    //! 初始化块大小选项，默认选中配置中的块大小
+    void initBlockSizeCombo();
     //! 校验密码是否符合规则
     bool checkPassword(const QString &passwordEdit);
     //! 校验重复密码框是否符合规则
@@ -86,6 +88,9 @@ private:
     DTK_WIDGET_NAMESPACE::DLabel *transEncryptionText { nullptr };
     QVBoxLayout *transEncryptTextLay { nullptr };
 
+    DTK_WIDGET_NAMESPACE::DLabel *blockSizeLabel { nullptr };
+    DTK_WIDGET_NAMESPACE::DComboBox *blockSizeCombo { nullptr };
+
     DTK_WIDGET_NAMESPACE::DSuggestButton *nextBtn { nullptr };
 
     QGridLayout *gridLayout { nullptr };
@@ -129,6 +129,8 @@ void WorkspaceEventReceiver::initConnection()
                             WorkspaceEventReceiver::instance(), &WorkspaceEventReceiver::handleSetSort);
     dpfSlotChannel->connect(kCurrentEventSpace, "slot_Model_RegisterDataCache",
                             WorkspaceEventReceiver::instance(), &WorkspaceEventReceiver::handleRegisterDataCache);
+    dpfSlotChannel->connect(kCurrentEventSpace, "slot_Model_KeepRecentRoots",
+                            WorkspaceEventReceiver::instance(), &WorkspaceEventReceiver::handleKeepRecentRoots);
     dpfSlotChannel->connect(kCurrentEventSpace, "slot_View_AboutToChangeViewWidth",
                             WorkspaceEventReceiver::instance(), &WorkspaceEventReceiver::handleAboutToChangeViewWidth);
 
@@ -398,6 +400,11 @@ void WorkspaceEventReceiver::handleRegisterDataCache(const QString &scheme)
     //    FileModelManager::instance()->registerDataCache(scheme);
 }
 
+void WorkspaceEventReceiver::handleKeepRecentRoots(int count)
+{
+    FileDataManager::instance()->setRecentRootLimit(count);
+}
+
 void WorkspaceEventReceiver::handleSetAlwaysOpenInCurrentWindow(const quint64 windowID)
 {
     WorkspaceHelper::instance()->setAlwaysOpenInCurrentWindow(windowID);
@@ -74,6 +74,7 @@ public slots:
     void handleSetCustomFilterCallback(quint64 windowID, const QUrl &url, const QVariant callback);
     bool handleRegisterRoutePrehandle(const QString &scheme, const FileViewRoutePrehaldler &prehandler);
     void handleRegisterDataCache(const QString &scheme);
+    void handleKeepRecentRoots(int count);
     void handleSetAlwaysOpenInCurrentWindow(const quint64 windowID);
     void handleAboutToChangeViewWidth(const quint64 windowID, int deltaWidth);
 
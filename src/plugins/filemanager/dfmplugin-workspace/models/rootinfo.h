@@ -59,6 +59,8 @@ public:
     QStringList connectTokens() const { return connectedTokens; }
 
     bool canDelete() const;
+    bool isIdle() const { return traversalThreads.isEmpty(); }
+    void setCanCache(const bool cache) { canCache = cache; }
 
 Q_SIGNALS:
 
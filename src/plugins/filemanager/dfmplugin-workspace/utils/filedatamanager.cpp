@@ -26,6 +26,7 @@ FileDataManager *FileDataManager::instance()
 
 RootInfo *FileDataManager::fetchRoot(const QUrl &url)
 {
+    touchRecentRoot(url);
     if (rootInfoMap.contains(url))
         return rootInfoMap.value(url);
 
@@ -101,6 +102,12 @@ void FileDataManager::setFileActive(const QUrl &rootUrl, const QUrl &childUrl, b
         root->watcher->setEnabledSubfileWatcher(childUrl, active);
 }
 
+void FileDataManager::setRecentRootLimit(int limit)
+{
+    recentRootLimit = qMax(0, limit);
+    touchRecentRoot({});
+}
+
 void FileDataManager::onAppAttributeChanged(Application::ApplicationAttribute aa, const QVariant &value)
 {
     if (aa == Application::kFileAndDirMixedSort)
@@ -155,6 +162,9 @@ bool FileDataManager::checkNeedCache(const QUrl &url)
     if (cacheDataSchemes.contains(url.scheme()))
         return true;
 
+    if (recentRoots.contains(url))
+        return true;
+
     // mounted dir should cache files in FileDataManager
     // The purpose is only to judge nonlocal disk files, some schme should not use it to judge, so it is limited to file.
     if (url.scheme() == Global::Scheme::kFile && (!ProtocolUtils::isLocalFile(url)))
@@ -173,3 +183,27 @@ void FileDataManager::handleDeletion(RootInfo *root)
         deleteLaterList.append(root);
     }
 }
+
+void FileDataManager::touchRecentRoot(const QUrl &url)
+{
+    if (recentRootLimit <= 0 && recentRoots.isEmpty())
+        return;
+
+    // only local directories are kept, the others are cached by scheme or not worth watching
+    if (url.isValid() && recentRootLimit > 0 && ProtocolUtils::isLocalFile(url)) {
+        recentRoots.removeOne(url);
+        recentRoots.prepend(url);
+        auto root = rootInfoMap.value(url);
+        if (root)
+            root->setCanCache(true);
+    }
+
+    while (recentRoots.count() > recentRootLimit) {
+        const QUrl &evicted = recentRoots.takeLast();
+        auto root = rootInfoMap.value(evicted);
+        // the roots still shown in views are released by cleanRoot later
+        if (!root || !root->isIdle() || checkNeedCache(evicted))
+            continue;
+        handleDeletion(rootInfoMap.take(evicted));
+    }
+}
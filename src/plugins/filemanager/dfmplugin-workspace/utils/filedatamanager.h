@@ -35,6 +35,8 @@ public:
     void cleanRoot(const QUrl &rootUrl, const QString &key, const bool refresh = false, const bool self = true);
     void cleanRoot(const QUrl &rootUrl);
     void setFileActive(const QUrl &rootUrl, const QUrl &childUrl, bool active);
+    // keep the roots of recently opened directories, so that opening them again is served from cache
+    void setRecentRootLimit(int limit);
 
 public Q_SLOTS:
     void onAppAttributeChanged(DFMBASE_NAMESPACE::Application::ApplicationAttribute aa, const QVariant &value);
@@ -48,6 +50,7 @@ private:
     RootInfo *createRoot(const QUrl &url);
     bool checkNeedCache(const QUrl &url);
     void handleDeletion(RootInfo *root);
+    void touchRecentRoot(const QUrl &url);
 
     QMap<QUrl, RootInfo *> rootInfoMap {};
     QMap<QUrl, TraversalThreadPointer> traversalPointerMap {};
@@ -58,6 +61,9 @@ private:
     QList<QString> cacheDataSchemes {};
     QMap<QUrl, int> dataRefMap {};
     QList<RootInfo *> deleteLaterList {};
+
+    int recentRootLimit { 0 };
+    QList<QUrl> recentRoots {};   // most recently used first
 };
 
 }
@@ -106,6 +106,7 @@ FileView::~FileView()
 
     dpfSignalDispatcher->unsubscribe("dfmplugin_workspace", "signal_View_HeaderViewSectionChanged", this, &FileView::onHeaderViewSectionChanged);
     dpfSignalDispatcher->unsubscribe("dfmplugin_filepreview", "signal_ThumbnailDisplay_Changed", this, &FileView::onWidgetUpdate);
+    FileInfoHelper::instance().removeViewport(quintptr(this));
 }
 
 QWidget *FileView::widget() const
@@ -590,6 +591,43 @@ FileView::RandeIndexList FileView::visibleIndexes(const QRect &rect) const
     return list;
 }
 
+void FileView::updatePrefetchViewport()
+{
+    if (!model() || count() <= 0)
+        return;
+
+    const QRect visibleRect(QPoint(horizontalOffset(), verticalOffset()), viewport()->size());
+    const RandeIndexList &visibleRanges = visibleIndexes(visibleRect);
+    if (visibleRanges.isEmpty())
+        return;
+
+    auto rowUrl = [this](int row) {
+        return d->modelIndexUrl(model()->index(row, 0, rootIndex()));
+    };
+
+    QList<QUrl> visibleUrls;
+    for (const auto &visible : visibleRanges) {
+        for (int row = visible.first; row <= visible.second; ++row)
+            visibleUrls.append(rowUrl(row));
+    }
+    if (visibleUrls == d->lastPrefetchUrls)
+        return;
+    d->lastPrefetchUrls = visibleUrls;
+
+    const RandeIndex range(visibleRanges.first().first, visibleRanges.last().second);
+    // 上下各预取一屏，滚动时这些文件的属性通常已就绪
+    const int pageRows = range.second - range.first + 1;
+    const int nearbyFirst = qMax(0, range.first - pageRows);
+    const int nearbyLast = qMin(count() - 1, range.second + pageRows);
+    QList<QUrl> nearbyUrls;
+    for (int row = nearbyFirst; row < range.first; ++row)
+        nearbyUrls.append(rowUrl(row));
+    for (int row = range.second + 1; row <= nearbyLast; ++row)
+        nearbyUrls.append(rowUrl(row));
+
+    FileInfoHelper::instance().updateViewport(quintptr(this), visibleUrls, nearbyUrls);
+}
+
 FileView::RandeIndexList FileView::rectContainsIndexes(const QRect &rect) const
 {
     RandeIndexList list;
@@ -1423,6 +1461,9 @@ void FileView::resizeEvent(QResizeEvent *event)
     }
 
     verticalScrollBar()->setFixedHeight(rect().height() - d->statusBar->height() - (d->headerView ? d->headerView->height() : 0));
+
+    if (d->prefetchViewportTimer)
+        d->prefetchViewportTimer->start();
 }
 
 void FileView::setSelection(const QRect &rect, QItemSelectionModel::SelectionFlags flags)
@@ -2162,6 +2203,15 @@ void FileView::initializeScrollBarWatcher()
         if (d->scrollBarSliderPressed)
             d->scrollBarValueChangedTimer->start();
     });
+
+    // 滚动、尺寸或行数变化后合并计算一次可见文件，不在每次绘制时计算
+    d->prefetchViewportTimer = new QTimer(this);
+    d->prefetchViewportTimer->setInterval(50);
+    d->prefetchViewportTimer->setSingleShot(true);
+    connect(d->prefetchViewportTimer, &QTimer::timeout, this, &FileView::updatePrefetchViewport);
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, d->prefetchViewportTimer, qOverload<>(&QTimer::start));
+    connect(verticalScrollBar(), &QScrollBar::rangeChanged, d->prefetchViewportTimer, qOverload<>(&QTimer::start));
+    connect(this, &DListView::rowCountChanged, d->prefetchViewportTimer, qOverload<>(&QTimer::start));
 }
 
 void FileView::initializePreSelectTimer()
@@ -222,6 +222,7 @@ private:
     RandeIndexList visibleIndexes(const QRect &rect) const;
     RandeIndexList rectContainsIndexes(const QRect &rect) const;
     RandeIndexList calcRectContiansIndexes(int columnCount, const QRect &rect) const;
+    void updatePrefetchViewport();
 
     QSize itemSizeHint() const;
 
@@ -69,6 +69,8 @@ class FileViewPrivate
     bool isShowViewSelectBox { false };
     bool isResizeEvent { false };
     int lastContentHeight { 0 };
+    // 上次通知 FileInfoHelper 的可见文件，未变化时不重复下发
+    QList<QUrl> lastPrefetchUrls;
 
     QList<QUrl> preSelectionUrls;
     QTimer *preSelectTimer { nullptr };
@@ -77,6 +79,7 @@ class FileViewPrivate
     QMap<QString, bool> columnForRoleHiddenMap;
 
     QTimer *scrollBarValueChangedTimer { nullptr };
+    QTimer *prefetchViewportTimer { nullptr };
     bool scrollBarSliderPressed { false };
 
     bool pressedStartWithExpand { false };
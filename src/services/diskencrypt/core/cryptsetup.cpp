@@ -13,6 +13,7 @@
 #include <dfm-base/utils/finallyutil.h>
 
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
@@ -23,8 +24,16 @@
 #include <sys/mman.h>
 #include <libcryptsetup.h>
 
+#include <DConfig>
+
 static constexpr char kDefaultPassphrase[] { "" };
 static const int kDefaultPassphraseLen { 0 };
+static constexpr uint64_t kDataShiftSectors { 32 * 1024 };
+static constexpr uint64_t kMaxHotzoneMiB { 1024 };
+// 吞吐量每隔一段时间采样一次并做平滑，统计信息按固定间隔上报
+static constexpr qint64 kSampleIntervalMs { 2000 };
+static constexpr double kSmoothFactor { 0.3 };
+static constexpr qint64 kReportIntervalMs { 1000 };
 
 FILE_ENCRYPT_USE_NS
 
@@ -119,7 +128,7 @@ int crypt_setup_helper::initEncryptHeaderFile(const QString &dev, const QString
     }
 
     crypt_set_rng_type(cdev, CRYPT_RNG_RANDOM);
-    r = crypt_set_data_offset(cdev, 32 * 1024);
+    r = crypt_set_data_offset(cdev, kDataShiftSectors);
     if (r < 0) {
         qWarning() << "set cdev offset failed!" << dev << r;
         return -disk_encrypt::kErrorSetOffset;
@@ -176,7 +185,7 @@ int crypt_setup_helper::initEncryptHeaderFile(const QString &dev, const QString
         .direction = CRYPT_REENCRYPT_BACKWARD,
         .resilience = "datashift",
         .hash = "sha256",
-        .data_shift = 32 * 1024,
+        .data_shift = kDataShiftSectors,
         .max_hotzone_size = 0,
         .device_size = 0,
         .luks2 = &luksArgs,
@@ -331,7 +340,7 @@ int crypt_setup::csResumeEncrypt(const QString &dev, const QString &activeName,
         .direction = CRYPT_REENCRYPT_BACKWARD,
         .resilience = "datashift",
         .hash = "sha256",
-        .data_shift = 32 * 1024,
+        .data_shift = kDataShiftSectors,
         .max_hotzone_size = 0,
         .device_size = 0,
         .flags = CRYPT_REENCRYPT_RESUME_ONLY | CRYPT_REENCRYPT_MOVE_FIRST_SEGMENT
@@ -353,11 +362,17 @@ int crypt_setup::csResumeEncrypt(const QString &dev, const QString &activeName,
     }
 
     qInfo() << "processing encryption..." << dev;
-    QPair<QString, QString> devInfo { dev, displayName };
+    // datashift 模式下每次处理的数据量即移动的数据量
+    crypt_setup_helper::ReencryptMonitor monitor;
+    monitor.dev = dev;
+    monitor.displayName = displayName;
+    monitor.mode = "encrypt";
+    monitor.resilience = encArgs.resilience;
+    monitor.hotzoneSize = kDataShiftSectors * 512;
     r = crypt_reencrypt_run(cdev,
                             crypt_setup_helper::onEncrypting,
-                            (void *)&devInfo);
-    qInfo() << "encryption process finished" << dev << r;
+                            (void *)&monitor);
+    qInfo() << "encryption process finished" << dev << r << monitor.statistics();
     if (r < 0) {
         qWarning() << "run reencrypt failed!" << dev << r;
         return -disk_encrypt::kErrorReencryptFailed;
@@ -367,22 +382,135 @@ int crypt_setup::csResumeEncrypt(const QString &dev, const QString &activeName,
 
 int crypt_setup_helper::onEncrypting(uint64_t size, uint64_t offset, void *usrptr)
 {
-    auto dev = reinterpret_cast<QPair<QString, QString> *>(usrptr);
-    Q_EMIT NotificationHelper::instance()->notifyEncryptProgress(dev->first,
-                                                                 dev->second,
+    auto monitor = reinterpret_cast<ReencryptMonitor *>(usrptr);
+    updateMonitor(monitor, size, offset);
+    Q_EMIT NotificationHelper::instance()->notifyEncryptProgress(monitor->dev,
+                                                                 monitor->displayName,
                                                                  double(1.0 * offset / size));
     return 0;
 }
 
 int crypt_setup_helper::onDecrypting(uint64_t size, uint64_t offset, void *usrptr)
 {
-    auto dev = reinterpret_cast<QPair<QString, QString> *>(usrptr);
-    Q_EMIT NotificationHelper::instance()->notifyDecryptProgress(dev->first,
-                                                                 dev->second,
+    auto monitor = reinterpret_cast<ReencryptMonitor *>(usrptr);
+    updateMonitor(monitor, size, offset);
+    Q_EMIT NotificationHelper::instance()->notifyDecryptProgress(monitor->dev,
+                                                                 monitor->displayName,
                                                                  double(1.0 * offset / size));
     return 0;
 }
 
+void crypt_setup_helper::updateMonitor(ReencryptMonitor *monitor, uint64_t size, uint64_t offset)
+{
+    monitor->size = size;
+    monitor->offset = offset;
+
+    // the first callback is invoked before any data is processed.
+    if (!monitor->elapsed.isValid()) {
+        monitor->elapsed.start();
+        monitor->startOffset = offset;
+        monitor->lastSampleOffset = offset;
+        return;
+    }
+
+    // every following callback means a hotzone is processed and committed to metadata.
+    ++monitor->checkpoints;
+
+    qint64 now = monitor->elapsed.elapsed();
+    qint64 span = now - monitor->lastSampleMs;
+    if (span >= kSampleIntervalMs && offset > monitor->lastSampleOffset) {
+        double current = double(offset - monitor->lastSampleOffset) * 1000 / span;
+        monitor->throughput = monitor->throughput > 0
+                ? kSmoothFactor * current + (1 - kSmoothFactor) * monitor->throughput
+                : current;
+        monitor->lastSampleMs = now;
+        monitor->lastSampleOffset = offset;
+    }
+
+    if (monitor->lastReportMs < 0 || now - monitor->lastReportMs >= kReportIntervalMs || offset >= size) {
+        monitor->lastReportMs = now;
+        Q_EMIT NotificationHelper::instance()->notifyReencryptStatistics(monitor->statistics());
+    }
+}
+
+QVariantMap crypt_setup_helper::ReencryptMonitor::statistics() const
+{
+    // before the first sample, use the average speed.
+    qint64 ms = elapsed.isValid() ? elapsed.elapsed() : 0;
+    double speed = throughput;
+    if (speed <= 0 && ms > 0 && offset > startOffset)
+        speed = double(offset - startOffset) * 1000 / ms;
+    qint64 eta = speed > 0 ? qint64((size - qMin(size, offset)) / speed) : -1;
+
+    using namespace disk_encrypt::encrypt_param_keys;
+    return {
+        { kKeyDevice, dev },
+        { kKeyDeviceName, displayName },
+        { kKeyReencryptMode, mode },
+        { kKeyResilience, resilience },
+        { kKeyHotzoneSize, qulonglong(hotzoneSize) },
+        { kKeyProcessedSize, qulonglong(offset) },
+        { kKeyTotalSize, qulonglong(size) },
+        { kKeyThroughput, qulonglong(speed) },
+        { kKeyETA, eta },
+        { kKeyCheckpoints, qulonglong(checkpoints) },
+        { kKeyElapsed, ms }
+    };
+}
+
+crypt_setup::ReencryptTuning crypt_setup_helper::reencryptTuning(const QString &dev)
+{
+    auto cfg = Dtk::Core::DConfig::create("org.deepin.dde.file-manager",
+                                          "org.deepin.dde.file-manager.diskencrypt");
+    cfg->deleteLater();
+
+    crypt_setup::ReencryptTuning tuning;
+    auto resilience = cfg->value("reencryptResilience", "checksum").toString();
+    static const QStringList kSupportedResilience { "checksum", "journal" };
+    if (kSupportedResilience.contains(resilience))
+        tuning.resilience = resilience;
+    else
+        qWarning() << "unsupported resilience mode, use checksum instead." << resilience;
+
+    auto hotzone = qBound<qlonglong>(0, cfg->value("reencryptHotzoneSize", 0).toLongLong(), kMaxHotzoneMiB);
+    tuning.hotzoneSize = alignHotzoneSize(dev, uint64_t(hotzone) * 1024 * 1024);
+
+    qInfo() << "reencrypt tuning of" << dev << tuning.resilience << tuning.hotzoneSize;
+    return tuning;
+}
+
+uint64_t crypt_setup_helper::optimalIOSize(const QString &dev)
+{
+    auto name = QFileInfo(dev).canonicalFilePath().mid(5);   // resolve /dev/mapper/xxx to dm-N
+    auto sysPath = QFileInfo("/sys/class/block/" + name).canonicalFilePath();
+    if (name.isEmpty() || sysPath.isEmpty())
+        return 0;
+
+    // partitions have no queue attributes, use the ones of the parent disk.
+    for (const auto &queue : { sysPath + "/queue", sysPath + "/../queue" }) {
+        for (const auto &attr : { "optimal_io_size", "minimum_io_size" }) {
+            QFile f(queue + "/" + attr);
+            if (!f.open(QIODevice::ReadOnly))
+                continue;
+            auto size = f.readAll().trimmed().toULongLong();
+            if (size > 0)
+                return size;
+        }
+    }
+    return 0;
+}
+
+uint64_t crypt_setup_helper::alignHotzoneSize(const QString &dev, uint64_t size)
+{
+    if (size == 0)
+        return 0;
+
+    // hotzone must be multiple of sector, round it up to the optimal io size.
+    uint64_t align = qMax<uint64_t>(optimalIOSize(dev), 4096);
+    align = (align + 511) / 512 * 512;
+    return (size + align - 1) / align * align;
+}
+
 int crypt_setup_helper::backupDetachHeader(const QString &dev, QString *fileHeader)
 {
     QString headerPath;
@@ -558,11 +686,14 @@ int crypt_setup::csDecrypt(const QString &dev, const QString &passphrase, const
 
     bool resumeOnly = flags & CRYPT_REQUIREMENT_ONLINE_REENCRYPT;
     auto shift = crypt_get_data_offset(cdev);
+    // 续做时沿用头中记录的模式
+    auto tuning = crypt_setup_helper::reencryptTuning(dev);
+    auto resilience = ("datashift-" + tuning.resilience).toStdString();
     struct crypt_params_reencrypt encArgs
     {
         .mode = CRYPT_REENCRYPT_DECRYPT,
         .direction = CRYPT_REENCRYPT_FORWARD,
-        .resilience = resumeOnly ? nullptr : "datashift-checksum",
+        .resilience = resumeOnly ? nullptr : resilience.c_str(),
         .hash = "sha256",
         .data_shift = shift,
         .max_hotzone_size = 0,
@@ -586,11 +717,16 @@ int crypt_setup::csDecrypt(const QString &dev, const QString &passphrase, const
     }
 
     qInfo() << "processing decryption..." << dev;
-    QPair<QString, QString> devInfo { dev, displayName };
+    crypt_setup_helper::ReencryptMonitor monitor;
+    monitor.dev = dev;
+    monitor.displayName = displayName;
+    monitor.mode = "decrypt";
+    monitor.resilience = resumeOnly ? QString(args.resilience) : QString::fromStdString(resilience);
+    monitor.hotzoneSize = shift * 512;
     r = crypt_reencrypt_run(cdev,
                             crypt_setup_helper::onDecrypting,
-                            (void *)&devInfo);
-    qInfo() << "decryption process finished" << dev << r;
+                            (void *)&monitor);
+    qInfo() << "decryption process finished" << dev << r << monitor.statistics();
     if (r < 0) {
         qWarning() << "decrypt device failed!" << dev << r;
         return -disk_encrypt::kErrorReencryptFailed;
@@ -1001,14 +1137,17 @@ int crypt_setup::csDecryptMoveHead(const QString &dev, const QString &passphrase
     }
 
 
+    // 不移动数据，数据保护模式和 hotzone 大小均可调
+    auto tuning = crypt_setup_helper::reencryptTuning(dev);
+    auto resilience = tuning.resilience.toStdString();
     struct crypt_params_reencrypt encArgs
     {
         .mode = CRYPT_REENCRYPT_DECRYPT,
                 .direction = CRYPT_REENCRYPT_BACKWARD,
-                .resilience = "checksum",
+                .resilience = resilience.c_str(),
                 .hash = "sha256",
                 .data_shift = 0,
-                .max_hotzone_size = 0,
+                .max_hotzone_size = tuning.hotzoneSize / 512,
                 .device_size = 0
 
     };
@@ -1028,10 +1167,16 @@ int crypt_setup::csDecryptMoveHead(const QString &dev, const QString &passphrase
         return -disk_encrypt::kErrorWrongPassphrase;   // might not pass wrong.
     }
 
-    QPair<QString, QString> devInfo { dev, displayName };
+    crypt_setup_helper::ReencryptMonitor monitor;
+    monitor.dev = dev;
+    monitor.displayName = displayName;
+    monitor.mode = "decrypt";
+    monitor.resilience = tuning.resilience;
+    monitor.hotzoneSize = tuning.hotzoneSize;
     r = crypt_reencrypt_run(cdev,
                             crypt_setup_helper::onDecrypting,
-                            (void *)&devInfo);
+                            (void *)&monitor);
+    qInfo() << "decryption process finished" << dev << r << monitor.statistics();
     if (r < 0) {
         qWarning() << "decrypt device failed!" << dev << r;
         return -disk_encrypt::kErrorReencryptFailed;
@@ -1050,3 +1195,123 @@ int crypt_setup::csDecryptMoveHead(const QString &dev, const QString &passphrase
 
     return disk_encrypt::kSuccess;
 }
+
+int crypt_setup::csBenchmarkReencrypt(const QString &dev, const ReencryptTuning &tuning, QVariantMap *stats)
+{
+    // the benchmark overwrites the whole device, so only attached loop devices are accepted.
+    auto name = QFileInfo(dev).canonicalFilePath().mid(5);
+    if (!name.startsWith("loop") || !QFile::exists("/sys/block/" + name + "/loop/backing_file")) {
+        qWarning() << "benchmark only runs on attached loop device!" << dev;
+        return -disk_encrypt::kErrorParamsInvalid;
+    }
+
+    QString headerPath;
+    int r = crypt_setup_helper::createHeaderFile(dev, &headerPath);
+    if (r < 0)
+        return -disk_encrypt::kErrorCreateHeader;
+
+    struct crypt_device *cdev { nullptr };
+    dfmbase::FinallyUtil atFinish([&] {
+        if (cdev)
+            crypt_free(cdev);
+        ::remove(headerPath.toStdString().c_str());
+    });
+
+    r = crypt_init(&cdev,
+                   headerPath.toStdString().c_str());
+    if (r < 0) {
+        qWarning() << "init cdev failed!" << dev << r;
+        return -disk_encrypt::kErrorInitCrypt;
+    }
+
+    // use a detached header with no data offset, so that the resilience mode
+    // is not limited to datashift and the hotzone size takes effect.
+    r = crypt_set_data_offset(cdev, 0);
+    if (r < 0) {
+        qWarning() << "set cdev offset failed!" << dev << r;
+        return -disk_encrypt::kErrorSetOffset;
+    }
+
+    auto _dev = dev.toStdString();
+    struct crypt_params_luks2 fmtArgs
+    {
+        .data_alignment = 0,
+        .data_device = _dev.c_str(),
+        .sector_size = 512,
+        .label = nullptr,
+        .subsystem = nullptr
+    };
+    auto cipher = common_helper::encryptCipher().toStdString();
+    const char *mode = "xts-plain64";
+    r = crypt_format(cdev,
+                     CRYPT_LUKS2,
+                     cipher.c_str(),
+                     mode,
+                     nullptr,
+                     nullptr,
+                     256 / 8,
+                     &fmtArgs);
+    if (r < 0) {
+        qWarning() << "format device failed!" << dev << r;
+        return -disk_encrypt::kErrorFormatLuks;
+    }
+
+    r = crypt_keyslot_add_by_volume_key(cdev,
+                                        CRYPT_ANY_SLOT,
+                                        nullptr,
+                                        0,
+                                        kDefaultPassphrase,
+                                        kDefaultPassphraseLen);
+    if (r < 0) {
+        qWarning() << "cannot add empty keyslot!" << dev << r;
+        return -disk_encrypt::kErrorAddKeyslot;
+    }
+
+    auto resilience = tuning.resilience.toStdString();
+    auto hotzone = crypt_setup_helper::alignHotzoneSize(dev, tuning.hotzoneSize);
+    struct crypt_params_luks2 luksArgs
+    {
+        .sector_size = 512
+    };
+    struct crypt_params_reencrypt encArgs
+    {
+        .mode = CRYPT_REENCRYPT_ENCRYPT,
+        .direction = CRYPT_REENCRYPT_FORWARD,
+        .resilience = resilience.c_str(),
+        .hash = "sha256",
+        .data_shift = 0,
+        .max_hotzone_size = hotzone / 512,
+        .device_size = 0,
+        .luks2 = &luksArgs,
+        .flags = 0
+    };
+    r = crypt_reencrypt_init_by_passphrase(cdev,
+                                           nullptr,
+                                           kDefaultPassphrase,
+                                           kDefaultPassphraseLen,
+                                           CRYPT_ANY_SLOT,
+                                           0,
+                                           cipher.c_str(),
+                                           mode,
+                                           &encArgs);
+    if (r < 0) {
+        qWarning() << "cannot init reencrypt!" << dev << r;
+        return -disk_encrypt::kErrorInitReencrypt;
+    }
+
+    crypt_setup_helper::ReencryptMonitor monitor;
+    monitor.dev = dev;
+    monitor.mode = "encrypt";
+    monitor.resilience = tuning.resilience;
+    monitor.hotzoneSize = hotzone;
+    r = crypt_reencrypt_run(cdev,
+                            crypt_setup_helper::onEncrypting,
+                            (void *)&monitor);
+    if (stats)
+        *stats = monitor.statistics();
+    if (r < 0) {
+        qWarning() << "run reencrypt failed!" << dev << r;
+        return -disk_encrypt::kErrorReencryptFailed;
+    }
+    return disk_encrypt::kSuccess;
+}
@@ -7,6 +7,9 @@
 
 #include "diskencrypt_global.h"
 
+#include <QElapsedTimer>
+#include <QVariantMap>
+
 FILE_ENCRYPT_BEGIN_NS
 
 static constexpr char kUSecBootRoot[] { "/boot/usec-crypt" };
@@ -22,6 +25,14 @@ struct CryptPreProcessor
     QByteArray volumeKey;
 };
 
+// 重加密的调优参数，hotzone 只对不移动数据的 checksum/journal/none 模式生效，
+// datashift 系列模式的 hotzone 由移动的数据量决定
+struct ReencryptTuning
+{
+    QString resilience { "checksum" };
+    uint64_t hotzoneSize = 0;   // in bytes, 0 means the default of libcryptsetup
+};
+
 int csInitEncrypt(const QString &dev, const QString &displayName, CryptPreProcessor *processor = nullptr);
 int csResumeEncrypt(const QString &dev, const QString &activeName, const QString &displayName);
 int csDecrypt(const QString &dev, const QString &passphrase,
@@ -33,6 +44,8 @@ int csChangePassphrase(const QString &dev, const QString &oldPwd, const QString
 int csActivateDevice(const QString &dev, const QString &activateName, const QString &passphrase = QString());
 int csActivateDeviceByVolume(const QString &dev, const QString &activateName, const QByteArray &volume);
 int csSetLabel(const QString &dev, const QString &label);
+// NOTE: destroys all data on the device, only loop devices are accepted.
+int csBenchmarkReencrypt(const QString &dev, const ReencryptTuning &tuning, QVariantMap *stats = nullptr);
 }   // namespace crypt_setup
 
 namespace crypt_setup_helper {
@@ -46,6 +59,33 @@ int headerStatus(const QString &fileHeader);
 int encryptStatus(const QString &dev);
 int setToken(const QString &dev, const QString &token);
 int getToken(const QString &dev, QString *token);
+crypt_setup::ReencryptTuning reencryptTuning(const QString &dev);
+uint64_t optimalIOSize(const QString &dev);
+uint64_t alignHotzoneSize(const QString &dev, uint64_t size);
+
+// 传递给 crypt_reencrypt_run 的进度上下文，统计吞吐量和剩余时间
+struct ReencryptMonitor
+{
+    QString dev;
+    QString displayName;
+    QString mode;
+    QString resilience;
+    uint64_t hotzoneSize = 0;
+
+    QElapsedTimer elapsed;
+    uint64_t size = 0;
+    uint64_t offset = 0;
+    uint64_t startOffset = 0;   // 续做时已完成的部分不计入吞吐量
+    uint64_t checkpoints = 0;
+    double throughput = 0;   // bytes per second, smoothed
+    qint64 lastSampleMs = 0;
+    uint64_t lastSampleOffset = 0;
+    qint64 lastReportMs = -1;
+
+    QVariantMap statistics() const;
+};
+void updateMonitor(ReencryptMonitor *monitor, uint64_t size, uint64_t offset);
+
 int onEncrypting(uint64_t size, uint64_t offset, void *usrptr);
 int onDecrypting(uint64_t size, uint64_t offset, void *usrptr);
 
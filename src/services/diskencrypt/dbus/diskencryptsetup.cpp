@@ -40,6 +40,8 @@ DiskEncryptSetup::DiskEncryptSetup(QObject *parent)
             this, &DiskEncryptSetup::EncryptProgress);
     connect(NotificationHelper::instance(), &NotificationHelper::notifyDecryptProgress,
             this, &DiskEncryptSetup::DecryptProgress);
+    connect(NotificationHelper::instance(), &NotificationHelper::notifyReencryptStatistics,
+            this, &DiskEncryptSetup::ReencryptStatistics);
 }
 
 bool DiskEncryptSetup::InitEncryption(const QVariantMap &args)
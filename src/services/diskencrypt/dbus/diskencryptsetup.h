@@ -38,6 +38,7 @@ public Q_SLOTS:
 Q_SIGNALS:
     void EncryptProgress(const QString &dev, const QString &devName, double progress);
     void DecryptProgress(const QString &dev, const QString &devName, double progress);
+    void ReencryptStatistics(const QVariantMap &stats);
 
     void InitEncResult(const QVariantMap &result);
     void EncryptResult(const QVariantMap &result);
@@ -46,6 +46,15 @@ inline constexpr char kKeyOperationResult[] { "operation-result" };
 inline constexpr char kKeyRecoveryKey[] { "recovery-key" };
 inline constexpr char kKeyJobType[] { "job-type" };
 inline constexpr char kKeyValidateWithRecKey[] { "validate-with-reckey" };
+inline constexpr char kKeyReencryptMode[] { "reencrypt-mode" };
+inline constexpr char kKeyResilience[] { "resilience" };
+inline constexpr char kKeyHotzoneSize[] { "hotzone-size" };
+inline constexpr char kKeyProcessedSize[] { "processed-size" };
+inline constexpr char kKeyTotalSize[] { "total-size" };
+inline constexpr char kKeyThroughput[] { "throughput" };
+inline constexpr char kKeyETA[] { "eta" };
+inline constexpr char kKeyCheckpoints[] { "checkpoints" };
+inline constexpr char kKeyElapsed[] { "elapsed" };
 }   // namespace encrypt_param_keys
 
 inline const QStringList kDisabledEncryptPath {
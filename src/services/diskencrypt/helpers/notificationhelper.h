@@ -21,6 +21,7 @@ public:
 Q_SIGNALS:
     void notifyEncryptProgress(const QString &dev, const QString &name, double progress);
     void notifyDecryptProgress(const QString &dev, const QString &name, double progress);
+    void notifyReencryptStatistics(const QVariantMap &stats);
     void replyAuthArgs(const QVariantMap &args);
     void ignoreAuthSetup();
 };
@@ -3,21 +3,58 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "dbus/diskencryptsetup.h"
+#include "core/cryptsetup.h"
 #include "helpers/cryptsetupcompabilityhelper.h"
 #include "diskencryptadaptor.h"
 
 #include <DConfig>
 
 #include <QCoreApplication>
+#include <QCommandLineParser>
 #include <QDebug>
 
 static constexpr char kObjPath[] { "/org/deepin/Filemanager/DiskEncrypt" };
 static constexpr char kServiceName[] { "org.deepin.Filemanager.DiskEncrypt" };
 
+// 在 loop 设备上测试不同数据保护模式和 hotzone 大小下的重加密速度，例如：
+// losetup -f --show disk.img && deepin-diskencrypt-service --benchmark /dev/loop0 --resilience journal --hotzone 64
+static int runBenchmark(const QCommandLineParser &parser)
+{
+    using namespace daemonplugin_file_encrypt;
+
+    crypt_setup::ReencryptTuning tuning;
+    tuning.resilience = parser.value("resilience");
+    tuning.hotzoneSize = parser.value("hotzone").toULongLong() * 1024 * 1024;
+    static const QStringList kSupportedResilience { "checksum", "journal", "none" };
+    if (!kSupportedResilience.contains(tuning.resilience)) {
+        qWarning() << "unsupported resilience mode:" << tuning.resilience;
+        return 1;
+    }
+
+    QVariantMap stats;
+    int r = crypt_setup::csBenchmarkReencrypt(parser.value("benchmark"), tuning, &stats);
+
+    using namespace disk_encrypt::encrypt_param_keys;
+    auto processed = stats.value(kKeyProcessedSize).toULongLong();
+    auto ms = stats.value(kKeyElapsed).toLongLong();
+    qInfo() << "benchmark finished:" << r << stats;
+    qInfo() << "average throughput (MiB/s):" << (ms > 0 ? processed * 1000.0 / ms / 1024 / 1024 : 0);
+    return r < 0 ? 1 : 0;
+}
+
 int main(int argc, char *argv[])
 {
     QCoreApplication a(argc, argv);
 
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addOption({ "benchmark", "Run reencryption benchmark on <loop-device>, ALL DATA ON IT WILL BE LOST.", "loop-device" });
+    parser.addOption({ "resilience", "Resilience mode of benchmark: checksum, journal or none.", "mode", "checksum" });
+    parser.addOption({ "hotzone", "Hotzone size of benchmark in MiB, 0 means the default of cryptsetup.", "MiB", "0" });
+    parser.process(a);
+    if (parser.isSet("benchmark"))
+        return runBenchmark(parser);
+
     auto cfg = Dtk::Core::DConfig::create("org.deepin.dde.file-manager",
                                           "org.deepin.dde.file-manager.diskencrypt");
     bool enable = cfg->value("enableEncrypt", true).toBool();
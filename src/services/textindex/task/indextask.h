@@ -21,7 +21,8 @@ public:
     enum class Type {
         Create,
         Update,
-        Remove
+        Remove,
+        Optimize   // 内部任务，不对外通知
     };
     Q_ENUM(Type)
 
@@ -8,6 +8,8 @@
 #include "utils/indextraverseutils.h"
 #include "utils/scopeguard.h"
 #include "utils/docutils.h"
+#include "utils/indexconfig.h"
+#include "utils/contentcache.h"
 
 #include <fulltext/chineseanalyzer.h>
 
@@ -23,6 +25,7 @@
 #include <QRegularExpression>
 #include <QStandardPaths>
 #include <QQueue>
+#include <QElapsedTimer>
 
 #include <dirent.h>
 #include <sys/types.h>
@@ -66,6 +69,55 @@ private:
     QDateTime lastReportTime;
 };
 
+// 按文档数和时间批量提交，使更新过程中的修改尽早对搜索可见，又避免逐文档提交
+class CommitScheduler
+{
+public:
+    CommitScheduler(const IndexWriterPtr &writer, const IndexWriterOptions &options)
+        : writer(writer), options(options)
+    {
+        timer.start();
+    }
+
+    void documentChanged()
+    {
+        ++pendingCount;
+        if (pendingCount >= options.commitDocCount || timer.elapsed() >= options.commitIntervalMs)
+            commit();
+    }
+
+    void commit()
+    {
+        if (pendingCount > 0) {
+            writer->commit();
+            fmDebug() << "Committed" << pendingCount << "index changes";
+        }
+        pendingCount = 0;
+        timer.restart();
+    }
+
+private:
+    IndexWriterPtr writer;
+    IndexWriterOptions options;
+    QElapsedTimer timer;
+    int pendingCount { 0 };
+};
+
+IndexWriterPtr newIndexWriter(bool create, const IndexWriterOptions &options)
+{
+    IndexWriterPtr writer = newLucene<IndexWriter>(
+            FSDirectory::open(indexStorePath().toStdWString()),
+            newLucene<ChineseAnalyzer>(),
+            create,
+            IndexWriter::MaxFieldLengthLIMITED);
+
+    // 仅按内存占用刷新，文档数不再触发刷新
+    writer->setRAMBufferSizeMB(options.ramBufferSizeMB);
+    writer->setMaxBufferedDocs(IndexWriter::DISABLE_AUTO_FLUSH);
+    writer->setMergeFactor(options.mergeFactor);
+    return writer;
+}
+
 // 目录遍历相关函数
 using FileHandler = std::function<void(const QString &path)>;
 
@@ -93,8 +145,8 @@ DocumentPtr createFileDocument(const QString &file)
     doc->add(newLucene<Field>(L"modified", modifyEpoch.toStdWString(),
                               Field::STORE_YES, Field::INDEX_NOT_ANALYZED));
 
-    // file contents
-    const auto &contentOpt = DocUtils::extractFileContent(file);
+    // file contents, 相同内容的文件复用已提取的文本
+    const auto &contentOpt = ContentCache::extractFileContent(file);
 
     if (!contentOpt) {
         fmWarning() << "Failed to extract content from file:" << file;
@@ -109,10 +161,9 @@ DocumentPtr createFileDocument(const QString &file)
     return doc;
 }
 
-bool checkNeedUpdate(const QString &file, const IndexReaderPtr &reader, bool *needAdd)
+bool checkNeedUpdate(const QString &file, const SearcherPtr &searcher, bool *needAdd)
 {
     try {
-        SearcherPtr searcher = newLucene<IndexSearcher>(reader);
         TermQueryPtr query = newLucene<TermQuery>(newLucene<Term>(L"path", file.toStdWString()));
 
         TopDocsPtr topDocs = searcher->search(query, 1);
@@ -167,15 +218,15 @@ void processFile(const QString &path, const IndexWriterPtr &writer, ProgressRepo
     }
 }
 
-void updateFile(const QString &path, const IndexReaderPtr &reader,
-                const IndexWriterPtr &writer, ProgressReporter *reporter)
+void updateFile(const QString &path, const SearcherPtr &searcher,
+                const IndexWriterPtr &writer, CommitScheduler *scheduler, ProgressReporter *reporter)
 {
     try {
         if (!isSupportedFile(path))
             return;
 
         bool needAdd = false;
-        if (checkNeedUpdate(path, reader, &needAdd)) {
+        if (checkNeedUpdate(path, searcher, &needAdd)) {
             if (needAdd) {
 #ifdef QT_DEBUG
                 fmDebug() << "Adding [" << path << "]";
@@ -186,6 +237,7 @@ void updateFile(const QString &path, const IndexReaderPtr &reader,
                 TermPtr term = newLucene<Term>(L"path", path.toStdWString());
                 writer->updateDocument(term, createFileDocument(path));
             }
+            scheduler->documentChanged();
         }
 
         if (reporter) {
@@ -268,11 +320,13 @@ void traverseDirectory(const QString &rootPath, const IndexWriterPtr &writer,
 }
 
 void traverseForUpdate(const QString &rootPath, const IndexReaderPtr &reader,
-                       const IndexWriterPtr &writer, TaskState &running)
+                       const IndexWriterPtr &writer, CommitScheduler *scheduler, TaskState &running)
 {
     ProgressReporter reporter;
+    // 整个更新过程共用一个searcher，避免逐文件创建
+    SearcherPtr searcher = newLucene<IndexSearcher>(reader);
     traverseDirectoryCommon(rootPath, running, [&](const QString &path) {
-        updateFile(path, reader, writer, &reporter);
+        updateFile(path, searcher, writer, scheduler, &reporter);
     });
 }
 
@@ -298,11 +352,8 @@ TaskHandler TaskHandlers::CreateIndexHandler()
         }
 
         try {
-            IndexWriterPtr writer = newLucene<IndexWriter>(
-                    FSDirectory::open(indexStorePath().toStdWString()),
-                    newLucene<ChineseAnalyzer>(),
-                    true,
-                    IndexWriter::MaxFieldLengthLIMITED);
+            // 创建过程中不做中间提交，避免搜索看到不完整的索引
+            IndexWriterPtr writer = newIndexWriter(true, IndexConfig::writerOptions());
 
             // 添加 writer 的 ScopeGuard
             ScopeGuard writerCloser([&writer]() {
@@ -323,7 +374,7 @@ TaskHandler TaskHandlers::CreateIndexHandler()
                 return false;
             }
 
-            writer->optimize();
+            // 段合并推迟到空闲时由 TaskManager 调度
             return true;
         } catch (const LuceneException &e) {
             fmWarning() << "Create index failed with Lucene exception:"
@@ -354,11 +405,8 @@ TaskHandler TaskHandlers::UpdateIndexHandler()
                 }
             });
 
-            IndexWriterPtr writer = newLucene<IndexWriter>(
-                    FSDirectory::open(indexStorePath().toStdWString()),
-                    newLucene<ChineseAnalyzer>(),
-                    false,
-                    IndexWriter::MaxFieldLengthLIMITED);
+            const IndexWriterOptions &options = IndexConfig::writerOptions();
+            IndexWriterPtr writer = newIndexWriter(false, options);
 
             // 添加 writer 的 ScopeGuard
             ScopeGuard writerCloser([&writer]() {
@@ -369,14 +417,14 @@ TaskHandler TaskHandlers::UpdateIndexHandler()
                 }
             });
 
-            traverseForUpdate(path, reader, writer, running);
+            CommitScheduler scheduler(writer, options);
+            traverseForUpdate(path, reader, writer, &scheduler, running);
 
             if (!running.isRunning()) {
                 fmInfo() << "Update index task was interrupted";
                 return false;
             }
 
-            writer->optimize();
             return true;
         } catch (const LuceneException &e) {
             // Lucene异常表示索引损坏
@@ -398,11 +446,7 @@ TaskHandler TaskHandlers::RemoveIndexHandler()
         fmInfo() << "Removing index for paths:" << pathList;
 
         try {
-            IndexWriterPtr writer = newLucene<IndexWriter>(
-                    FSDirectory::open(indexStorePath().toStdWString()),
-                    newLucene<ChineseAnalyzer>(),
-                    false,
-                    IndexWriter::MaxFieldLengthLIMITED);
+            IndexWriterPtr writer = newIndexWriter(false, IndexConfig::writerOptions());
 
             // 添加 writer 的 ScopeGuard
             ScopeGuard writerCloser([&writer]() {
@@ -437,7 +481,6 @@ TaskHandler TaskHandlers::RemoveIndexHandler()
                 return false;
             }
 
-            writer->optimize();
             return true;
         } catch (const LuceneException &e) {
             fmWarning() << "Remove index failed with Lucene exception:"
@@ -449,3 +492,41 @@ TaskHandler TaskHandlers::RemoveIndexHandler()
         return false;
     };
 }
+
+TaskHandler TaskHandlers::OptimizeIndexHandler()
+{
+    return [](const QString &path, TaskState &running) -> bool {
+        Q_UNUSED(path)
+        fmInfo() << "Optimizing index in:" << indexStorePath();
+
+        try {
+            const IndexWriterOptions &options = IndexConfig::writerOptions();
+            IndexWriterPtr writer = newIndexWriter(false, options);
+
+            // 添加 writer 的 ScopeGuard
+            ScopeGuard writerCloser([&writer]() {
+                try {
+                    if (writer) writer->close();
+                } catch (...) {
+                    // 忽略关闭时的异常
+                }
+            });
+
+            if (!running.isRunning())
+                return false;
+
+            writer->optimize();
+
+            // 顺便限制提取缓存的大小
+            ContentCache::prune(static_cast<qint64>(options.contentCacheSizeMB) * 1024 * 1024);
+            return true;
+        } catch (const LuceneException &e) {
+            fmWarning() << "Optimize index failed with Lucene exception:"
+                        << QString::fromStdWString(e.getError());
+        } catch (const std::exception &e) {
+            fmWarning() << "Optimize index failed with exception:" << e.what();
+        }
+
+        return false;
+    };
+}
@@ -21,6 +21,8 @@ namespace TaskHandlers {
 TaskHandler CreateIndexHandler();
 TaskHandler UpdateIndexHandler();
 TaskHandler RemoveIndexHandler();
+// 空闲时合并索引段，由 TaskManager 内部调度
+TaskHandler OptimizeIndexHandler();
 }
 
 SERVICETEXTINDEX_END_NAMESPACE
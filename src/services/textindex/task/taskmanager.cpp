@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "taskmanager.h"
+#include "utils/indexconfig.h"
+#include "utils/contentcache.h"
 
 #include <QMetaType>
 #include <QJsonDocument>
@@ -11,9 +13,13 @@
 #include <QDir>
 #include <QDateTime>
 
+#include <algorithm>
+
 SERVICETEXTINDEX_USE_NAMESPACE
 
 namespace {
+constexpr int kMaxPendingTasks = 16;   // 段合并期间最多排队的任务数
+
 void registerMetaTypes()
 {
     static bool registered = false;
@@ -71,6 +77,9 @@ TaskManager::TaskManager(QObject *parent)
 {
     fmInfo() << "Initializing TaskManager...";
     registerMetaTypes();
+
+    optimizeTimer.setSingleShot(true);
+    connect(&optimizeTimer, &QTimer::timeout, this, &TaskManager::onOptimizeTimeout);
 }
 
 TaskManager::~TaskManager()
@@ -86,11 +95,29 @@ TaskManager::~TaskManager()
 
 bool TaskManager::startTask(IndexTask::Type type, const QString &path)
 {
+    // 段合并无法中断，新任务在合并结束后依次执行
+    if (isOptimizing()) {
+        const bool queued = std::any_of(pendingTasks.cbegin(), pendingTasks.cend(), [&](const PendingTask &task) {
+            return task.type == type && task.path == path;
+        });
+        if (queued)
+            return true;
+        if (pendingTasks.count() >= kMaxPendingTasks) {
+            fmWarning() << "Cannot queue new task, too many tasks are waiting for index optimize";
+            return false;
+        }
+        fmInfo() << "Index is being optimized, queue task for path:" << path;
+        pendingTasks.enqueue(PendingTask { type, path });
+        return true;
+    }
+
     if (hasRunningTask()) {
         fmWarning() << "Cannot start new task, another task is running";
         return false;
     }
 
+    optimizeTimer.stop();
+
     fmInfo() << "Starting new task for path:" << path;
 
     // 如果是根目录的任务，清除状态文件
@@ -112,6 +139,9 @@ bool TaskManager::startTask(IndexTask::Type type, const QString &path)
     case IndexTask::Type::Remove:
         handler = TaskHandlers::RemoveIndexHandler();
         break;
+    case IndexTask::Type::Optimize:
+        handler = TaskHandlers::OptimizeIndexHandler();
+        break;
     default:
         fmWarning() << "Unknown task type:" << static_cast<int>(type);
         return false;
@@ -139,6 +169,8 @@ QString TaskManager::typeToString(IndexTask::Type type)
         return "update";
     case IndexTask::Type::Remove:
         return "remove";
+    case IndexTask::Type::Optimize:
+        return "optimize";
     default:
         return "unknown";
     }
@@ -156,6 +188,13 @@ void TaskManager::onTaskFinished(IndexTask::Type type, bool success)
 {
     if (!currentTask) return;
 
+    if (type == IndexTask::Type::Optimize) {
+        fmInfo() << "Index optimize" << (success ? "completed successfully" : "failed");
+        cleanupTask();
+        startPendingTask();
+        return;
+    }
+
     QString taskPath = currentTask->taskPath();
     
     if (!success && type == IndexTask::Type::Update) {
@@ -194,15 +233,66 @@ void TaskManager::onTaskFinished(IndexTask::Type type, bool success)
 
     emit taskFinished(typeToString(type), taskPath, success);
     cleanupTask();
+
+    if (!pendingTasks.isEmpty())
+        startPendingTask();
+    else if (success)
+        scheduleOptimize();
 }
 
 bool TaskManager::hasRunningTask() const
 {
-    return currentTask && currentTask->isRunning();
+    // 段合并期间排队的任务也视为正在执行
+    return currentTask && (currentTask->isRunning() || isOptimizing());
+}
+
+void TaskManager::startPendingTask()
+{
+    while (!pendingTasks.isEmpty()) {
+        const PendingTask task = pendingTasks.dequeue();
+        if (startTask(task.type, task.path))
+            return;
+
+        // 让等待该任务的调用方收到结束通知
+        emit taskFinished(typeToString(task.type), task.path, false);
+    }
+}
+
+bool TaskManager::isOptimizing() const
+{
+    return currentTask && currentTask->taskType() == IndexTask::Type::Optimize;
+}
+
+void TaskManager::scheduleOptimize()
+{
+    needOptimize = true;
+    const int idleSecs = IndexConfig::writerOptions().optimizeIdleSecs;
+    fmDebug() << "Schedule index optimize after" << idleSecs << "seconds idle";
+    optimizeTimer.start(idleSecs * 1000);
+}
+
+void TaskManager::onOptimizeTimeout()
+{
+    if (!needOptimize)
+        return;
+
+    if (currentTask) {
+        optimizeTimer.start();
+        return;
+    }
+
+    needOptimize = false;
+    startTask(IndexTask::Type::Optimize, indexStorePath());
 }
 
 void TaskManager::stopCurrentTask()
 {
+    // 排队中的任务直接取消
+    while (!pendingTasks.isEmpty()) {
+        const PendingTask task = pendingTasks.dequeue();
+        emit taskFinished(typeToString(task.type), task.path, false);
+    }
+
     if (currentTask) {
         fmInfo() << "Stopping current task...";
         currentTask->stop();
@@ -256,6 +346,9 @@ void TaskManager::clearIndexDirectory()
         }
     }
     
+    // 索引重建时提取内容一并丢弃，避免沿用损坏期间写入的条目
+    ContentCache::clear();
+
     // 确保目录存在
     if (!dir.exists()) {
         dir.mkpath(".");
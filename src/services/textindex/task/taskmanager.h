@@ -10,6 +10,8 @@
 
 #include <QObject>
 #include <QThread>
+#include <QTimer>
+#include <QQueue>
 
 SERVICETEXTINDEX_BEGIN_NAMESPACE
 
@@ -33,14 +35,28 @@ Q_SIGNALS:
 private Q_SLOTS:
     void onTaskProgress(IndexTask::Type type, qint64 count);
     void onTaskFinished(IndexTask::Type type, bool success);
+    void onOptimizeTimeout();
 
 private:
+    bool isOptimizing() const;
+    void scheduleOptimize();
+    void startPendingTask();
     void cleanupTask();
     void clearIndexDirectory();
 
     QThread workerThread;
     IndexTask *currentTask { nullptr };
 
+    // 段合并在空闲时执行，期间收到的任务排队等待
+    QTimer optimizeTimer;
+    bool needOptimize { false };
+    struct PendingTask
+    {
+        IndexTask::Type type;
+        QString path;
+    };
+    QQueue<PendingTask> pendingTasks;
+
     static QString typeToString(IndexTask::Type type);
 };
 
@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "contentcache.h"
+#include "docutils.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <algorithm>
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+namespace ContentCache {
+
+namespace {
+// 小文件解析很快，缓存收益不如开销
+constexpr qint64 kMinCacheFileSize = 16 * 1024;
+constexpr int kCacheVersion = 1;
+
+QString entryPath(const QByteArray &key)
+{
+    // 按前两位分目录，避免单目录文件过多
+    return cacheStorePath() + "/" + QString::fromLatin1(key.left(2)) + "/" + QString::fromLatin1(key);
+}
+}   // namespace
+
+QString cacheStorePath()
+{
+    static const QString kPath = QFileInfo(indexStorePath()).absolutePath() + "/index-content-cache";
+    return kPath;
+}
+
+QByteArray fileKey(const QString &filePath)
+{
+    QFile file(filePath);
+    if (file.size() < kMinCacheFileSize || !file.open(QIODevice::ReadOnly))
+        return {};
+
+    QCryptographicHash hash(QCryptographicHash::Blake2b_256);
+    // 后缀决定解析方式，相同内容不同后缀的提取结果可能不同
+    hash.addData(QByteArray::number(kCacheVersion));
+    hash.addData(QFileInfo(filePath).suffix().toLower().toUtf8());
+    if (!hash.addData(&file))
+        return {};
+
+    return hash.result().toHex();
+}
+
+std::optional<QString> load(const QByteArray &key)
+{
+    QFile file(entryPath(key));
+    if (!file.open(QIODevice::ReadOnly))
+        return std::nullopt;
+
+    const QByteArray &blob = file.readAll();
+    file.close();
+    // 空文件表示提取结果为空文本（如纯图片PDF），不是损坏条目
+    const QByteArray &data = blob.isEmpty() ? QByteArray() : qUncompress(blob);
+    if (!blob.isEmpty() && data.isEmpty()) {
+        fmWarning() << "Drop broken content cache entry:" << file.fileName();
+        file.remove();
+        return std::nullopt;
+    }
+
+    // 更新修改时间用于淘汰
+    if (file.open(QIODevice::ReadWrite)) {
+        file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        file.close();
+    }
+
+    return QString::fromUtf8(data);
+}
+
+void store(const QByteArray &key, const QString &content)
+{
+    const QString &path = entryPath(key);
+    if (!QDir().mkpath(QFileInfo(path).absolutePath()))
+        return;
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    if (!content.isEmpty())
+        file.write(qCompress(content.toUtf8()));
+    if (!file.commit())
+        fmWarning() << "Failed to write content cache entry:" << path;
+}
+
+std::optional<QString> extractFileContent(const QString &filePath)
+{
+    const QByteArray &key = fileKey(filePath);
+    if (!key.isEmpty()) {
+        auto cached = load(key);
+        if (cached)
+            return cached;
+    }
+
+    auto content = DocUtils::extractFileContent(filePath);
+    if (content && !key.isEmpty())
+        store(key, content.value());
+
+    return content;
+}
+
+void prune(qint64 maxBytes)
+{
+    struct Entry
+    {
+        QString path;
+        qint64 size;
+        QDateTime modified;
+    };
+
+    QList<Entry> entries;
+    qint64 total = 0;
+    QDirIterator it(cacheStorePath(), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo &info = it.fileInfo();
+        entries.append({ info.filePath(), info.size(), info.lastModified() });
+        total += info.size();
+    }
+
+    if (total <= maxBytes)
+        return;
+
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.modified < b.modified;
+    });
+
+    for (const auto &entry : entries) {
+        if (total <= maxBytes)
+            break;
+        if (QFile::remove(entry.path))
+            total -= entry.size;
+    }
+
+    fmInfo() << "Content cache pruned to" << total << "bytes";
+}
+
+void clear()
+{
+    QDir(cacheStorePath()).removeRecursively();
+}
+
+}   // namespace ContentCache
+
+SERVICETEXTINDEX_END_NAMESPACE
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CONTENTCACHE_H
+#define CONTENTCACHE_H
+
+#include "service_textindex_global.h"
+
+#include <QString>
+#include <QByteArray>
+
+#include <optional>
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+/**
+ * Content-addressed cache of extracted document text, stored next to the index.
+ * Entries are keyed by a hash of the file bytes, so copies, moves, restores and
+ * touched files reuse the text extracted before instead of parsing again.
+ */
+namespace ContentCache {
+
+/**
+ * @brief Computes the cache key of a file from its contents
+ * @param filePath Path to the file
+ * @return Hex digest, or an empty array if the file should not be cached
+ */
+QByteArray fileKey(const QString &filePath);
+
+/**
+ * @brief Loads previously extracted text
+ * @param key Key returned by fileKey
+ * @return Cached UTF-8 text, or an empty optional on a cache miss
+ */
+std::optional<QString> load(const QByteArray &key);
+
+/**
+ * @brief Stores extracted text compressed on disk
+ *        Empty text is stored as an empty entry so it is not taken for a broken one
+ * @param key Key returned by fileKey
+ * @param content Extracted text
+ */
+void store(const QByteArray &key, const QString &content);
+
+/**
+ * @brief Extracts file content through the cache
+ * @param filePath Path to the file
+ * @return Extracted text content or empty optional if extraction failed
+ */
+std::optional<QString> extractFileContent(const QString &filePath);
+
+/**
+ * @brief Removes the least recently used entries until the cache fits the budget
+ * @param maxBytes Size budget of the cache directory
+ */
+void prune(qint64 maxBytes);
+
+/**
+ * @brief Removes the whole cache
+ */
+void clear();
+
+QString cacheStorePath();
+
+}   // namespace ContentCache
+
+SERVICETEXTINDEX_END_NAMESPACE
+
+#endif   // CONTENTCACHE_H
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "indexconfig.h"
+
+#include <DConfig>
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+namespace IndexConfig {
+
+IndexWriterOptions writerOptions()
+{
+    IndexWriterOptions options;
+    auto config = Dtk::Core::DConfig::create("org.deepin.dde.file-manager",
+                                             "org.deepin.dde.file-manager.search");
+    if (!config)
+        return options;
+
+    if (config->isValid()) {
+        options.ramBufferSizeMB = qMax(1.0, config->value("indexRamBufferSizeMB", options.ramBufferSizeMB).toDouble());
+        options.mergeFactor = qMax(2, config->value("indexMergeFactor", options.mergeFactor).toInt());
+        options.commitDocCount = qMax(1, config->value("indexCommitDocCount", options.commitDocCount).toInt());
+        options.commitIntervalMs = qMax(0, config->value("indexCommitIntervalSecs", options.commitIntervalMs / 1000).toInt()) * 1000;
+        options.optimizeIdleSecs = qMax(0, config->value("indexOptimizeIdleSecs", options.optimizeIdleSecs).toInt());
+        options.contentCacheSizeMB = qMax(0, config->value("indexContentCacheSizeMB", options.contentCacheSizeMB).toInt());
+    }
+
+    config->deleteLater();
+    return options;
+}
+
+}   // namespace IndexConfig
+
+SERVICETEXTINDEX_END_NAMESPACE
@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INDEXCONFIG_H
+#define INDEXCONFIG_H
+
+#include "service_textindex_global.h"
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+// 索引写入参数，来自 org.deepin.dde.file-manager.search 配置
+struct IndexWriterOptions
+{
+    double ramBufferSizeMB { 64.0 };   // 内存缓冲区大小，写满后刷新到磁盘
+    int mergeFactor { 10 };   // 段合并因子
+    int commitDocCount { 1000 };   // 累计多少文档提交一次
+    int commitIntervalMs { 10000 };   // 距上次提交多久后提交一次
+    int optimizeIdleSecs { 300 };   // 空闲多久后合并索引
+    int contentCacheSizeMB { 512 };   // 文本提取缓存上限
+};
+
+namespace IndexConfig {
+
+// 每次调用都重新读取配置
+IndexWriterOptions writerOptions();
+
+}   // namespace IndexConfig
+
+SERVICETEXTINDEX_END_NAMESPACE
+
+#endif   // INDEXCONFIG_H
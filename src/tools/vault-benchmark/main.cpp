@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 保险箱读写性能测试：在指定目录（默认为已解锁的保险箱目录）中测量
+// 不同写入粒度下的顺序读写吞吐量，以及小文件的创建、读取、删除速率。
+// 用于对比不同 cryfs 块大小（vaultBlockSize）和加密算法下的实际表现，
+// 每种配置需要重新创建保险箱后分别运行一次。
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+static QTextStream out(stdout);
+
+static double mibPerSecond(qint64 bytes, qint64 nsecs)
+{
+    return nsecs > 0 ? bytes / (1024.0 * 1024.0) / (nsecs / 1e9) : 0;
+}
+
+static double opsPerSecond(int count, qint64 nsecs)
+{
+    return nsecs > 0 ? count / (nsecs / 1e9) : 0;
+}
+
+// 丢弃文件在内核页缓存中的内容，使读测试真正经过文件系统
+static void dropCache(const QByteArray &path)
+{
+    int fd = ::open(path.constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return;
+    ::fdatasync(fd);
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+}
+
+static bool sequential(const QString &dir, qint64 fileSize, qint64 chunkSize)
+{
+    const QByteArray &path = QFile::encodeName(dir + "/.dfm-vault-benchmark-seq");
+    QByteArray chunk(int(chunkSize), '\0');
+    for (int i = 0; i < chunk.size(); ++i)
+        chunk[i] = char(i * 131 + 7);
+
+    int fd = ::open(path.constData(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        out << "open " << path << " failed: " << strerror(errno) << Qt::endl;
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (qint64 written = 0; written < fileSize;) {
+        const ssize_t ret = ::write(fd, chunk.constData(), size_t(qMin(chunkSize, fileSize - written)));
+        if (ret <= 0) {
+            out << "write failed: " << strerror(errno) << Qt::endl;
+            ::close(fd);
+            ::unlink(path.constData());
+            return false;
+        }
+        written += ret;
+    }
+    ::fsync(fd);
+    ::close(fd);
+    const qint64 writeTime = timer.nsecsElapsed();
+
+    dropCache(path);
+    fd = ::open(path.constData(), O_RDONLY | O_CLOEXEC);
+    qint64 total = 0;
+    timer.restart();
+    for (ssize_t ret = 0; fd >= 0 && (ret = ::read(fd, chunk.data(), size_t(chunkSize))) > 0;)
+        total += ret;
+    const qint64 readTime = timer.nsecsElapsed();
+    if (fd >= 0)
+        ::close(fd);
+    ::unlink(path.constData());
+
+    out << QString("sequential  chunk %1 KiB: write %2 MiB/s, read %3 MiB/s")
+                    .arg(chunkSize / 1024, 5)
+                    .arg(mibPerSecond(fileSize, writeTime), 8, 'f', 1)
+                    .arg(mibPerSecond(total, readTime), 8, 'f', 1)
+        << Qt::endl;
+    return true;
+}
+
+static bool smallFiles(const QString &dir, int count, int fileSize)
+{
+    QDir base(dir);
+    const QString &subDir = ".dfm-vault-benchmark-small";
+    if (!base.mkpath(subDir)) {
+        out << "create " << base.filePath(subDir) << " failed" << Qt::endl;
+        return false;
+    }
+
+    const QString &root = base.filePath(subDir);
+    const QByteArray content(fileSize, 'v');
+    QElapsedTimer timer;
+
+    timer.start();
+    for (int i = 0; i < count; ++i) {
+        QFile file(QString("%1/%2").arg(root).arg(i));
+        if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size()) {
+            out << "write " << file.fileName() << " failed: " << file.errorString() << Qt::endl;
+            QDir(root).removeRecursively();
+            return false;
+        }
+    }
+    ::sync();
+    const qint64 createTime = timer.nsecsElapsed();
+
+    for (int i = 0; i < count; ++i)
+        dropCache(QFile::encodeName(QString("%1/%2").arg(root).arg(i)));
+
+    timer.restart();
+    for (int i = 0; i < count; ++i) {
+        QFile file(QString("%1/%2").arg(root).arg(i));
+        if (file.open(QIODevice::ReadOnly))
+            file.readAll();
+    }
+    const qint64 readTime = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int i = 0; i < count; ++i)
+        QFile::remove(QString("%1/%2").arg(root).arg(i));
+    ::sync();
+    const qint64 removeTime = timer.nsecsElapsed();
+    base.rmdir(subDir);
+
+    out << QString("small files %1 x %2 B: create %3/s, read %4/s, delete %5/s")
+                    .arg(count)
+                    .arg(fileSize)
+                    .arg(opsPerSecond(count, createTime), 0, 'f', 0)
+                    .arg(opsPerSecond(count, readTime), 0, 'f', 0)
+                    .arg(opsPerSecond(count, removeTime), 0, 'f', 0)
+        << Qt::endl;
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("dfm-vault-benchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measure file throughput inside an unlocked vault.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("dir", "Directory to test, defaults to the unlocked vault.");
+    QCommandLineOption sizeOption("size", "Size of the sequential test file in MiB.", "MiB", "256");
+    QCommandLineOption chunksOption("chunks", "Comma separated write sizes in KiB.", "KiB", "64,256,1024,4096");
+    QCommandLineOption filesOption("files", "Number of small files.", "count", "1000");
+    QCommandLineOption fileSizeOption("file-size", "Size of each small file in bytes.", "bytes", "4096");
+    parser.addOptions({ sizeOption, chunksOption, filesOption, fileSizeOption });
+    parser.process(app);
+
+    QString dir = QDir::homePath() + "/.config/Vault/vault_unlocked";
+    if (!parser.positionalArguments().isEmpty())
+        dir = parser.positionalArguments().first();
+    if (!QFileInfo(dir).isDir() || !QFileInfo(dir).isWritable()) {
+        out << dir << " is not a writable directory, is the vault unlocked?" << Qt::endl;
+        return 1;
+    }
+
+    out << "testing " << dir << Qt::endl;
+    const qint64 fileSize = parser.value(sizeOption).toLongLong() * 1024 * 1024;
+    for (const QString &chunk : parser.value(chunksOption).split(',', Qt::SkipEmptyParts)) {
+        const qint64 chunkSize = chunk.trimmed().toLongLong() * 1024;
+        if (chunkSize <= 0 || fileSize <= 0)
+            continue;
+        if (!sequential(dir, fileSize, chunkSize))
+            return 1;
+    }
+
+    const int count = parser.value(filesOption).toInt();
+    const int smallSize = parser.value(fileSizeOption).toInt();
+    if (count > 0 && smallSize >= 0 && !smallFiles(dir, count, smallSize))
+        return 1;
+
+    return 0;
+}
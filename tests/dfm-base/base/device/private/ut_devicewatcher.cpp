@@ -283,11 +283,25 @@ protected:
     }
     virtual void TearDown() override
     {
+        waitQueryFinished();
         stub.clear();
         delete watcher;
         watcher = nullptr;
     }
 
+    // the queries run in the thread pool and must not outlive the watcher
+    void waitQueryFinished()
+    {
+        forever {
+            {
+                QMutexLocker locker(&pd->sampleMutex);
+                if (!pd->isQueryingBlocks && pd->queryingDevices.isEmpty())
+                    return;
+            }
+            QThread::msleep(1);
+        }
+    }
+
 private:
     stub_ext::StubExt stub;
     DeviceWatcher *watcher { nullptr };
@@ -414,6 +428,149 @@ TEST_F(UT_DeviceWatcherPrivate, QueryUsageOfProtocol)
     //    EXPECT_EQ(expected.used, real.used);
 }
 
+TEST_F(UT_DeviceWatcherPrivate, PublishUsage)
+{
+    const QString id { "/org/freedesktop/UDisks2/block_devices/sdb1" };
+    pd->sampledDevices.insert(id);
+    EXPECT_TRUE(pd->publishUsage(id, { 102400, 1024, 102400 - 1024 }));
+    EXPECT_EQ(10000, pd->usageSamples.value(id).interval);
+
+    // unchanged usage is sampled slower and slower
+    EXPECT_FALSE(pd->publishUsage(id, { 102400, 1024, 102400 - 1024 }));
+    EXPECT_EQ(20000, pd->usageSamples.value(id).interval);
+    EXPECT_FALSE(pd->publishUsage(id, { 102400, 1024, 102400 - 1024 }));
+    EXPECT_FALSE(pd->publishUsage(id, { 102400, 1024, 102400 - 1024 }));
+    EXPECT_EQ(30000, pd->usageSamples.value(id).interval);
+
+    EXPECT_TRUE(pd->publishUsage(id, { 102400, 512, 102400 - 512 }));
+    EXPECT_EQ(10000, pd->usageSamples.value(id).interval);
+
+    pd->removeUsageSample(id);
+    EXPECT_FALSE(pd->usageSamples.contains(id));
+}
+
+TEST_F(UT_DeviceWatcherPrivate, PublishUsageAfterRemoved)
+{
+    const QString id { "/org/freedesktop/UDisks2/block_devices/loop1" };
+    bool emitted { false };
+    QObject::connect(DevMngIns, &DeviceManager::devSizeChanged, watcher, [&] { emitted = true; }, Qt::DirectConnection);
+
+    stub.set_lamda(&DeviceWatcherPrivate::isUsageSampleDue, [] { __DBG_STUB_INVOKE__ return true; });
+    QMutex queryMutex;
+    queryMutex.lock();
+    std::atomic_bool querying { false };
+    stub.set_lamda(&DeviceWatcherPrivate::queryUsageOfItem, [&](DeviceWatcherPrivate *d, const QVariantMap &, DFMMOUNT::DeviceType type) {
+        __DBG_STUB_INVOKE__
+        if (type != DFMMOUNT::DeviceType::kBlockDevice)
+            return;
+        querying = true;
+        // the device is removed while its usage is being queried
+        QMutexLocker locker(&queryMutex);
+        d->publishUsage(id, { 102400, 1024, 102400 - 1024 });
+    });
+
+    pd->queryUsageAsync();
+    while (!querying)
+        QThread::msleep(1);
+    pd->allBlockInfos.remove(id);
+    pd->removeUsageSample(id);
+    queryMutex.unlock();
+    waitQueryFinished();
+
+    EXPECT_FALSE(pd->usageSamples.contains(id));
+    EXPECT_FALSE(emitted);
+    QObject::disconnect(DevMngIns, &DeviceManager::devSizeChanged, watcher, nullptr);
+
+    // devices still present are published as usual
+    pd->queryUsageAsync();
+    waitQueryFinished();
+    EXPECT_FALSE(pd->sampledDevices.contains(id));
+    EXPECT_TRUE(pd->sampledDevices.contains("smb://1.2.3.4/hello"));
+}
+
+TEST_F(UT_DeviceWatcherPrivate, HungProtocolQuery)
+{
+    const QString hungId { "smb://1.2.3.4/hello" };
+    const QString otherId { "ftp://5.6.7.8/" };
+    pd->allProtocolInfos[hungId] = { { "Id", hungId } };
+    pd->allProtocolInfos[otherId] = { { "Id", otherId } };
+
+    stub.set_lamda(&DeviceWatcherPrivate::isUsageSampleDue, [] { __DBG_STUB_INVOKE__ return true; });
+    QMutex hungMutex;
+    hungMutex.lock();
+    std::atomic_int hungQueried { 0 };
+    std::atomic_int otherQueried { 0 };
+    std::atomic_int blockQueried { 0 };
+    stub.set_lamda(&DeviceWatcherPrivate::queryUsageOfItem, [&](DeviceWatcherPrivate *, const QVariantMap &data, DFMMOUNT::DeviceType type) {
+        __DBG_STUB_INVOKE__
+        if (type == DFMMOUNT::DeviceType::kBlockDevice) {
+            ++blockQueried;
+        } else if (data.value("Id").toString() == hungId) {
+            // gvfs never returns the size of this device
+            ++hungQueried;
+            QMutexLocker locker(&hungMutex);
+        } else {
+            ++otherQueried;
+        }
+    });
+    auto isQuerying = [this](const QString &id) {
+        QMutexLocker locker(&pd->sampleMutex);
+        return pd->queryingDevices.contains(id);
+    };
+    auto waitOthers = [&] {
+        while (pd->isQueryingBlocks || isQuerying(otherId))
+            QThread::msleep(1);
+    };
+
+    pd->queryUsageAsync();
+    while (hungQueried == 0)
+        QThread::msleep(1);
+    waitOthers();
+
+    // the hung device is skipped while its query is running, the others are still sampled
+    pd->queryUsageAsync();
+    waitOthers();
+    pd->queryUsageAsync();
+    waitOthers();
+    EXPECT_EQ(1, hungQueried);
+    EXPECT_EQ(3, otherQueried);
+    EXPECT_EQ(3, blockQueried);
+    EXPECT_TRUE(isQuerying(hungId));
+
+    hungMutex.unlock();
+    while (isQuerying(hungId))
+        QThread::msleep(1);
+    pd->queryUsageAsync();
+    waitOthers();
+    while (isQuerying(hungId))
+        QThread::msleep(1);
+    EXPECT_EQ(2, hungQueried);
+}
+
+TEST_F(UT_DeviceWatcherPrivate, IsUsageSampleDue)
+{
+    const QString id { "/org/freedesktop/UDisks2/block_devices/sdb1" };
+    const QVariantMap info { { "Device", "/dev/sdb1" } };
+    EXPECT_TRUE(pd->isUsageSampleDue(id, info, DFMMOUNT::DeviceType::kBlockDevice));
+
+    qint64 sectors = 100;
+    stub.set_lamda(&DeviceWatcherPrivate::readWrittenSectors, [&] { __DBG_STUB_INVOKE__ return sectors; });
+    pd->sampledDevices.insert(id);
+    pd->publishUsage(id, { 102400, 1024, 102400 - 1024 });
+    EXPECT_FALSE(pd->isUsageSampleDue(id, info, DFMMOUNT::DeviceType::kBlockDevice));
+
+    // the device is being written
+    sectors = 200;
+    EXPECT_FALSE(pd->isUsageSampleDue(id, info, DFMMOUNT::DeviceType::kBlockDevice));
+    EXPECT_EQ(2000, pd->usageSamples.value(id).interval);
+    pd->usageSamples[id].lastSampleTime -= 2000;
+    EXPECT_TRUE(pd->isUsageSampleDue(id, info, DFMMOUNT::DeviceType::kBlockDevice));
+
+    // writing keeps the short interval as long as the usage changes
+    pd->publishUsage(id, { 102400, 512, 102400 - 512 });
+    EXPECT_EQ(2000, pd->usageSamples.value(id).interval);
+}
+
 class UT_DevStorage : public testing::Test
 {
 protected:
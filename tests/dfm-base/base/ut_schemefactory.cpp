@@ -5,6 +5,7 @@
 #include "stubext.h"
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/utils/fileutils.h>
+#include <dfm-base/utils/infocache.h>
 
 #include <gtest/gtest.h>
 
@@ -45,3 +46,25 @@ TEST_F(UT_InfoFactory, Bug_199927_199517_scheme)
     stub.set_lamda(&dfmio::DFileInfo::attribute, []{ __DBG_STUB_INVOKE__ return true; });
     EXPECT_EQ("asyncfile", infoFactory.scheme(url));
 }
+
+TEST_F(UT_InfoFactory, CreateDropsInsertInvalidatedDuringCreate)
+{
+    // 非 file scheme 走通用创建路径，创建期间该 url 被移除时不写回缓存
+    static const QString kScheme("ut-infofactory");
+    static bool invalidateOnCreate = true;
+    InfoFactory::regCreator(kScheme, [](const QUrl &url) {
+        if (invalidateOnCreate)
+            emit InfoCacheController::instance().removeCacheFileInfo({ url });
+        return QSharedPointer<FileInfo>(new FileInfo(url));
+    });
+
+    const QUrl url(kScheme + ":///a");
+    EXPECT_TRUE(InfoFactory::create<FileInfo>(url));
+    EXPECT_FALSE(InfoCacheController::instance().getCacheInfo(url));
+
+    invalidateOnCreate = false;
+    auto info = InfoFactory::create<FileInfo>(url);
+    EXPECT_TRUE(info);
+    EXPECT_EQ(info, InfoCacheController::instance().getCacheInfo(url));
+    emit InfoCacheController::instance().removeCacheFileInfo({ url });
+}
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/mimetype/mimecache.h"
+#include "dfm-base/mimetype/private/mimecache_p.h"
+
+#include "stubext.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+
+TEST(UT_MimeCache, testLookupAndInsert)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    MimeCache cache(dir.filePath("mime-cache"));
+    ASSERT_TRUE(cache.isValid());
+
+    const QString &filePath = dir.filePath("a.txt");
+    QFile file(filePath);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("hello");
+    file.close();
+
+    MimeCache::Key key;
+    ASSERT_TRUE(MimeCache::makeKey(filePath, 0, &key));
+    EXPECT_TRUE(cache.lookup(key).isEmpty());
+
+    cache.insert(key, "text/plain");
+    EXPECT_EQ(cache.lookup(key), "text/plain");
+
+    // 另一种匹配模式不命中
+    MimeCache::Key contentKey = key;
+    contentKey.mode = 2;
+    EXPECT_TRUE(cache.lookup(contentKey).isEmpty());
+
+    // 文件被修改后不命中
+    MimeCache::Key modified = key;
+    modified.size += 1;
+    EXPECT_TRUE(cache.lookup(modified).isEmpty());
+
+    cache.clear();
+    EXPECT_TRUE(cache.lookup(key).isEmpty());
+}
+
+TEST(UT_MimeCache, testSharedBetweenInstances)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    MimeCache::Key key;
+    key.dev = 1;
+    key.ino = 42;
+    key.mtime = 1000;
+    key.size = 10;
+
+    MimeCache writer(dir.filePath("mime-cache"));
+    writer.insert(key, "image/png");
+
+    MimeCache reader(dir.filePath("mime-cache"));
+    EXPECT_EQ(reader.lookup(key), "image/png");
+}
+
+TEST(UT_MimeCache, testOnlyRegularFiles)
+{
+    MimeCache::Key key;
+    EXPECT_FALSE(MimeCache::makeKey("/tmp", 0, &key));
+    EXPECT_FALSE(MimeCache::makeKey("/nonexistent/ut_mimecache", 0, &key));
+}
+
+TEST(UT_MimeCache, testDatabaseChangeChecked)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    MimeCache cache(dir.filePath("mime-cache"));
+    MimeCache::Key key;
+    key.dev = 1;
+    key.ino = 7;
+    cache.insert(key, "text/plain");
+
+    const qint64 stamp = MimeCache::databaseStamp();
+    stub_ext::StubExt stub;
+    stub.set_lamda(&MimeCache::databaseStamp, [stamp] { __DBG_STUB_INVOKE__ return stamp + 1; });
+
+    // 检查间隔内不重复读取数据库时间
+    EXPECT_EQ(cache.lookup(key), "text/plain");
+
+    cache.nextStampCheck = 0;
+    EXPECT_TRUE(cache.lookup(key).isEmpty());
+    cache.insert(key, "text/plain");
+    cache.nextStampCheck = 0;
+    EXPECT_EQ(cache.lookup(key), "text/plain");
+}
+
+TEST(UT_MimeCache, testReclaimStuckSlot)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    MimeCache cache(dir.filePath("mime-cache"));
+    MimeCache::Key key;
+    key.dev = 1;
+    key.ino = 9;
+    cache.insert(key, "text/plain");
+
+    // 模拟写入方在写入中途退出，seq 停留在奇数
+    const quint32 index = slotIndex(key);
+    auto slots = reinterpret_cast<CacheSlot *>(cache.data + sizeof(CacheHeader));
+    slots[index].seq.fetch_add(1);
+    EXPECT_TRUE(cache.lookup(key).isEmpty());
+
+    cache.insert(key, "image/png");
+    EXPECT_TRUE(cache.lookup(key).isEmpty());
+    ASSERT_TRUE(cache.stuckSlots.contains(index));
+
+    cache.stuckSlots[index].second -= 2000;
+    cache.insert(key, "image/png");
+    EXPECT_EQ(cache.lookup(key), "image/png");
+    EXPECT_EQ(slots[index].seq.load() % 2, 0u);
+}
@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/utils/elidetextlayout.h"
+
+#include <QImage>
+#include <QPainter>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+
+TEST(UT_ElideTextLayout, testCachedLayoutMatches)
+{
+    const QString name("a_very_long_file_name_that_needs_to_wrap_and_elide_somewhere.txt");
+    const QRectF rect(0, 0, 80, 60);
+
+    QStringList firstLines;
+    ElideTextLayout first(name);
+    const QList<QRectF> &firstRects = first.layout(rect, Qt::ElideMiddle, nullptr, Qt::NoBrush, &firstLines);
+    ASSERT_FALSE(firstRects.isEmpty());
+
+    // 第二次排版命中缓存，不再创建文档
+    QStringList secondLines;
+    ElideTextLayout second(name);
+    const QList<QRectF> &secondRects = second.layout(rect.translated(100, 50), Qt::ElideMiddle, nullptr, Qt::NoBrush, &secondLines);
+    EXPECT_EQ(second.document, nullptr);
+    EXPECT_EQ(secondLines, firstLines);
+    ASSERT_EQ(secondRects.size(), firstRects.size());
+    for (int i = 0; i < firstRects.size(); ++i)
+        EXPECT_EQ(secondRects.at(i), firstRects.at(i).translated(100, 50));
+}
+
+TEST(UT_ElideTextLayout, testDocumentHandleBypassesCache)
+{
+    const QString name("ut_elidetextlayout_document.txt");
+    ElideTextLayout layout(name);
+    layout.layout(QRectF(0, 0, 200, 40), Qt::ElideRight);
+
+    ElideTextLayout modified(name);
+    modified.documentHandle();
+    QImage image(200, 40, QImage::Format_ARGB32);
+    QPainter painter(&image);
+    modified.layout(QRectF(0, 0, 200, 40), Qt::ElideRight, &painter);
+    EXPECT_NE(modified.document, nullptr);
+}
@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+
+#include <dfm-base/utils/fileinfohelper.h>
+#include <dfm-base/file/local/asyncfileinfo.h>
+
+#include <QUrl>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+
+class UT_FileInfoHelper : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        stub.set_lamda(&AsyncFileInfo::asyncQueryDfmFileInfo, [this](AsyncFileInfo *info, int, FileInfo::initQuerierAsyncCallback, void *) {
+            __DBG_STUB_INVOKE__
+            started.append(info->fileUrl());
+            return true;
+        });
+
+        // 占满并发名额，请求全部进入排队
+        for (int i = 0; i < 16; ++i)
+            helper.runningQueries.insert(QUrl(QString("test:///busy/%1").arg(i)), ++helper.querySerial);
+    }
+    void TearDown() override
+    {
+        helper.removeViewport(kViewId);
+        helper.runningQueries.clear();
+        helper.pendingRefresh.clear();
+        for (auto &queue : helper.refreshQueues)
+            queue.clear();
+        helper.pendingJobs.clear();
+        for (auto &queue : helper.jobQueues)
+            queue.clear();
+        helper.runningJobs = 0;
+        helper.qureingInfo.clearByLock();
+        stub.clear();
+    }
+
+    QSharedPointer<FileInfo> enqueue(const QString &name)
+    {
+        QSharedPointer<FileInfo> info(new AsyncFileInfo(QUrl::fromLocalFile("/tmp/ut_fileinfohelper/" + name)));
+        infos.append(info);
+        helper.enqueueRefresh(info);
+        return info;
+    }
+
+    void releaseBusy(int count)
+    {
+        const auto busy = helper.runningQueries;
+        for (auto it = busy.cbegin(); it != busy.cend() && count > 0; ++it) {
+            if (it.key().scheme() != "test")
+                continue;
+            helper.queryFinished(it.key(), it.value());
+            --count;
+        }
+    }
+
+    static constexpr quintptr kViewId { 1 };
+    FileInfoHelper &helper { FileInfoHelper::instance() };
+    QList<QSharedPointer<FileInfo>> infos;
+    QList<QUrl> started;
+    stub_ext::StubExt stub;
+};
+
+TEST_F(UT_FileInfoHelper, testVisibleFirst)
+{
+    enqueue("a");
+    enqueue("b");
+    enqueue("c");
+    EXPECT_TRUE(started.isEmpty());
+
+    helper.updateViewport(kViewId, { QUrl::fromLocalFile("/tmp/ut_fileinfohelper/c") },
+                          { QUrl::fromLocalFile("/tmp/ut_fileinfohelper/b") });
+    releaseBusy(3);
+
+    const QList<QUrl> expected { QUrl::fromLocalFile("/tmp/ut_fileinfohelper/c"),
+                                 QUrl::fromLocalFile("/tmp/ut_fileinfohelper/b"),
+                                 QUrl::fromLocalFile("/tmp/ut_fileinfohelper/a") };
+    // 有视图提示时后台请求也会补齐，但排在可见与邻近之后
+    ASSERT_EQ(started.size(), 3);
+    EXPECT_EQ(started, expected);
+}
+
+TEST_F(UT_FileInfoHelper, testScrolledOutDeprioritized)
+{
+    const QUrl a = QUrl::fromLocalFile("/tmp/ut_fileinfohelper/a");
+    const QUrl b = QUrl::fromLocalFile("/tmp/ut_fileinfohelper/b");
+    helper.updateViewport(kViewId, { a }, {});
+    enqueue("a");
+    enqueue("b");
+    EXPECT_EQ(helper.pendingRefresh.value(a).priority, FileInfoHelper::kVisible);
+
+    // 滚动后 a 移出视野，b 进入视野
+    helper.updateViewport(kViewId, { b }, {});
+    EXPECT_EQ(helper.pendingRefresh.value(a).priority, FileInfoHelper::kBackground);
+    EXPECT_EQ(helper.pendingRefresh.value(b).priority, FileInfoHelper::kVisible);
+
+    releaseBusy(1);
+    ASSERT_EQ(started.size(), 1);
+    EXPECT_EQ(started.first(), b);
+}
+
+TEST_F(UT_FileInfoHelper, testViewportUpdateOnlyTouchesChangedUrls)
+{
+    for (int i = 0; i < 200; ++i)
+        enqueue(QString::number(i));
+    const int queued = helper.refreshQueues[FileInfoHelper::kBackground].size();
+
+    // 视野变化只追加进出视野的文件，不重建整个队列
+    helper.updateViewport(kViewId, { QUrl::fromLocalFile("/tmp/ut_fileinfohelper/5") }, {});
+    EXPECT_EQ(helper.refreshQueues[FileInfoHelper::kBackground].size(), queued);
+    EXPECT_EQ(helper.refreshQueues[FileInfoHelper::kVisible].size(), 1);
+
+    // 反复滚动产生的残留项会被压缩，不会无限增长
+    for (int i = 0; i < 1000; ++i)
+        helper.updateViewport(kViewId, { QUrl::fromLocalFile(QString("/tmp/ut_fileinfohelper/%1").arg(i % 200)) }, {});
+    EXPECT_LE(helper.refreshQueues[FileInfoHelper::kBackground].size(), helper.pendingRefresh.size() * 2 + 64);
+    EXPECT_LE(helper.refreshQueues[FileInfoHelper::kVisible].size(), helper.pendingRefresh.size() * 2 + 64);
+}
+
+TEST_F(UT_FileInfoHelper, testVisibleCountFirst)
+{
+    QList<QUrl> counted;
+    stub.set_lamda(&FileInfoHelper::startJob, [&counted](FileInfoHelper *, const FileInfoHelper::PendingJob &job,
+                                                          const QSharedPointer<FileInfoHelperUeserData> &) {
+        __DBG_STUB_INVOKE__
+        EXPECT_EQ(job.type, FileInfoHelper::PendingJob::kFileCount);
+        counted.append(job.url);
+    });
+
+    // 工作线程已满，计数请求全部排队
+    helper.runningJobs = FileInfoHelper::kMaxRunningJobs;
+    QList<InfoHelperUeserDataPointer> results;
+    for (const QString &name : { "a", "b", "c" }) {
+        QUrl url = QUrl::fromLocalFile("/tmp/ut_fileinfohelper/" + name);
+        results.append(helper.fileCountAsync(url));
+    }
+    EXPECT_TRUE(counted.isEmpty());
+
+    const QUrl c = QUrl::fromLocalFile("/tmp/ut_fileinfohelper/c");
+    helper.updateViewport(kViewId, { c }, {});
+    helper.jobFinished();
+    ASSERT_EQ(counted.size(), 1);
+    EXPECT_EQ(counted.first(), c);
+}
+
+TEST_F(UT_FileInfoHelper, testReleasedRequestCancelled)
+{
+    QList<QUrl> started;
+    stub.set_lamda(&FileInfoHelper::startJob, [&started](FileInfoHelper *, const FileInfoHelper::PendingJob &job,
+                                                          const QSharedPointer<FileInfoHelperUeserData> &) {
+        __DBG_STUB_INVOKE__
+        started.append(job.url);
+    });
+
+    helper.runningJobs = FileInfoHelper::kMaxRunningJobs;
+    const QUrl a = QUrl::fromLocalFile("/tmp/ut_fileinfohelper/a");
+    const QUrl b = QUrl::fromLocalFile("/tmp/ut_fileinfohelper/b");
+    auto first = helper.fileMimeTypeAsync(a, QMimeDatabase::MatchDefault, QString(), false);
+    auto second = helper.fileMimeTypeAsync(b, QMimeDatabase::MatchDefault, QString(), false);
+
+    // 请求方在排队期间释放，任务不再执行
+    first.reset();
+    helper.jobFinished();
+    helper.jobFinished();
+    EXPECT_EQ(started, QList<QUrl> { b });
+}
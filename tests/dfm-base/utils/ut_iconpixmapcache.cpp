@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/utils/iconpixmapcache.h"
+
+#include <QPixmap>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+
+namespace {
+QIcon solidIcon()
+{
+    QPixmap px(64, 64);
+    px.fill(Qt::red);
+    return QIcon(px);
+}
+}
+
+TEST(UT_IconPixmapCache, testPixmapCached)
+{
+    IconPixmapCache *cache = IconPixmapCache::instance();
+    const QIcon &icon = solidIcon();
+
+    const QPixmap &first = cache->pixmap(icon, QSize(32, 32), 2.0);
+    ASSERT_FALSE(first.isNull());
+    EXPECT_EQ(first.devicePixelRatio(), 2.0);
+    EXPECT_EQ(cache->pixmap(icon, QSize(32, 32), 2.0).cacheKey(), first.cacheKey());
+    EXPECT_NE(cache->pixmap(icon, QSize(32, 32), 1.0).cacheKey(), first.cacheKey());
+
+    cache->clear();
+    EXPECT_NE(cache->pixmap(icon, QSize(32, 32), 2.0).cacheKey(), first.cacheKey());
+}
+
+TEST(UT_IconPixmapCache, testInvalidRequest)
+{
+    IconPixmapCache *cache = IconPixmapCache::instance();
+    EXPECT_TRUE(cache->pixmap(QIcon(), QSize(32, 32), 1.0).isNull());
+    EXPECT_TRUE(cache->pixmap(solidIcon(), QSize(0, 32), 1.0).isNull());
+}
+
+TEST(UT_IconPixmapCache, testEmblemComposite)
+{
+    IconPixmapCache *cache = IconPixmapCache::instance();
+    const QIcon &icon = solidIcon();
+    QPoint topLeft;
+
+    const QPixmap &first = cache->emblemComposite({ icon, icon }, { QRectF(10, 10, 16, 16), QRectF(40, 10, 16, 16) }, 1.0, &topLeft);
+    ASSERT_FALSE(first.isNull());
+    EXPECT_EQ(topLeft, QPoint(10, 10));
+    EXPECT_EQ(first.size(), QSize(46, 16));
+
+    // 同样的布局平移到其它位置命中同一张合成图
+    const QPixmap &moved = cache->emblemComposite({ icon, icon }, { QRectF(110, 210, 16, 16), QRectF(140, 210, 16, 16) }, 1.0, &topLeft);
+    EXPECT_EQ(topLeft, QPoint(110, 210));
+    EXPECT_EQ(moved.cacheKey(), first.cacheKey());
+}
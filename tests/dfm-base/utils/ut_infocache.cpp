@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/utils/infocache.h"
+#include "dfm-base/utils/private/infocache_p.h"
+
+#include <QUrl>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+
+namespace {
+class CacheTestFileInfo : public FileInfo
+{
+public:
+    explicit CacheTestFileInfo(const QUrl &url)
+        : FileInfo(url) {}
+};
+}
+
+TEST(UT_InfoCache, testCacheAndRemove)
+{
+    InfoCache &cache = InfoCache::instance();
+    const QUrl url = QUrl::fromLocalFile("/tmp/ut_infocache_a");
+    const auto before = cache.statistics();
+
+    cache.cacheInfo(url, FileInfoPointer(new CacheTestFileInfo(url)));
+    EXPECT_TRUE(cache.getCacheInfo(url));
+
+    cache.removeCaches({ url });
+    EXPECT_FALSE(cache.getCacheInfo(url));
+
+    const auto after = cache.statistics();
+    EXPECT_EQ(after.hits - before.hits, 1u);
+    EXPECT_EQ(after.misses - before.misses, 1u);
+    EXPECT_EQ(after.invalidations - before.invalidations, 1u);
+}
+
+TEST(UT_InfoCache, testGenerationRejectsStaleInsert)
+{
+    InfoCache &cache = InfoCache::instance();
+    const QUrl url = QUrl::fromLocalFile("/tmp/ut_infocache_b");
+
+    const quint64 generation = cache.generation(url);
+    // 创建 info 期间该 url 被移除
+    cache.removeCaches({ url });
+    cache.cacheInfo(url, FileInfoPointer(new CacheTestFileInfo(url)), generation);
+    EXPECT_FALSE(cache.getCacheInfo(url));
+
+    cache.cacheInfo(url, FileInfoPointer(new CacheTestFileInfo(url)), cache.generation(url));
+    EXPECT_TRUE(cache.getCacheInfo(url));
+    cache.removeCaches({ url });
+}
+
+TEST(UT_InfoCache, testRemovalOfOtherUrlKeepsInsert)
+{
+    InfoCache &cache = InfoCache::instance();
+    const QUrl url = QUrl::fromLocalFile("/tmp/ut_infocache_c");
+
+    // 大量其它文件的移除不影响正在创建的 info
+    const quint64 generation = cache.generation(url);
+    QList<QUrl> others;
+    for (int i = 0; i < 100; ++i)
+        others.append(QUrl::fromLocalFile(QString("/tmp/ut_infocache_churn/%1").arg(i)));
+    cache.removeCaches(others);
+
+    cache.cacheInfo(url, FileInfoPointer(new CacheTestFileInfo(url)), generation);
+    EXPECT_TRUE(cache.getCacheInfo(url));
+    cache.removeCaches({ url });
+}
+
+TEST(UT_InfoCache, testRemovedRecordsBounded)
+{
+    InfoCache &cache = InfoCache::instance();
+    const QUrl url = QUrl::fromLocalFile("/tmp/ut_infocache_d");
+    const quint64 generation = cache.generation(url);
+
+    QList<QUrl> others;
+    for (int i = 0; i < InfoCachePrivate::kMaxRemovedRecords * InfoCachePrivate::kShardCount * 2; ++i)
+        others.append(QUrl::fromLocalFile(QString("/tmp/ut_infocache_bound/%1").arg(i)));
+    cache.removeCaches(others);
+
+    auto &shard = cache.d_func()->shardOf(url);
+    EXPECT_LE(shard.removedAt.size(), InfoCachePrivate::kMaxRemovedRecords);
+    // 记录被清空后，清空前取得的代数保守地放弃插入
+    cache.cacheInfo(url, FileInfoPointer(new CacheTestFileInfo(url)), generation);
+    EXPECT_FALSE(cache.getCacheInfo(url));
+}
+
+TEST(UT_InfoCache, testStatisticsMap)
+{
+    const auto &map = InfoCacheController::instance().Statistics();
+    EXPECT_TRUE(map.contains("hits"));
+    EXPECT_TRUE(map.contains("rejects"));
+    EXPECT_TRUE(map.contains("memoryCost"));
+}
+
+TEST(UT_InfoCache, testEvictWithinBudget)
+{
+    InfoCache &cache = InfoCache::instance();
+    const auto before = cache.statistics();
+
+    QList<QUrl> urls;
+    for (int i = 0; i < 30000; ++i) {
+        const QUrl url = QUrl::fromLocalFile(QString("/tmp/ut_infocache_evict/%1").arg(i));
+        urls.append(url);
+        cache.cacheInfo(url, FileInfoPointer(new CacheTestFileInfo(url)));
+    }
+
+    const auto after = cache.statistics();
+    EXPECT_GT(after.evictions, before.evictions);
+    EXPECT_LE(after.memoryCost, 40 * 1024 * 1024);
+    cache.removeCaches(urls);
+}
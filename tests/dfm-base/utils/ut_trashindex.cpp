@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/utils/trashindex.h"
+
+#include "stubext.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QUrl>
+
+#include <gtest/gtest.h>
+
+#include <utime.h>
+
+DFMBASE_USE_NAMESPACE
+
+TEST(UT_TrashIndex, testParseTrashInfo)
+{
+    TrashIndex::Entry entry;
+    const QByteArray content("[Trash Info]\nPath=/home/user/a%20b.txt\nDeletionDate=2024-01-02T03:04:05\n");
+    EXPECT_TRUE(TrashIndex::parseTrashInfo("/home/user/.local/share/Trash", content, &entry));
+    EXPECT_EQ(entry.originalPath, "/home/user/a b.txt");
+    EXPECT_EQ(entry.deletionTime, QDateTime::fromString("2024-01-02T03:04:05", Qt::ISODate).toSecsSinceEpoch());
+
+    EXPECT_FALSE(TrashIndex::parseTrashInfo("/home/user/.local/share/Trash", "[Trash Info]\n", &entry));
+}
+
+TEST(UT_TrashIndex, testParseRelativePath)
+{
+    TrashIndex::Entry entry;
+    EXPECT_TRUE(TrashIndex::parseTrashInfo("/media/disk/.Trash-1000", "[Trash Info]\nPath=dir/file\n", &entry));
+    EXPECT_EQ(entry.originalPath, "/media/disk/dir/file");
+
+    EXPECT_TRUE(TrashIndex::parseTrashInfo("/media/disk/.Trash/1000", "[Trash Info]\nPath=file\n", &entry));
+    EXPECT_EQ(entry.originalPath, "/media/disk/file");
+}
+
+TEST(UT_TrashIndex, testTrashUrl)
+{
+    TrashIndex::Entry entry;
+    entry.trashDir = TrashIndex::homeTrashDir();
+    entry.name = "a.2";
+    EXPECT_EQ(entry.trashUrl().path(), "/a.2");
+
+    entry.trashDir = "/media/disk/.Trash-1000";
+    EXPECT_EQ(entry.trashUrl().path(), "/\\media\\disk\\.Trash-1000\\files\\a.2");
+    EXPECT_EQ(entry.filePath(), "/media/disk/.Trash-1000/files/a.2");
+}
+
+class UT_TrashIndexReconcile : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tmp.isValid());
+        trashDir = tmp.path() + "/Trash";
+        QDir().mkpath(trashDir + "/info");
+        QDir().mkpath(trashDir + "/files");
+
+        const QString dir = trashDir;
+        stub.set_lamda(&TrashIndex::indexFilePath, [this] { __DBG_STUB_INVOKE__ return tmp.path() + "/trash-index"; });
+        stub.set_lamda(&TrashIndex::trashDirs, [this, dir] { __DBG_STUB_INVOKE__ ++probeCount; return QStringList { dir }; });
+        index = new TrashIndex;
+    }
+    void TearDown() override
+    {
+        delete index;
+        stub.clear();
+    }
+
+    void trash(const QString &name, const QString &origin)
+    {
+        QFile(trashDir + "/files/" + name).open(QIODevice::WriteOnly);
+        QFile info(trashDir + "/info/" + name + ".trashinfo");
+        info.open(QIODevice::WriteOnly);
+        info.write("[Trash Info]\nPath=" + QUrl::toPercentEncoding(origin, "/") + "\nDeletionDate=2024-01-02T03:04:05\n");
+        info.close();
+        touchInfoDir();
+    }
+
+    void touchInfoDir()
+    {
+        // 同一时间粒度内的修改也要让 mtime 变化
+        static time_t next = 1000000;
+        struct utimbuf times { ++next, next };
+        ::utime(QFile::encodeName(trashDir + "/info").constData(), &times);
+    }
+
+    QTemporaryDir tmp;
+    QString trashDir;
+    int probeCount { 0 };
+    TrashIndex *index { nullptr };
+    stub_ext::StubExt stub;
+};
+
+TEST_F(UT_TrashIndexReconcile, testPicksUpExternalChanges)
+{
+    EXPECT_EQ(index->count(), 0);
+
+    trash("a", "/home/user/a");
+    trash("b", "/home/user/b");
+    EXPECT_EQ(index->count(), 2);
+    EXPECT_EQ(index->findTrashUrls("/home/user/a").size(), 1);
+
+    QFile::remove(trashDir + "/info/a.trashinfo");
+    touchInfoDir();
+    EXPECT_EQ(index->count(), 1);
+    EXPECT_TRUE(index->findTrashUrls("/home/user/a").isEmpty());
+}
+
+TEST_F(UT_TrashIndexReconcile, testUnchangedDirNotParsed)
+{
+    trash("a", "/home/user/a");
+    EXPECT_EQ(index->count(), 1);
+
+    // info 目录未变化时不再解析，即使文件内容被改写
+    QFile info(trashDir + "/info/a.trashinfo");
+    info.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    info.close();
+    EXPECT_EQ(index->findTrashUrls("/home/user/a").size(), 1);
+}
+
+TEST_F(UT_TrashIndexReconcile, testMountsProbedOnlyOnChange)
+{
+    index->count();
+    index->count();
+    index->entries();
+    EXPECT_EQ(probeCount, 1);
+
+    stub.set_lamda(&TrashIndex::mountTableChanged, [] { __DBG_STUB_INVOKE__ return true; });
+    index->count();
+    EXPECT_EQ(probeCount, 2);
+}
+
+TEST_F(UT_TrashIndexReconcile, testWorkerUpdatesAndSync)
+{
+    trash("a", "/home/user/a");
+    EXPECT_EQ(index->count(), 1);
+
+    index->removeEntry(TrashIndex::Entry { trashDir, "a", "/home/user/a" }.trashUrl());
+    EXPECT_TRUE(index->findTrashUrls("/home/user/a").isEmpty());
+
+    index->addEntry({ trashDir, "c", "/home/user/c", 10, 5 });
+    index->sync();
+    EXPECT_TRUE(QFile::exists(tmp.path() + "/trash-index"));
+
+    // 重新加载后保留任务写入的项
+    TrashIndex reloaded;
+    EXPECT_EQ(reloaded.dirs.value(trashDir).entries.value("c").originalPath, "/home/user/c");
+}
@@ -12,6 +12,7 @@
 #include <dfm-base/file/local/syncfileinfo.h>
 #include <dfm-base/file/local/localfilehandler.h>
 #include <dfm-base/utils/clipboard.h>
+#include <dfm-base/utils/trashindex.h>
 
 #include <dfm-framework/event/event.h>
 
@@ -60,10 +61,59 @@ TEST_F(UT_DoCleanTrashFilesWorker, testDoWork)
     EXPECT_FALSE(worker.statisticsFilesSize());
 
     worker.sourceUrls.append(FileUtils::trashRootUrl());
+    stub.set_lamda(&TrashIndex::entries, []{ __DBG_STUB_INVOKE__
+        TrashIndex::Entry entry;
+        entry.trashDir = TrashIndex::homeTrashDir();
+        entry.name = "a";
+        return QList<TrashIndex::Entry> { entry, entry };
+    });
+    EXPECT_TRUE(worker.statisticsFilesSize());
+    EXPECT_EQ(worker.allFilesList.size(), 1);
+}
+
+TEST_F(UT_DoCleanTrashFilesWorker, testStatisticsFallbackToGio)
+{
+    DoCleanTrashFilesWorker worker;
+    stub_ext::StubExt stub;
+    stub.set_lamda(&DoCleanTrashFilesWorker::saveOperations, []{ __DBG_STUB_INVOKE__ });
+    stub.set_lamda(&TrashIndex::entries, []{ __DBG_STUB_INVOKE__ return QList<TrashIndex::Entry>(); });
     int index = 0;
-    stub.set_lamda(&DEnumerator::hasNext, [&index]{ __DBG_STUB_INVOKE__ index++; return index % 2;});
-    stub.set_lamda(&DEnumerator::next, []{ __DBG_STUB_INVOKE__ return QUrl::fromLocalFile(QDir::currentPath());});
+    stub.set_lamda(&DEnumerator::hasNext, [&index]{ __DBG_STUB_INVOKE__ return index++ < 2; });
+    stub.set_lamda(&DEnumerator::next, [&index]{ __DBG_STUB_INVOKE__ return QUrl(QString("trash:///f%1").arg(index)); });
+
+    worker.sourceUrls.append(FileUtils::trashRootUrl());
     EXPECT_TRUE(worker.statisticsFilesSize());
+    EXPECT_EQ(worker.allFilesList.size(), 2);
+}
+
+TEST_F(UT_DoCleanTrashFilesWorker, testEmptyTrashCleansUnindexedFiles)
+{
+    DoCleanTrashFilesWorker worker;
+    stub_ext::StubExt stub;
+    stub.set_lamda(&DoCleanTrashFilesWorker::saveOperations, []{ __DBG_STUB_INVOKE__ });
+    stub.set_lamda(VADDR(AbstractWorker, doWork), []{ __DBG_STUB_INVOKE__ return true;});
+    stub.set_lamda(VADDR(AbstractWorker, endWork), []{ __DBG_STUB_INVOKE__ });
+    stub.set_lamda(&TrashIndex::sync, []{ __DBG_STUB_INVOKE__ });
+
+    QList<QList<QUrl>> passes;
+    stub.set_lamda(&DoCleanTrashFilesWorker::cleanAllTrashFiles, [&passes, &worker]{ __DBG_STUB_INVOKE__
+        passes.append(worker.allFilesList);
+        return true;
+    });
+    // gio 枚举出索引中没有的项，第二轮只处理这些项
+    stub.set_lamda(&DoCleanTrashFilesWorker::enumerateTrashFiles, [](DoCleanTrashFilesWorker *, const QSet<QUrl> &excluded){ __DBG_STUB_INVOKE__
+        QList<QUrl> result;
+        for (const QUrl &url : { QUrl("trash:///a"), QUrl("trash:///b") }) {
+            if (!excluded.contains(url))
+                result.append(url);
+        }
+        return result;
+    });
+
+    worker.allFilesList = { QUrl("trash:///a") };
+    EXPECT_TRUE(worker.doWork());
+    ASSERT_EQ(passes.size(), 2);
+    EXPECT_EQ(passes.at(1), QList<QUrl> { QUrl("trash:///b") });
 }
 
 TEST_F(UT_DoCleanTrashFilesWorker, testCleanAllTrashFiles)
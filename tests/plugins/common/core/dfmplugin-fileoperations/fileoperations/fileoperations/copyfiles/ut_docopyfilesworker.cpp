@@ -12,11 +12,14 @@
 #include <dfm-base/file/local/syncfileinfo.h>
 #include <dfm-base/file/local/localfilehandler.h>
 #include <dfm-base/utils/clipboard.h>
+#include <dfm-base/base/standardpaths.h>
 
 #include <dfm-framework/event/event.h>
 
 #include <gtest/gtest.h>
 
+#include <QTemporaryDir>
+
 typedef QMap<QString,QVariant> * mapValue;
 Q_DECLARE_METATYPE(mapValue);
 
@@ -137,3 +140,50 @@ TEST_F(UT_DoCopyFilesWorker, testCopyFiles)
 
     worker.onUpdateProgress();
 }
+
+TEST_F(UT_DoCopyFilesWorker, testWriteCheckSumManifest)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString cachePath = dir.path();
+    stub_ext::StubExt stub;
+    stub.set_lamda(static_cast<QString (*)(StandardPaths::StandardLocation)>(&StandardPaths::location), [cachePath]{ __DBG_STUB_INVOKE__ return cachePath; });
+
+    DoCopyFilesWorker worker;
+    worker.workData.reset(new WorkerData);
+    worker.targetOrgUrl = QUrl::fromLocalFile("/tmp/target");
+    worker.workData->verifiedCheckSums.insert(QUrl::fromLocalFile("/tmp/target/a.txt"), 0x1234abcd);
+    const QDir manifestDir(cachePath + "/verified-copies");
+    auto manifests = [&manifestDir] {
+        return manifestDir.entryList({ "*.sfv" }, QDir::Files, QDir::Name);
+    };
+
+    // 非校验拷贝不输出校验清单
+    worker.workData->jobFlags |= AbstractJobHandler::JobFlag::kCopyIntegrityChecking;
+    worker.writeCheckSumManifest();
+    EXPECT_TRUE(manifests().isEmpty());
+
+    // 未完成的拷贝输出部分清单
+    worker.workData->verifiedCopy = true;
+    worker.copyCompleted = false;
+    worker.writeCheckSumManifest();
+    ASSERT_EQ(1, manifests().size());
+    EXPECT_TRUE(manifests().first().endsWith(".partial.sfv"));
+    QFile partial(manifestDir.filePath(manifests().first()));
+    ASSERT_TRUE(partial.open(QIODevice::ReadOnly));
+    const QString partialText = QString::fromUtf8(partial.readAll());
+    EXPECT_TRUE(partialText.contains("; partial:"));
+    EXPECT_TRUE(partialText.contains("a.txt 1234ABCD"));
+    partial.close();
+    QFile::remove(partial.fileName());
+
+    worker.copyCompleted = true;
+    worker.writeCheckSumManifest();
+    ASSERT_EQ(1, manifests().size());
+    EXPECT_FALSE(manifests().first().endsWith(".partial.sfv"));
+    QFile complete(manifestDir.filePath(manifests().first()));
+    ASSERT_TRUE(complete.open(QIODevice::ReadOnly));
+    const QString completeText = QString::fromUtf8(complete.readAll());
+    EXPECT_FALSE(completeText.contains("; partial:"));
+    EXPECT_TRUE(completeText.contains("a.txt 1234ABCD"));
+}
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "plugins/common/dfmplugin-fileoperations/fileoperations/deletefiles/localdeleteengine.h"
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <atomic>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+TEST(UT_LocalDeleteEngine, testRemoveTree)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString root = tmp.path() + "/tree";
+    for (int i = 0; i < 5; ++i) {
+        const QString dir = root + QString("/d%1/sub").arg(i);
+        QDir().mkpath(dir);
+        for (int j = 0; j < 10; ++j)
+            QFile(dir + QString("/f%1").arg(j)).open(QIODevice::WriteOnly);
+    }
+    QFile::link(root + "/d0", root + "/link");
+
+    qint64 deleted = 0;
+    LocalDeleteEngine engine([&](qint64 count) { deleted += count; }, [] { return true; });
+
+    EXPECT_TRUE(engine.removeTree(root));
+    EXPECT_FALSE(QFileInfo::exists(root));
+    // 50 files + 10 dirs + link + root
+    EXPECT_EQ(deleted, 62);
+}
+
+TEST(UT_LocalDeleteEngine, testRemoveFile)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString file = tmp.path() + "/file";
+    QFile(file).open(QIODevice::WriteOnly);
+
+    LocalDeleteEngine engine(nullptr, nullptr);
+    EXPECT_TRUE(engine.removeTree(file));
+    EXPECT_FALSE(QFileInfo::exists(file));
+}
+
+TEST(UT_LocalDeleteEngine, testStopped)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    QDir().mkpath(tmp.path() + "/tree/a");
+
+    LocalDeleteEngine engine(nullptr, [] { return false; });
+    EXPECT_FALSE(engine.removeTree(tmp.path() + "/tree"));
+    EXPECT_TRUE(QFileInfo::exists(tmp.path() + "/tree"));
+}
+
+TEST(UT_LocalDeleteEngine, testStateCheckedPerDir)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString root = tmp.path() + "/tree";
+    for (int i = 0; i < 3; ++i)
+        QDir().mkpath(root + QString("/d%1").arg(i));
+    for (int j = 0; j < 600; ++j)
+        QFile(root + QString("/d0/f%1").arg(j)).open(QIODevice::WriteOnly);
+
+    // 暂停时检查函数阻塞，每个目录和大目录中途都会检查
+    std::atomic_int checked { 0 };
+    LocalDeleteEngine engine(nullptr, [&] { ++checked; return true; });
+    EXPECT_TRUE(engine.removeTree(root));
+    // root + 3 dirs + 2 batches in d0
+    EXPECT_EQ(checked, 6);
+}
+
+TEST(UT_LocalDeleteEngine, testMissing)
+{
+    LocalDeleteEngine engine(nullptr, nullptr);
+    EXPECT_FALSE(engine.removeTree("/not/exists/path"));
+    EXPECT_EQ(engine.errorPath(), QString("/not/exists/path"));
+    EXPECT_NE(engine.errorCode(), 0);
+}
@@ -514,6 +514,57 @@ TEST_F(UT_FileOperateBaseWorker, testCheckAndCopyDir)
     worker.initCopyWay();
 }
 
+TEST_F(UT_FileOperateBaseWorker, testInitCopyWayVerifiedCopy)
+{
+    FileOperateBaseWorker worker;
+    worker.workData.reset(new WorkerData);
+    worker.isSourceFileLocal = true;
+    worker.isTargetFileLocal = true;
+    worker.sourceFilesCount = 2;
+    stub_ext::StubExt stub;
+    stub.set_lamda(&FileUtils::getCpuProcessCount, []{ __DBG_STUB_INVOKE__ return 8; });
+    stub.set_lamda(&FileOperateBaseWorker::initThreadCopy, []{ __DBG_STUB_INVOKE__ });
+
+    // 只有完整性校验标志时保持原有的多线程拷贝
+    worker.workData->jobFlags |= AbstractJobHandler::JobFlag::kCopyIntegrityChecking;
+    worker.initCopyWay();
+    EXPECT_FALSE(worker.workData->signalThread);
+
+    // 校验拷贝只能单线程读写拷贝
+    worker.workData->verifiedCopy = true;
+    worker.initCopyWay();
+    EXPECT_TRUE(worker.workData->signalThread);
+}
+
+TEST_F(UT_FileOperateBaseWorker, testDoCopyOtherFileVerifiedCopy)
+{
+    FileOperateBaseWorker worker;
+    worker.workData.reset(new WorkerData);
+    worker.workData->copyFileRange = true;
+    worker.workData->jobFlags |= AbstractJobHandler::JobFlag::kCopyIntegrityChecking;
+    DFileInfoPointer sorceInfo(new DFileInfo(QUrl::fromLocalFile(QDir::currentPath() + "/sourceUrl.txt")));
+    DFileInfoPointer targetInfo(new DFileInfo(QUrl::fromLocalFile(QDir::currentPath() + "/targetUrl.txt")));
+    stub_ext::StubExt stub;
+    int byRange = 0;
+    int practically = 0;
+    stub.set_lamda(&FileOperateBaseWorker::doCopyLocalByRange, [&byRange]{ __DBG_STUB_INVOKE__ ++byRange; return true; });
+    stub.set_lamda(&DoCopyFileWorker::doCopyFilePractically, [&practically]{ __DBG_STUB_INVOKE__
+        ++practically;
+        return DoCopyFileWorker::NextDo::kDoCopyNext;
+    });
+
+    bool skip { false };
+    // 其他使用完整性校验标志的拷贝仍可使用 copy_file_range
+    EXPECT_TRUE(worker.doCopyOtherFile(sorceInfo, targetInfo, &skip));
+    EXPECT_EQ(1, byRange);
+    EXPECT_EQ(0, practically);
+
+    worker.workData->verifiedCopy = true;
+    worker.doCopyOtherFile(sorceInfo, targetInfo, &skip);
+    EXPECT_EQ(1, byRange);
+    EXPECT_EQ(1, practically);
+}
+
 TEST_F(UT_FileOperateBaseWorker, testTrashInfo)
 {
     FileOperateBaseWorker worker;
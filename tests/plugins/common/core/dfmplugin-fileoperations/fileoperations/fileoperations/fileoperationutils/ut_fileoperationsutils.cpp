@@ -11,6 +11,8 @@
 #include <dfm-base/file/local/syncfileinfo.h>
 #include <dfm-base/file/local/localfilehandler.h>
 
+#include <dfm-framework/dpf.h>
+
 #include <gtest/gtest.h>
 
 #include <fts.h>
@@ -31,6 +33,12 @@ public:
     void TearDown() override {}
 };
 
+class UT_VaultPathProvider : public QObject
+{
+public:
+    QString unlockPath() { return "/home/ut/.config/Vault/vault_unlocked"; }
+};
+
 
 TEST_F(UT_FileOperationsUtils, testFileOperationsUtils)
 {
@@ -70,3 +78,24 @@ TEST_F(UT_FileOperationsUtils, testUpdateProgressTimer)
     update.isStop = false;
     update.handleTimeOut();
 }
+
+TEST_F(UT_FileOperationsUtils, testUpdateVaultUnlockPath)
+{
+    static constexpr char kVaultSpace[] { "dfmplugin_vault" };
+    static constexpr char kUnlockPathTopic[] { "slot_Vault_UnlockPath" };
+
+    // 未加载保险箱插件时不使用保险箱缓冲区
+    dpfSlotChannel->disconnect(kVaultSpace, kUnlockPathTopic);
+    FileOperationsUtils::updateVaultUnlockPath();
+    EXPECT_TRUE(FileOperationsUtils::vaultUnlockPath().isEmpty());
+
+    UT_VaultPathProvider provider;
+    dpfEvent->registerEventType(DPF_NAMESPACE::EventStratege::kSlot, kVaultSpace, kUnlockPathTopic);
+    dpfSlotChannel->connect(kVaultSpace, kUnlockPathTopic, &provider, &UT_VaultPathProvider::unlockPath);
+    FileOperationsUtils::updateVaultUnlockPath();
+    EXPECT_EQ(FileOperationsUtils::vaultUnlockPath(), QString("/home/ut/.config/Vault/vault_unlocked/"));
+
+    dpfSlotChannel->disconnect(kVaultSpace, kUnlockPathTopic);
+    FileOperationsUtils::updateVaultUnlockPath();
+    EXPECT_TRUE(FileOperationsUtils::vaultUnlockPath().isEmpty());
+}
@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+#include "plugins/common/core/dfmplugin-fileoperations/fileoperations/fileoperationutils/jobscheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <QThread>
+
+#include <atomic>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+class UT_JobScheduler : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        stub.set_lamda(&JobScheduler::limitOf, [] { __DBG_STUB_INVOKE__ return 1; });
+    }
+    void TearDown() override
+    {
+        for (QThread *thread : threads) {
+            thread->wait();
+            delete thread;
+        }
+        stub.clear();
+    }
+
+    // 在工作线程中排队，取得名额后记录顺序并立即释放
+    void queue(int id, const std::function<bool()> &isStopped = nullptr, const std::function<bool()> &isPaused = nullptr)
+    {
+        const int queued = waitingCount() + 1;
+        QThread *thread = QThread::create([this, id, isStopped, isPaused] {
+            if (scheduler.acquire(kDisk, isStopped, isPaused)) {
+                {
+                    QMutexLocker locker(&orderMutex);
+                    order.append(id);
+                }
+                scheduler.release(kDisk);
+            } else {
+                QMutexLocker locker(&orderMutex);
+                order.append(-id);
+            }
+        });
+        threads.append(thread);
+        thread->start();
+        // 保证按启动顺序取得排队号
+        waitFor([this, queued] { return waitingCount() == queued; });
+    }
+
+    int waitingCount()
+    {
+        QMutexLocker locker(&scheduler.mutex);
+        return scheduler.disks.value(kDisk).waiting.count();
+    }
+
+    QList<int> finished()
+    {
+        QMutexLocker locker(&orderMutex);
+        return order;
+    }
+
+    static void waitFor(const std::function<bool()> &cond)
+    {
+        for (int i = 0; i < 500 && !cond(); ++i)
+            QThread::msleep(10);
+    }
+
+    static constexpr char kDisk[] { "sdz" };
+    JobScheduler scheduler;
+    QList<QThread *> threads;
+    QMutex orderMutex;
+    QList<int> order;
+    stub_ext::StubExt stub;
+};
+
+TEST_F(UT_JobScheduler, testAcquireInOrder)
+{
+    ASSERT_TRUE(scheduler.acquire(kDisk, nullptr));
+    queue(1);
+    queue(2);
+    queue(3);
+    EXPECT_TRUE(finished().isEmpty());
+
+    scheduler.release(kDisk);
+    waitFor([this] { return finished().size() == 3; });
+    EXPECT_EQ((QList<int> { 1, 2, 3 }), finished());
+    EXPECT_EQ(0, scheduler.disks.value(kDisk).running);
+}
+
+TEST_F(UT_JobScheduler, testStopWhileQueued)
+{
+    ASSERT_TRUE(scheduler.acquire(kDisk, nullptr));
+    std::atomic_bool stopped { false };
+    queue(1, [&stopped] { return stopped.load(); });
+    queue(2);
+
+    stopped = true;
+    waitFor([this] { return !finished().isEmpty(); });
+    // 取消的任务离开队列，不占用名额
+    EXPECT_EQ(QList<int> { -1 }, finished());
+    EXPECT_EQ(1, waitingCount());
+    EXPECT_EQ(1, scheduler.disks.value(kDisk).running);
+
+    scheduler.release(kDisk);
+    waitFor([this] { return finished().size() == 2; });
+    EXPECT_EQ((QList<int> { -1, 2 }), finished());
+}
+
+TEST_F(UT_JobScheduler, testPauseWhileQueued)
+{
+    ASSERT_TRUE(scheduler.acquire(kDisk, nullptr));
+    std::atomic_bool paused { true };
+    queue(1, nullptr, [&paused] { return paused.load(); });
+    queue(2);
+
+    // 暂停的任务保留位置，后面的任务先执行
+    scheduler.release(kDisk);
+    waitFor([this] { return finished().size() == 1; });
+    QThread::msleep(300);
+    EXPECT_EQ(QList<int> { 2 }, finished());
+    EXPECT_EQ(1, waitingCount());
+    EXPECT_EQ(1, scheduler.Statistics().value(kDisk).toMap().value("paused").toInt());
+
+    paused = false;
+    waitFor([this] { return finished().size() == 2; });
+    EXPECT_EQ((QList<int> { 2, 1 }), finished());
+    EXPECT_TRUE(scheduler.disks.value(kDisk).paused.isEmpty());
+}
+
+TEST_F(UT_JobScheduler, testHistogram)
+{
+    const JobScheduler::Bounds bounds { 1, 4, 16, 64, 256 };
+    JobScheduler::Histogram histogram;
+    for (qint64 value : { 0, 1, 3, 4, 15, 255, 256, 100000 })
+        histogram.add(value, bounds);
+
+    // 每个桶统计小于对应上界的值，最后一个桶统计其余的值
+    const std::array<qint64, 6> expected { 1, 2, 2, 0, 1, 2 };
+    EXPECT_EQ(expected, histogram.counts);
+
+    const QVariantMap &map = histogram.toMap(bounds, "MiB/s");
+    EXPECT_EQ(6, map.size());
+    EXPECT_EQ(2, map.value("<4MiB/s").toInt());
+    EXPECT_EQ(2, map.value(">=256MiB/s").toInt());
+}
+
+TEST_F(UT_JobScheduler, testRecord)
+{
+    scheduler.record(kDisk, 8 * 1024 * 1024, 0, 1000, true);
+    scheduler.record(kDisk, 0, 50, 0, false);
+
+    const QVariantMap &stat = scheduler.Statistics().value(kDisk).toMap();
+    EXPECT_EQ(1, stat.value("finished").toInt());
+    EXPECT_EQ(1, stat.value("stopped").toInt());
+    EXPECT_EQ(1, stat.value("throughput").toMap().value("<16MiB/s").toInt());
+    EXPECT_EQ(1, stat.value("waitTime").toMap().value("<100ms").toInt());
+}
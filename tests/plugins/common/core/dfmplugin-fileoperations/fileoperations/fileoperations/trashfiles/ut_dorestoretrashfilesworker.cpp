@@ -12,6 +12,7 @@
 #include <dfm-base/file/local/syncfileinfo.h>
 #include <dfm-base/file/local/localfilehandler.h>
 #include <dfm-base/utils/clipboard.h>
+#include <dfm-base/utils/trashindex.h>
 #include <dfm-base/file/local/localdiriterator.h>
 
 #include <dfm-framework/event/event.h>
@@ -64,6 +65,40 @@ TEST_F(UT_DoRestoreTrashFilesWorker, testDoWork)
     worker.onUpdateProgress();
 }
 
+TEST_F(UT_DoRestoreTrashFilesWorker, testRestoreAllRestoresUnindexedFiles)
+{
+    DoRestoreTrashFilesWorker worker;
+    stub_ext::StubExt stub;
+    worker.workData.reset(new WorkerData);
+    stub.set_lamda(&DoRestoreTrashFilesWorker::saveOperations, []{ __DBG_STUB_INVOKE__ });
+    stub.set_lamda(VADDR(AbstractWorker, doWork), []{ __DBG_STUB_INVOKE__ return true;});
+    stub.set_lamda(VADDR(AbstractWorker, endWork), []{ __DBG_STUB_INVOKE__ });
+    stub.set_lamda(&TrashIndex::sync, []{ __DBG_STUB_INVOKE__ });
+
+    QList<QList<QUrl>> passes;
+    stub.set_lamda(&DoRestoreTrashFilesWorker::doRestoreTrashFiles, [&passes, &worker]{ __DBG_STUB_INVOKE__
+        passes.append(worker.allFilesList);
+        return true;
+    });
+    // gio 枚举出索引中没有的项（如其他程序移入回收站的文件），第二轮只还原这些项
+    stub.set_lamda(&DoRestoreTrashFilesWorker::enumerateTrashFiles, [](DoRestoreTrashFilesWorker *, const QSet<QUrl> &excluded){ __DBG_STUB_INVOKE__
+        QList<QUrl> result;
+        for (const QUrl &url : { QUrl("trash:///a"), QUrl("trash:///b") }) {
+            if (!excluded.contains(url))
+                result.append(url);
+        }
+        return result;
+    });
+
+    worker.sourceUrls = { FileUtils::trashRootUrl() };
+    worker.allFilesList = { QUrl("trash:///a") };
+    worker.sourceFilesCount = 1;
+    EXPECT_TRUE(worker.doWork());
+    ASSERT_EQ(passes.size(), 2);
+    EXPECT_EQ(passes.at(1), QList<QUrl> { QUrl("trash:///b") });
+    EXPECT_EQ(worker.sourceFilesCount, 2);
+}
+
 TEST_F(UT_DoRestoreTrashFilesWorker, testTranslateUrls)
 {
     DoRestoreTrashFilesWorker worker;
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "plugins/common/dfmplugin-fileoperations/fileoperations/trashfiles/localtrashengine.h"
+
+#include "stubext.h"
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <fcntl.h>
+#include <stdio.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+TEST(UT_LocalTrashEngine, testTrashBatch)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString trashFiles = tmp.path() + "/Trash/files";
+    const QString trashInfo = tmp.path() + "/Trash/info";
+    QDir().mkpath(tmp.path() + "/Trash");
+    QDir().mkpath(tmp.path() + "/src/dir");
+    QFile(tmp.path() + "/src/a b").open(QIODevice::WriteOnly);
+
+    LocalTrashEngine engine(trashFiles, trashInfo);
+    ASSERT_TRUE(engine.isValid());
+
+    const QUrl fileUrl = QUrl::fromLocalFile(tmp.path() + "/src/a b");
+    const QUrl dirUrl = QUrl::fromLocalFile(tmp.path() + "/src/dir");
+    EXPECT_TRUE(engine.canTrash(fileUrl));
+    EXPECT_FALSE(engine.canTrash(QUrl::fromLocalFile(tmp.path() + "/missing")));
+
+    QList<LocalTrashEngine::Item> items { { fileUrl, QUrl(), 0 }, { dirUrl, QUrl(), 0 } };
+    const QString &trashTime = engine.trashBatch(&items);
+    EXPECT_EQ(trashTime.split("-").size(), 2);
+
+    EXPECT_EQ(items.at(0).error, 0);
+    EXPECT_EQ(items.at(1).error, 0);
+    EXPECT_EQ(items.at(0).trashUrl.path(), "/a b");
+    EXPECT_FALSE(QFileInfo::exists(fileUrl.path()));
+    EXPECT_TRUE(QFileInfo(trashFiles + "/dir").isDir());
+
+    QFile info(trashInfo + "/a b.trashinfo");
+    ASSERT_TRUE(info.open(QIODevice::ReadOnly));
+    const QByteArray &content = info.readAll();
+    EXPECT_TRUE(content.startsWith("[Trash Info]\n"));
+    EXPECT_TRUE(content.contains("Path=" + QUrl::toPercentEncoding(fileUrl.path(), "/")));
+    EXPECT_TRUE(content.contains("DeletionDate="));
+}
+
+TEST(UT_LocalTrashEngine, testNameConflict)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString trashFiles = tmp.path() + "/Trash/files";
+    const QString trashInfo = tmp.path() + "/Trash/info";
+    QDir().mkpath(trashFiles);
+    QDir().mkpath(trashInfo);
+    // files 中残留的同名项没有对应的 .trashinfo
+    QFile(trashFiles + "/f").open(QIODevice::WriteOnly);
+    QFile(trashInfo + "/f.2.trashinfo").open(QIODevice::WriteOnly);
+    QFile(tmp.path() + "/f").open(QIODevice::WriteOnly);
+
+    LocalTrashEngine engine(trashFiles, trashInfo);
+    QList<LocalTrashEngine::Item> items { { QUrl::fromLocalFile(tmp.path() + "/f"), QUrl(), 0 } };
+    engine.trashBatch(&items);
+
+    EXPECT_EQ(items.first().error, 0);
+    EXPECT_EQ(items.first().trashUrl.path(), "/f.3");
+    EXPECT_FALSE(QFileInfo::exists(trashInfo + "/f.trashinfo"));
+    EXPECT_TRUE(QFileInfo::exists(trashFiles + "/f.3"));
+}
+
+TEST(UT_LocalTrashEngine, testNameConflictWithSuffix)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString trashFiles = tmp.path() + "/Trash/files";
+    const QString trashInfo = tmp.path() + "/Trash/info";
+    QDir().mkpath(tmp.path() + "/a");
+    QDir().mkpath(tmp.path() + "/b");
+    QFile(tmp.path() + "/a/report.tar.gz").open(QIODevice::WriteOnly);
+    QFile(tmp.path() + "/b/report.tar.gz").open(QIODevice::WriteOnly);
+
+    LocalTrashEngine engine(trashFiles, trashInfo);
+    QList<LocalTrashEngine::Item> first { { QUrl::fromLocalFile(tmp.path() + "/a/report.tar.gz"), QUrl(), 0 } };
+    QList<LocalTrashEngine::Item> second { { QUrl::fromLocalFile(tmp.path() + "/b/report.tar.gz"), QUrl(), 0 } };
+    engine.trashBatch(&first);
+    engine.trashBatch(&second);
+
+    // 与 gio 一致，序号插在第一个 '.' 之前
+    EXPECT_EQ(first.first().error, 0);
+    EXPECT_EQ(second.first().error, 0);
+    EXPECT_EQ(first.first().trashUrl.path(), "/report.tar.gz");
+    EXPECT_EQ(second.first().trashUrl.path(), "/report.2.tar.gz");
+    EXPECT_TRUE(QFileInfo::exists(trashFiles + "/report.2.tar.gz"));
+    EXPECT_TRUE(QFileInfo::exists(trashInfo + "/report.2.tar.gz.trashinfo"));
+    EXPECT_FALSE(QFileInfo::exists(trashFiles + "/report.tar.gz.2"));
+}
+
+TEST(UT_LocalTrashEngine, testMissingSource)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    LocalTrashEngine engine(tmp.path() + "/files", tmp.path() + "/info");
+    QList<LocalTrashEngine::Item> items { { QUrl::fromLocalFile(tmp.path() + "/none"), QUrl(), 0 } };
+    engine.trashBatch(&items);
+
+    EXPECT_EQ(items.first().error, ENOENT);
+    EXPECT_FALSE(QFileInfo::exists(tmp.path() + "/info/none.trashinfo"));
+}
+
+TEST(UT_LocalTrashEngine, testNoReplaceUnsupported)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    QFile(tmp.path() + "/f").open(QIODevice::WriteOnly);
+    LocalTrashEngine engine(tmp.path() + "/files", tmp.path() + "/info");
+
+    // 不支持 RENAME_NOREPLACE 的文件系统上不做可能覆盖的重命名，交给 gio 处理
+    stub_ext::StubExt stub;
+    stub.set_lamda(renameat2, [](int, const char *, int, const char *, unsigned int) {
+        __DBG_STUB_INVOKE__
+        errno = EINVAL;
+        return -1;
+    });
+    QList<LocalTrashEngine::Item> items { { QUrl::fromLocalFile(tmp.path() + "/f"), QUrl(), 0 } };
+    engine.trashBatch(&items);
+
+    EXPECT_EQ(items.first().error, EINVAL);
+    EXPECT_TRUE(QFileInfo::exists(tmp.path() + "/f"));
+    EXPECT_FALSE(QFileInfo::exists(tmp.path() + "/info/f.trashinfo"));
+}
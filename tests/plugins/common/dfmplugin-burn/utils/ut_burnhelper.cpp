@@ -8,6 +8,14 @@
 
 #include <gtest/gtest.h>
 
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
 DFMBASE_USE_NAMESPACE
 DPBURN_USE_NAMESPACE
 
@@ -17,6 +25,19 @@ protected:
     virtual void SetUp() override {}
     virtual void TearDown() override { stub.clear(); }
 
+    static void writeFile(const QString &path, const QByteArray &content)
+    {
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(content);
+    }
+
+    static ino_t inodeOf(const QString &path)
+    {
+        struct stat st;
+        return ::lstat(QFile::encodeName(path).constData(), &st) == 0 ? st.st_ino : 0;
+    }
+
 private:
     stub_ext::StubExt stub;
 };
@@ -31,4 +52,89 @@ TEST_F(UT_BurnHelper, IsBurnEnabled)
     EXPECT_TRUE(BurnHelper::isBurnEnabled());
 }
 
-// TEST_F(UT_BurnHelper, ){}
+TEST_F(UT_BurnHelper, LinkFilesToStaging)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString &staging = dir.filePath("staging");
+    ASSERT_TRUE(QDir().mkpath(staging));
+    ASSERT_TRUE(QDir().mkpath(dir.filePath("src/folder/sub")));
+    writeFile(dir.filePath("src/a.txt"), "a");
+    writeFile(dir.filePath("src/folder/sub/b.txt"), "b");
+    ASSERT_EQ(0, ::symlink("sub/b.txt", QFile::encodeName(dir.filePath("src/folder/link")).constData()));
+
+    const QList<QUrl> srcList { QUrl::fromLocalFile(dir.filePath("src/a.txt")),
+                                QUrl::fromLocalFile(dir.filePath("src/folder")),
+                                QUrl("burn:///dev/sr0/disc_files/c.txt") };
+    QList<QUrl> targetList;
+    const QList<QUrl> &linked = BurnHelper::linkFilesToStaging(srcList, QUrl::fromLocalFile(staging), &targetList);
+
+    // 非本地文件不处理，其余文件以硬链接加入暂存区，目录重建结构
+    ASSERT_EQ(2, linked.size());
+    EXPECT_EQ(srcList.mid(0, 2), linked);
+    EXPECT_EQ((QList<QUrl> { QUrl::fromLocalFile(staging + "/a.txt"), QUrl::fromLocalFile(staging + "/folder") }), targetList);
+    EXPECT_EQ(inodeOf(dir.filePath("src/a.txt")), inodeOf(staging + "/a.txt"));
+    EXPECT_EQ(inodeOf(dir.filePath("src/folder/sub/b.txt")), inodeOf(staging + "/folder/sub/b.txt"));
+    EXPECT_NE(inodeOf(dir.filePath("src/folder")), inodeOf(staging + "/folder"));
+    // 符号链接按原样重建，相对路径指向暂存区中的文件
+    EXPECT_TRUE(QFileInfo(staging + "/folder/link").isSymLink());
+    EXPECT_EQ(staging + "/folder/sub/b.txt", QFile::symLinkTarget(staging + "/folder/link"));
+}
+
+TEST_F(UT_BurnHelper, LinkFilesToStaging_CopyFallback)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString &staging = dir.filePath("staging");
+    ASSERT_TRUE(QDir().mkpath(staging));
+    ASSERT_TRUE(QDir().mkpath(dir.filePath("src/folder")));
+    writeFile(dir.filePath("src/a.txt"), "a");
+    writeFile(dir.filePath("src/folder/b.txt"), "b");
+
+    // 无法链接（如跨文件系统）时撤销已创建的部分，交由复制任务处理
+    stub.set_lamda(::link, [](const char *, const char *) {
+        __DBG_STUB_INVOKE__
+        errno = EXDEV;
+        return -1;
+    });
+
+    const QList<QUrl> srcList { QUrl::fromLocalFile(dir.filePath("src/a.txt")),
+                                QUrl::fromLocalFile(dir.filePath("src/folder")) };
+    QList<QUrl> targetList;
+    EXPECT_TRUE(BurnHelper::linkFilesToStaging(srcList, QUrl::fromLocalFile(staging), &targetList).isEmpty());
+    EXPECT_TRUE(targetList.isEmpty());
+    EXPECT_TRUE(QDir(staging).isEmpty(QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot));
+
+    // 暂存区不存在时全部交由复制任务处理
+    stub.clear();
+    EXPECT_TRUE(BurnHelper::linkFilesToStaging(srcList, QUrl::fromLocalFile(dir.filePath("missing")), &targetList).isEmpty());
+}
+
+TEST_F(UT_BurnHelper, LinkFilesToStaging_NameCollision)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString &staging = dir.filePath("staging");
+    ASSERT_TRUE(QDir().mkpath(staging));
+    ASSERT_TRUE(QDir().mkpath(dir.filePath("src1")));
+    ASSERT_TRUE(QDir().mkpath(dir.filePath("src2")));
+    writeFile(dir.filePath("src1/a.txt"), "first");
+    writeFile(dir.filePath("src2/a.txt"), "second");
+    writeFile(dir.filePath("src1/b.txt"), "new");
+    writeFile(staging + "/b.txt", "staged");
+
+    const QList<QUrl> srcList { QUrl::fromLocalFile(dir.filePath("src1/a.txt")),
+                                QUrl::fromLocalFile(dir.filePath("src2/a.txt")),
+                                QUrl::fromLocalFile(dir.filePath("src1/b.txt")) };
+    QList<QUrl> targetList;
+    const QList<QUrl> &linked = BurnHelper::linkFilesToStaging(srcList, QUrl::fromLocalFile(staging), &targetList);
+
+    // 重名的文件不覆盖暂存区中已有的文件，交由复制任务处理冲突
+    EXPECT_EQ(QList<QUrl> { srcList.first() }, linked);
+    EXPECT_EQ(QList<QUrl> { QUrl::fromLocalFile(staging + "/a.txt") }, targetList);
+    EXPECT_EQ(inodeOf(dir.filePath("src1/a.txt")), inodeOf(staging + "/a.txt"));
+
+    QFile staged(staging + "/b.txt");
+    ASSERT_TRUE(staged.open(QIODevice::ReadOnly));
+    EXPECT_EQ(QByteArray("staged"), staged.readAll());
+}
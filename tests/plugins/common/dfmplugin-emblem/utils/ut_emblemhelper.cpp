@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+#include "utils/emblemhelper.h"
+
+#include <dfm-base/file/local/localfilewatcher.h>
+
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+#include <QThread>
+
+DFMBASE_USE_NAMESPACE
+DPEMBLEM_USE_NAMESPACE
+
+class UT_EmblemHelper : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        helper = new EmblemHelper(nullptr);
+    }
+    void TearDown() override
+    {
+        delete helper;
+        stub.clear();
+    }
+
+    EmblemHelper *helper { nullptr };
+    stub_ext::StubExt stub;
+};
+
+TEST_F(UT_EmblemHelper, onDirectoryDropped)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QUrl dirUrl = QUrl::fromLocalFile(dir.path());
+
+    int stopped = 0;
+    stub.set_lamda(VADDR(LocalFileWatcher, stopWatcher), [&stopped] {
+        __DBG_STUB_INVOKE__
+        ++stopped;
+        return true;
+    });
+
+    bool destroyed { false };
+    AbstractFileWatcherPointer watcher(new LocalFileWatcher(dirUrl));
+    QObject::connect(watcher.data(), &QObject::destroyed, [&destroyed] { destroyed = true; });
+    QObject::connect(watcher.data(), &AbstractFileWatcher::fileAttributeChanged, helper, &EmblemHelper::requestFileChanged);
+    helper->indexWatchers.insert(dirUrl, watcher);
+    watcher.reset();
+
+    // 目录索引被丢弃后监视器随之停止并释放
+    helper->onDirectoryDropped(dirUrl);
+    EXPECT_EQ(1, stopped);
+    EXPECT_TRUE(destroyed);
+    EXPECT_FALSE(helper->indexWatchers.contains(dirUrl));
+
+    helper->onDirectoryDropped(dirUrl);
+    EXPECT_EQ(1, stopped);
+}
+
+TEST_F(UT_EmblemHelper, productQueueBounded)
+{
+    for (int i = 0; i < 10001; ++i)
+        helper->onEmblemChanged(QUrl::fromLocalFile(QString("/tmp/ut_emblem/%1").arg(i)), {});
+
+    EXPECT_LE(helper->productQueue.count(), 10000);
+    EXPECT_TRUE(helper->hasEmblem(QUrl::fromLocalFile("/tmp/ut_emblem/10000")));
+}
+
+TEST(UT_GioEmblemWorker, cacheBounded)
+{
+    stub_ext::StubExt stub;
+    stub.set_lamda(&GioEmblemWorker::fetchEmblems, [] {
+        __DBG_STUB_INVOKE__
+        return QList<QIcon>();
+    });
+
+    GioEmblemWorker worker;
+    int changed = 0;
+    QObject::connect(&worker, &GioEmblemWorker::emblemChanged, &worker, [&changed] { ++changed; }, Qt::DirectConnection);
+
+    QThread *thread = QThread::create([&worker] {
+        for (int i = 0; i < 10001; ++i)
+            worker.onProduce(FileInfoPointer(new FileInfo(QUrl::fromLocalFile(QString("/tmp/ut_emblem/%1").arg(i)))));
+        // 已缓存且角标未变化的文件不重复通知
+        worker.onProduce(FileInfoPointer(new FileInfo(QUrl::fromLocalFile("/tmp/ut_emblem/10000"))));
+    });
+    thread->start();
+    thread->wait();
+    delete thread;
+
+    EXPECT_LE(worker.cache.count(), 10000);
+    EXPECT_EQ(10001, changed);
+}
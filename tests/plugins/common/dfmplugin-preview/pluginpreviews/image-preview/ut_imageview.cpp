@@ -5,9 +5,21 @@
 #include "stubext.h"
 #include "imageview.h"
 
+#include <dfm-base/utils/thumbnail/thumbnailhelper.h>
+
 #include <gtest/gtest.h>
 
 #include <QMovie>
+#include <QImageReader>
+#include <QTemporaryDir>
+#include <QSemaphore>
+#include <QElapsedTimer>
+#include <QApplication>
+#include <QThread>
+#include <QFile>
+#include <QDateTime>
+
+#include <functional>
 
 PREVIEW_USE_NAMESPACE
 
@@ -66,3 +78,173 @@ TEST(UT_imageView, sourceSize)
 
     EXPECT_TRUE(view.sourceSize() == QSize(0, 0));
 }
+
+class UT_ImageViewDecode : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        fileA = dir.filePath("a.png");
+        fileB = dir.filePath("b.png");
+        QImage image(800, 600, QImage::Format_ARGB32);
+        image.fill(Qt::green);
+        image.save(fileA, "png");
+        image.save(fileB, "png");
+
+        stub.set_lamda(&DFMBASE_NAMESPACE::ThumbnailHelper::thumbnailImage, [this] {
+            __DBG_STUB_INVOKE__
+            return thumbnail;
+        });
+        typedef QImage (QImageReader::*ReadFunc)();
+        stub.set_lamda(static_cast<ReadFunc>(&QImageReader::read), [this](QImageReader *reader) {
+            __DBG_STUB_INVOKE__
+            ++readCount;
+            const int running = ++readRunning;
+            int max = maxReadRunning;
+            while (running > max && !maxReadRunning.compare_exchange_weak(max, running)) { }
+            // 解码被阻塞，直到测试放行
+            readGate.tryAcquire(1, 5000);
+            QThread::msleep(readDelay);
+            QImage decoded(100, 75, QImage::Format_ARGB32);
+            decoded.fill(reader->fileName() == fileA ? Qt::blue : Qt::yellow);
+            --readRunning;
+            return decoded;
+        });
+    }
+
+    void TearDown() override
+    {
+        // 放行所有阻塞的解码，避免解码线程在测试结束后仍在运行
+        readGate.release(100);
+        waitFor([this] { return readRunning == 0; });
+        stub.clear();
+    }
+
+    static bool waitFor(const std::function<bool()> &condition)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        while (!condition() && timer.elapsed() < 5000) {
+            QApplication::processEvents();
+            QThread::msleep(1);
+        }
+        return condition();
+    }
+
+    static QColor centerColor(const ImageView &view)
+    {
+        const QImage &image = view.pixmap().toImage();
+        return image.pixelColor(image.width() / 2, image.height() / 2);
+    }
+
+    stub_ext::StubExt stub;
+    QTemporaryDir dir;
+    QString fileA;
+    QString fileB;
+    QImage thumbnail;
+    QSemaphore readGate;
+    std::atomic_int readCount { 0 };
+    std::atomic_int readRunning { 0 };
+    std::atomic_int maxReadRunning { 0 };
+    int readDelay { 0 };
+};
+
+TEST_F(UT_ImageViewDecode, PlaceholderPreviewFinal)
+{
+    thumbnail = QImage(200, 150, QImage::Format_ARGB32);
+    thumbnail.fill(Qt::red);
+
+    ImageView view(fileA, QByteArray("png"));
+
+    // 解码完成前显示目标大小的透明占位图
+    EXPECT_EQ(view.targetImageSize, view.pixmap().size());
+    EXPECT_EQ(0, centerColor(view).alpha());
+
+    // 缩略图先显示，完整图像仍在解码
+    EXPECT_TRUE(waitFor([&] { return view.previewShown; }));
+    EXPECT_FALSE(view.imageShown);
+    EXPECT_EQ(QColor(Qt::red), centerColor(view));
+
+    readGate.release();
+    EXPECT_TRUE(waitFor([&] { return view.imageShown; }));
+    EXPECT_EQ(QColor(Qt::blue), centerColor(view));
+}
+
+TEST_F(UT_ImageViewDecode, CancelWhenFileChanges)
+{
+    ImageView view(fileA, QByteArray("png"));
+    EXPECT_TRUE(waitFor([&] { return readRunning == 1; }));
+
+    // 切换文件时正在解码的旧图像结果被丢弃
+    view.setFile(fileB, QByteArray("png"));
+    readGate.release(2);
+    EXPECT_TRUE(waitFor([&] { return view.imageShown; }));
+    EXPECT_TRUE(waitFor([&] { return readRunning == 0; }));
+    QApplication::processEvents();
+    EXPECT_EQ(QColor(Qt::yellow), centerColor(view));
+
+    // 旧图像没有进入缓存
+    ImageView other(fileA, QByteArray("png"));
+    EXPECT_FALSE(other.imageShown);
+}
+
+TEST_F(UT_ImageViewDecode, CacheHit)
+{
+    readGate.release(100);
+    ImageView view(fileA, QByteArray("png"));
+    EXPECT_TRUE(waitFor([&] { return view.imageShown; }));
+    const int reads = readCount;
+
+    // 再次预览同一文件直接使用缓存，不再解码
+    ImageView cached(fileA, QByteArray("png"));
+    EXPECT_TRUE(cached.imageShown);
+    EXPECT_EQ(reads, readCount);
+    EXPECT_EQ(QColor(Qt::blue), centerColor(cached));
+
+    // 文件被修改后缓存失效
+    QFile file(fileA);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    file.setFileTime(QDateTime::currentDateTime().addSecs(60), QFileDevice::FileModificationTime);
+    file.close();
+    cached.setFile(fileA, QByteArray("png"));
+    EXPECT_FALSE(cached.imageShown);
+}
+
+TEST_F(UT_ImageViewDecode, OversizeImageKeepsPreview)
+{
+    typedef QSize (QImageReader::*SizeFunc)() const;
+    stub.set_lamda(static_cast<SizeFunc>(&QImageReader::size), [] {
+        __DBG_STUB_INVOKE__
+        return QSize(20000, 20000);
+    });
+    thumbnail = QImage(200, 200, QImage::Format_ARGB32);
+    thumbnail.fill(Qt::red);
+
+    ImageView view(fileA, QByteArray("png"));
+    EXPECT_TRUE(waitFor([&] { return view.previewShown && view.imageWatcher->isFinished(); }));
+    QApplication::processEvents();
+
+    // 超过像素上限的图像不做完整解码，保留缩略图
+    EXPECT_EQ(0, readCount);
+    EXPECT_FALSE(view.imageShown);
+    EXPECT_EQ(QColor(Qt::red), centerColor(view));
+}
+
+TEST_F(UT_ImageViewDecode, LargeDecodesSerialized)
+{
+    typedef QSize (QImageReader::*SizeFunc)() const;
+    stub.set_lamda(static_cast<SizeFunc>(&QImageReader::size), [] {
+        __DBG_STUB_INVOKE__
+        return QSize(5000, 5000);
+    });
+    readGate.release(100);
+    readDelay = 50;
+
+    ImageView viewA(fileA, QByteArray("png"));
+    ImageView viewB(fileB, QByteArray("png"));
+    EXPECT_TRUE(waitFor([&] { return viewA.imageShown && viewB.imageShown; }));
+
+    // 两张需要按原始大小解码的大图不会同时解码
+    EXPECT_EQ(2, readCount);
+    EXPECT_EQ(1, maxReadRunning);
+}
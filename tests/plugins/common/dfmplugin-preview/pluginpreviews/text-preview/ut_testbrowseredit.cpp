@@ -4,100 +4,104 @@
 
 #include "stubext.h"
 #include "textbrowseredit.h"
+#include "textfilemodel.h"
 
 #include <gtest/gtest.h>
 
-#include <QAbstractSlider>
+#include <QScrollBar>
+#include <QTemporaryFile>
+#include <QThread>
 
 PREVIEW_USE_NAMESPACE
 
-TEST(UT_textBrowserEdit, setFileData)
+namespace {
+QString writeLines(QTemporaryFile &file, int count)
 {
-    bool isOk { false };
-
-    stub_ext::StubExt stub;
-    stub.set_lamda(&TextBrowserEdit::appendText, [ &isOk ]{
-        isOk = true;
-    });
-
-    TextBrowserEdit edit;
-    std::string data("UT_TEST");
-    edit.setFileData(data);
-
-    EXPECT_TRUE(isOk);
+    file.open();
+    for (int i = 0; i < count; ++i)
+        file.write(QString("line %1\n").arg(i).toUtf8());
+    file.flush();
+    return file.fileName();
 }
 
-TEST(UT_textBrowserEdit, wheelEvent)
+void waitIndexed(TextFileModel &model)
 {
-    bool isOk { false };
-
-    stub_ext::StubExt stub;
-    stub.set_lamda(&QWheelEvent::angleDelta, []{
-        return QPoint(0, -1);
-    });
-    stub.set_lamda(&QAbstractSlider::value, []{
-        return 100;
-    });
-    stub.set_lamda(&TextBrowserEdit::appendText, []{});
-    stub.set_lamda(VADDR(QPlainTextEdit, wheelEvent), [ &isOk ]{
-        isOk = true;
-    });
-
-    TextBrowserEdit edit;
-    edit.filestr = "UT_TEST";
-    QWheelEvent event(QPoint(0, 0), 1, Qt::LeftButton, Qt::NoModifier);
-    edit.wheelEvent(&event);
-
-    EXPECT_TRUE(isOk);
+    while (model.isIndexing())
+        QThread::msleep(1);
+}
 }
 
-TEST(UT_textBrowserEdit, scrollbarValueChange)
+TEST(UT_textBrowserEdit, setFileModel)
 {
-    bool isOk { false };
-
-    stub_ext::StubExt stub;
-    stub.set_lamda(&QAbstractSlider::setValue, [ &isOk ]{
-        isOk = true;
-    });
+    QTemporaryFile file;
+    TextFileModel model;
+    ASSERT_TRUE(model.open(writeLines(file, 10)));
+    waitIndexed(model);
 
     TextBrowserEdit edit;
-    edit.scrollbarValueChange(100);
+    edit.setFileModel(&model);
 
-    EXPECT_TRUE(isOk);
+    EXPECT_EQ(edit.windowFirstLine, 0);
+    EXPECT_EQ(edit.windowLineCount, 10);
+    EXPECT_EQ(edit.document()->blockCount(), 10);
+    EXPECT_EQ(edit.fileScrollBar->maximum(), 9);
 }
 
-TEST(UT_textBrowserEdit, sliderPositionValueChange)
+TEST(UT_textBrowserEdit, onFileScrolled)
 {
+    QTemporaryFile file;
+    TextFileModel model;
+    ASSERT_TRUE(model.open(writeLines(file, 10000)));
+    waitIndexed(model);
+
     TextBrowserEdit edit;
-    edit.lastPosition = 10;
-    edit.filestr = "UT_TEST";
-    edit.sliderPositionValueChange(100);
+    edit.setFileModel(&model);
+    edit.onFileScrolled(8000);
 
-    EXPECT_TRUE(edit.lastPosition == 100);
+    // 跳转到窗口外时重新加载以目标行为中心的窗口
+    EXPECT_LE(edit.windowFirstLine, 8000);
+    EXPECT_GT(edit.windowFirstLine + edit.windowLineCount, 8000);
+    EXPECT_EQ(edit.document()->findBlockByNumber(int(8000 - edit.windowFirstLine)).text(), QString("line 8000"));
 }
 
-TEST(UT_textBrowserEdit, verifyEndOfStrIntegrity_one)
+TEST(UT_textBrowserEdit, onViewScrolled)
 {
+    QTemporaryFile file;
+    TextFileModel model;
+    ASSERT_TRUE(model.open(writeLines(file, 10000)));
+    waitIndexed(model);
+
     TextBrowserEdit edit;
-    int re = edit.verifyEndOfStrIntegrity(nullptr, 0);
+    edit.setFileModel(&model);
+    const qint64 top = edit.windowLineCount - 1;
+    edit.verticalScrollBar()->setValue(edit.document()->findBlockByNumber(int(top)).firstLineNumber());
 
-    EXPECT_TRUE(re == 0);
+    // 接近窗口末尾时窗口向后平移，文件滚动条仍指向原来的行
+    EXPECT_GT(edit.windowFirstLine, 0);
+    EXPECT_EQ(edit.fileScrollBar->value(), int(top));
 }
 
-TEST(UT_textBrowserEdit, verifyEndOfStrIntegrity_two)
+TEST(UT_textBrowserEdit, setTopLine_wrapped)
 {
-    TextBrowserEdit edit;
-    int re = edit.verifyEndOfStrIntegrity("UT", 2);
+    QTemporaryFile file;
+    file.open();
+    for (int i = 0; i < 300; ++i)
+        file.write(QString("line %1 ").arg(i).append(QString(400, 'x')).append('\n').toUtf8());
+    file.flush();
 
-    EXPECT_TRUE(re == 2);
-}
+    TextFileModel model;
+    ASSERT_TRUE(model.open(file.fileName()));
+    waitIndexed(model);
 
-TEST(UT_textBrowserEdit, appendText_one)
-{
     TextBrowserEdit edit;
-    edit.filestr = "UT";
-    std::string::iterator data = edit.filestr.begin();
-    edit.appendText(data);
+    edit.setFileModel(&model);
+
+    // 自动换行后一个文本行占多个显示行，定位和文件滚动条都按文本行计算
+    edit.onFileScrolled(50);
+    EXPECT_EQ(edit.firstVisibleBlock().blockNumber(), 50);
+    EXPECT_EQ(edit.topLine(), 50);
+    EXPECT_GT(edit.verticalScrollBar()->value(), 50);
 
-    EXPECT_TRUE(edit.filestr.length() == 0);
+    edit.verticalScrollBar()->setValue(edit.document()->findBlockByNumber(80).firstLineNumber());
+    EXPECT_EQ(edit.fileScrollBar->value(), 80);
 }
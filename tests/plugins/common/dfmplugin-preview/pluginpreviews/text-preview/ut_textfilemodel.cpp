@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "textfilemodel.h"
+
+#include <gtest/gtest.h>
+
+#include <QTemporaryFile>
+#include <QThread>
+
+PREVIEW_USE_NAMESPACE
+
+namespace {
+void waitIndexed(TextFileModel &model)
+{
+    while (model.isIndexing())
+        QThread::msleep(1);
+}
+}
+
+TEST(UT_textFileModel, open_empty)
+{
+    QTemporaryFile file;
+    ASSERT_TRUE(file.open());
+
+    TextFileModel model;
+    EXPECT_FALSE(model.open(file.fileName()));
+    EXPECT_FALSE(model.open("/UT_TEST_NOT_EXIST"));
+}
+
+TEST(UT_textFileModel, lines)
+{
+    QTemporaryFile file;
+    ASSERT_TRUE(file.open());
+    for (int i = 0; i < 1000; ++i)
+        file.write(QString("line %1\r\n").arg(i).toUtf8());
+    file.write("last");
+    file.flush();
+
+    TextFileModel model;
+    ASSERT_TRUE(model.open(file.fileName()));
+    waitIndexed(model);
+
+    EXPECT_EQ(model.lineCount(), 1001);
+    EXPECT_EQ(model.lines(0, 2), QString("line 0\nline 1"));
+    // 跨越索引检查点
+    EXPECT_EQ(model.lines(127, 3), QString("line 127\nline 128\nline 129"));
+    EXPECT_EQ(model.lines(999, 10), QString("line 999\nlast"));
+    EXPECT_TRUE(model.lines(1001, 1).isEmpty());
+}
+
+TEST(UT_textFileModel, lines_long)
+{
+    QTemporaryFile file;
+    ASSERT_TRUE(file.open());
+    // 没有换行的超长内容按上限切分，且不截断多字节字符
+    const QString &text = QString(20000, QChar(0x4e2d));
+    file.write(text.toUtf8());
+    file.flush();
+
+    TextFileModel model;
+    ASSERT_TRUE(model.open(file.fileName()));
+    waitIndexed(model);
+
+    EXPECT_GT(model.lineCount(), 1);
+    EXPECT_EQ(model.lines(0, int(model.lineCount())).remove('\n'), text);
+}
+
+TEST(UT_textFileModel, lines_utf16)
+{
+    QTemporaryFile file;
+    ASSERT_TRUE(file.open());
+    file.write("\xff\xfe", 2);
+    const QString &text("first\nsecond\n");
+    file.write(reinterpret_cast<const char *>(text.utf16()), text.size() * 2);
+    file.flush();
+
+    TextFileModel model;
+    ASSERT_TRUE(model.open(file.fileName()));
+    waitIndexed(model);
+
+    EXPECT_EQ(model.encoding(), QByteArray("UTF-16LE"));
+    EXPECT_EQ(model.lineCount(), 2);
+    EXPECT_EQ(model.lines(1, 1), QString("second"));
+}
+
+TEST(UT_textFileModel, nextLineStart_multibyte)
+{
+    // GBK 的双字节字符，切分点落在字符中间时回退到字符开头
+    QByteArray gbk("a");
+    for (int i = 0; i < 10000; ++i)
+        gbk.append("\xd6\xd0", 2);
+
+    TextFileModel model;
+    model.data = gbk.constData();
+    model.dataSize = gbk.size();
+    model.codec = "GBK";
+    EXPECT_EQ(model.nextLineStart(0), 16383);
+    EXPECT_EQ(model.nextLineStart(16383), gbk.size());
+
+    // UTF-16 的代理对不能被拆开
+    const QString &text = QString("A") + QString::fromUcs4(U"\U0001F600").repeated(5000);
+    const QByteArray utf16(reinterpret_cast<const char *>(text.utf16()), text.size() * 2);
+    model.data = utf16.constData();
+    model.dataSize = utf16.size();
+    model.codec = "UTF-16LE";
+    model.newline = QByteArray("\n\0", 2);
+    model.unitSize = 2;
+    EXPECT_EQ(model.nextLineStart(0), 16382);
+    EXPECT_EQ(model.nextLineStart(16382), utf16.size());
+    EXPECT_EQ(model.decode(0, 16382) + model.decode(16382, utf16.size()), text);
+
+    model.data = nullptr;
+    model.dataSize = 0;
+}
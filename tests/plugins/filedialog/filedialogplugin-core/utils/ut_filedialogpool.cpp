@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+#include "plugins/filedialog/core/utils/filedialogpool.h"
+#include "plugins/filedialog/core/dbus/filedialoghandledbus.h"
+#include "plugins/filedialog/core/views/filedialog.h"
+
+#include <gtest/gtest.h>
+
+DIALOGCORE_USE_NAMESPACE
+
+class UT_FileDialogPool : public testing::Test
+{
+protected:
+    void SetUp() override {}
+    void TearDown() override
+    {
+        for (const auto &handle : pool.handles)
+            delete handle.data();
+        pool.handles.clear();
+        qDeleteAll(taken);
+        stub.clear();
+    }
+
+    FileDialogHandleDBus *take()
+    {
+        FileDialogHandleDBus *handle = pool.take();
+        taken.append(handle);
+        return handle;
+    }
+
+    FileDialogPool pool;
+    QList<FileDialogHandleDBus *> taken;
+    stub_ext::StubExt stub;
+};
+
+TEST_F(UT_FileDialogPool, TakePrecreated)
+{
+    pool.fill();
+    ASSERT_EQ(1, pool.handles.size());
+    FileDialogHandleDBus *pooled = pool.handles.first();
+    // 池中的对话框暂停心跳，不会因为没有调用方而被回收
+    EXPECT_FALSE(pooled->curHeartbeatTimer.isActive());
+
+    pool.fill();
+    EXPECT_EQ(1, pool.handles.size());
+
+    EXPECT_EQ(pooled, take());
+    EXPECT_TRUE(pooled->curHeartbeatTimer.isActive());
+    EXPECT_TRUE(pool.handles.isEmpty());
+    // 取走后延迟补充
+    EXPECT_TRUE(pool.fillTimer.isActive());
+    EXPECT_GT(pool.fillTimer.interval(), 0);
+}
+
+TEST_F(UT_FileDialogPool, TakeWhenEmpty)
+{
+    FileDialogHandleDBus *handle = take();
+    ASSERT_TRUE(handle);
+    EXPECT_TRUE(handle->curHeartbeatTimer.isActive());
+    EXPECT_TRUE(pool.fillTimer.isActive());
+}
+
+TEST_F(UT_FileDialogPool, TakeSkipsDestroyed)
+{
+    pool.fill();
+    ASSERT_EQ(1, pool.handles.size());
+    FileDialogHandleDBus *pooled = pool.handles.first();
+    delete pooled;
+
+    // 池中已销毁的对话框被跳过，重新创建一个
+    FileDialogHandleDBus *handle = take();
+    ASSERT_TRUE(handle);
+    EXPECT_TRUE(pool.handles.isEmpty());
+}
+
+TEST_F(UT_FileDialogPool, FollowLastVisitedUrl)
+{
+    QList<QUrl> visited;
+    stub.set_lamda(VADDR(FileDialog, cd), [&visited](FileDialog *, const QUrl &url) {
+        __DBG_STUB_INVOKE__
+        visited.append(url);
+    });
+
+    FileDialogHandleDBus *first = take();
+    auto dialog = qobject_cast<FileDialog *>(first->widget());
+    ASSERT_TRUE(dialog);
+
+    // 上一个请求离开时所在的目录，由下一个预先创建的对话框继续打开
+    const QUrl url = QUrl::fromLocalFile("/tmp");
+    emit dialog->currentUrlChanged(url);
+    EXPECT_EQ(url, pool.lastVisitedUrl);
+
+    pool.fill();
+    ASSERT_EQ(1, pool.handles.size());
+    take();
+    EXPECT_EQ(QList<QUrl> { url }, visited);
+}
@@ -166,3 +166,19 @@ TEST(AddressBarPrivateTest, ut_onCompletionHighlighted)
     bar.d->onCompletionHighlighted("test");
     EXPECT_EQ("123test", bar.text());
 }
+
+TEST(AddressBarPrivateTest, ut_onCompletionListReady)
+{
+    stub_ext::StubExt st;
+    st.set_lamda(&SearchHistroyManager::getSearchHistroy, [] { return QStringList(); });
+    st.set_lamda(&SearchHistroyManager::getIPHistory, [] { return QList<IPHistroyData>(); });
+
+    AddressBar bar;
+    bar.d->onCompletionListReady({ "Desktop", "Documents", "Downloads" });
+    EXPECT_EQ(QCompleter::CaseSensitivelySortedModel, bar.d->urlCompleter->modelSorting());
+    EXPECT_EQ(3, bar.d->completerModel.rowCount());
+
+    bar.d->clearCompleterModel();
+    EXPECT_EQ(QCompleter::UnsortedModel, bar.d->urlCompleter->modelSorting());
+    EXPECT_EQ(0, bar.d->completerModel.rowCount());
+}
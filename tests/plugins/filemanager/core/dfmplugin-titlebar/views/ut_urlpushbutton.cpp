@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "views/urlpushbutton.h"
+#include "views/private/urlpushbutton_p.h"
+#include "utils/crumbinterface.h"
+#include "utils/crumbmanager.h"
+
+#include "stubext.h"
+
+#include <QCoreApplication>
+#include <QThread>
+
+#include <gtest/gtest.h>
+
+DPTITLEBAR_USE_NAMESPACE
+
+TEST(UrlPushButtonPrivateTest, ut_requestCompleteByUrl_cached)
+{
+    stub_ext::StubExt st;
+    st.set_lamda(&CrumbManager::createControllerByUrl, [] {
+        __DBG_STUB_INVOKE__
+        auto controller = new CrumbInterface;
+        controller->setSupportedScheme("file");
+        return controller;
+    });
+    st.set_lamda(&QThread::start, [] { __DBG_STUB_INVOKE__ });
+    st.set_lamda(&UrlPushButtonPrivate::onCompletionCompleted, [] { __DBG_STUB_INVOKE__ });
+
+    UrlPushButton button;
+    const QUrl url = QUrl::fromLocalFile("/tmp/ut_urlpushbutton");
+
+    // 第一次打开：枚举目录，结束后写入缓存
+    button.d->requestCompleteByUrl(url);
+    ASSERT_TRUE(button.d->crumbController);
+    auto controller = button.d->crumbController;
+    emit controller->completionFound({ "b", "a" });
+    controller->completionNames = QStringList { "b", "a" };
+    controller->finishCompletionList();
+    emit controller->completionListTransmissionCompleted();
+    EXPECT_EQ(button.d->completionStringList.size(), 2);
+
+    // 第二次打开命中缓存，弹窗仍然拿到完整列表
+    button.d->requestCompleteByUrl(url);
+    EXPECT_TRUE(button.d->completionStringList.isEmpty());
+    QCoreApplication::processEvents();
+    EXPECT_EQ(button.d->completionStringList, QStringList({ "a", "b" }));
+}
@@ -12,6 +12,7 @@
 #include <dfm-base/file/local/localdiriterator.h>
 #include <dfm-base/file/local/localfilewatcher.h>
 #include <dfm-base/utils/fileutils.h>
+#include <dfm-base/utils/protocolutils.h>
 
 #include <gtest/gtest.h>
 
@@ -222,3 +223,79 @@ TEST_F(UT_FileDataManager, CheckNeedCache)
     manager->cacheDataSchemes.append(Scheme::kFile);
     EXPECT_TRUE(manager->checkNeedCache(url));
 }
+
+TEST_F(UT_FileDataManager, RecentRoots)
+{
+    stub.set_lamda(&ProtocolUtils::isLocalFile, [] { __DBG_STUB_INVOKE__ return true; });
+    QList<QUrl> deleted;
+    stub.set_lamda(&FileDataManager::handleDeletion, [&deleted](FileDataManager *, RootInfo *root) {
+        __DBG_STUB_INVOKE__
+        deleted.append(root->url);
+        delete root;
+    });
+
+    const QUrl a = QUrl::fromLocalFile("/tmp/ut_recent/a");
+    const QUrl b = QUrl::fromLocalFile("/tmp/ut_recent/b");
+    const QUrl c = QUrl::fromLocalFile("/tmp/ut_recent/c");
+    for (const QUrl &url : { a, b, c })
+        manager->rootInfoMap.insert(url, new RootInfo(url, false));
+
+    manager->setRecentRootLimit(2);
+    manager->touchRecentRoot(a);
+    manager->touchRecentRoot(b);
+    // 最近访问的目录保留缓存
+    EXPECT_TRUE(manager->rootInfoMap.value(a)->canCache);
+    EXPECT_TRUE(manager->checkNeedCache(b));
+
+    // 超出数量时释放最久未访问且空闲的目录
+    manager->touchRecentRoot(c);
+    EXPECT_EQ(QList<QUrl> { a }, deleted);
+    EXPECT_FALSE(manager->rootInfoMap.contains(a));
+    EXPECT_EQ((QList<QUrl> { c, b }), manager->recentRoots);
+
+    // 重新访问的目录移到最前面
+    manager->touchRecentRoot(b);
+    EXPECT_EQ((QList<QUrl> { b, c }), manager->recentRoots);
+
+    for (auto root : manager->rootInfoMap)
+        delete root;
+    manager->rootInfoMap.clear();
+}
+
+TEST_F(UT_FileDataManager, RecentRootsSkipInUse)
+{
+    stub.set_lamda(&ProtocolUtils::isLocalFile, [] { __DBG_STUB_INVOKE__ return true; });
+    QList<QUrl> deleted;
+    stub.set_lamda(&FileDataManager::handleDeletion, [&deleted](FileDataManager *, RootInfo *root) {
+        __DBG_STUB_INVOKE__
+        deleted.append(root->url);
+        delete root;
+    });
+
+    const QUrl a = QUrl::fromLocalFile("/tmp/ut_recent/a");
+    const QUrl b = QUrl::fromLocalFile("/tmp/ut_recent/b");
+    RootInfo *rootA = new RootInfo(a, false);
+    // 仍有视图在遍历或显示的目录
+    rootA->traversalThreads.insert("view", nullptr);
+    manager->rootInfoMap.insert(a, rootA);
+
+    manager->setRecentRootLimit(1);
+    manager->touchRecentRoot(a);
+    manager->touchRecentRoot(b);
+
+    // 被淘汰的目录仍在使用，留给 cleanRoot 释放
+    EXPECT_TRUE(deleted.isEmpty());
+    EXPECT_EQ(rootA, manager->rootInfoMap.value(a));
+    EXPECT_EQ(QList<QUrl> { b }, manager->recentRoots);
+
+    // 不再需要缓存后，视图关闭时照常释放
+    rootA->traversalThreads.clear();
+    stub.set_lamda(&RootInfo::clearTraversalThread, [] { __DBG_STUB_INVOKE__ return 0; });
+    manager->cleanRoot(a, "view");
+    EXPECT_EQ(QList<QUrl> { a }, deleted);
+    EXPECT_FALSE(manager->rootInfoMap.contains(a));
+
+    // 关闭缓存后清空最近目录
+    manager->setRecentRootLimit(0);
+    EXPECT_TRUE(manager->recentRoots.isEmpty());
+}
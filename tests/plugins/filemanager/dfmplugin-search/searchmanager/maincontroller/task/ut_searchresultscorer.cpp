@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "searchmanager/maincontroller/task/searchresultscorer.h"
+
+#include <gtest/gtest.h>
+
+DPSEARCH_USE_NAMESPACE
+
+TEST(SearchResultScorerTest, ut_nameMatch)
+{
+    SearchResultScorer scorer(QUrl::fromLocalFile("/home/user"), "report");
+
+    float exact = scorer.score("report", 0, QDateTime());
+    float exactSuffix = scorer.score("Report.pdf", 0, QDateTime());
+    float prefix = scorer.score("report_2023.txt", 0, QDateTime());
+    float contains = scorer.score("my_report.txt", 0, QDateTime());
+    float none = scorer.score("notes.txt", 0, QDateTime());
+
+    EXPECT_GT(exact, exactSuffix);
+    EXPECT_GT(exactSuffix, prefix);
+    EXPECT_GT(prefix, contains);
+    EXPECT_GT(contains, none);
+}
+
+TEST(SearchResultScorerTest, ut_wildcardKeyword)
+{
+    SearchResultScorer scorer(QUrl::fromLocalFile("/home/user"), "rep*rt?");
+    EXPECT_GT(scorer.score("abc", 0, QDateTime()), -1.0f);
+}
+
+TEST(SearchResultScorerTest, ut_depthAndRecency)
+{
+    SearchResultScorer scorer(QUrl::fromLocalFile("/home/user"), "a");
+    const QDateTime now = QDateTime::currentDateTime();
+
+    EXPECT_GT(scorer.score("a.txt", 0, QDateTime()), scorer.score("a.txt", 5, QDateTime()));
+    EXPECT_GT(scorer.score("a.txt", 0, now), scorer.score("a.txt", 0, now.addDays(-60)));
+}
+
+TEST(SearchResultScorerTest, ut_searcherScore)
+{
+    SearchResultScorer scorer(QUrl::fromLocalFile("/home/user"), "content");
+    EXPECT_GT(scorer.score("a.txt", 0, QDateTime(), 2.0f), scorer.score("a.txt", 0, QDateTime(), 0.5f));
+}
+
+TEST(SearchResultScorerTest, ut_greater)
+{
+    SearchResultScorer::ScoredUrl a { QUrl("file:///a"), 2 };
+    SearchResultScorer::ScoredUrl b { QUrl("file:///b"), 1 };
+    EXPECT_TRUE(SearchResultScorer::greater(a, b));
+    EXPECT_FALSE(SearchResultScorer::greater(b, a));
+}
+
+TEST(SearchResultScorerTest, ut_urlScoreUsesGivenTime)
+{
+    SearchResultScorer scorer(QUrl::fromLocalFile("/home/user"), "a");
+    const QUrl url = QUrl::fromLocalFile("/home/user/dir/a.txt");
+
+    // 未给出修改时间时不计算时效得分，也不读取文件属性
+    EXPECT_FLOAT_EQ(scorer.score(url), scorer.score("a.txt", 1, QDateTime()));
+    EXPECT_GT(scorer.score(url, 0, QDateTime::currentDateTime()), scorer.score(url));
+}
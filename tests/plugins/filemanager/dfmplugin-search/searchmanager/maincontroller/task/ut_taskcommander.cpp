@@ -133,6 +133,22 @@ TEST(TaskCommanderTest, ut_getResults)
     EXPECT_TRUE(task.d->resultList.isEmpty());
 }
 
+TEST(TaskCommanderTest, ut_duplicateResults)
+{
+    stub_ext::StubExt st;
+    st.set_lamda(&TaskCommander::createSearcher, [] {});
+
+    TaskCommander task("taskId", QUrl("file:///home"), "key");
+    TestSearcher searcher(QUrl("file:///home"), "key");
+    task.d->allSearchers << &searcher;
+
+    task.d->onUnearthed(&searcher);
+    task.d->onUnearthed(&searcher);
+
+    // 重复命中的结果只保留一份
+    EXPECT_EQ(task.getResults(), QList<QUrl>({ QUrl("file:///home") }));
+}
+
 TEST(TaskCommanderTest, ut_start_1)
 {
     stub_ext::StubExt st;
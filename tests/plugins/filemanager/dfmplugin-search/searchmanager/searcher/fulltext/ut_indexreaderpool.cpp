@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "searchmanager/searcher/fulltext/indexreaderpool.h"
+
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+
+DPSEARCH_USE_NAMESPACE
+using namespace Lucene;
+
+class IndexReaderPoolTest : public testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        ASSERT_TRUE(dir.isValid());
+        pool = IndexReaderPool::instance();
+        oldPath = pool->storePath;
+        pool->invalidate();
+        pool->storePath = dir.path();
+        addDocument(L"/home/a.txt");
+    }
+    virtual void TearDown() override
+    {
+        pool->invalidate();
+        pool->storePath = oldPath;
+    }
+
+    void addDocument(const String &path)
+    {
+        IndexWriterPtr writer = newLucene<IndexWriter>(FSDirectory::open(dir.path().toStdWString()),
+                                                       newLucene<StandardAnalyzer>(LuceneVersion::LUCENE_CURRENT),
+                                                       IndexWriter::MaxFieldLengthUNLIMITED);
+        DocumentPtr doc = newLucene<Document>();
+        doc->add(newLucene<Field>(L"path", path, Field::STORE_YES, Field::INDEX_NOT_ANALYZED));
+        writer->addDocument(doc);
+        writer->close();
+    }
+
+    QTemporaryDir dir;
+    QString oldPath;
+    IndexReaderPool *pool { nullptr };
+};
+
+TEST_F(IndexReaderPoolTest, ReuseReader)
+{
+    IndexReaderPtr first;
+    {
+        auto lease = pool->acquire();
+        ASSERT_TRUE(lease.isValid());
+        first = lease.indexReader();
+    }
+
+    // 索引未变化时复用同一个reader
+    auto lease = pool->acquire();
+    ASSERT_TRUE(lease.isValid());
+    EXPECT_EQ(first, lease.indexReader());
+    EXPECT_EQ(1, lease.indexReader()->numDocs());
+}
+
+TEST_F(IndexReaderPoolTest, ReopenChangedIndex)
+{
+    auto oldLease = pool->acquire();
+    ASSERT_TRUE(oldLease.isValid());
+
+    addDocument(L"/home/b.txt");
+    auto newLease = pool->acquire();
+    ASSERT_TRUE(newLease.isValid());
+    EXPECT_NE(oldLease.indexReader(), newLease.indexReader());
+    EXPECT_EQ(2, newLease.indexReader()->numDocs());
+    // 租用中的旧reader仍然可用
+    EXPECT_EQ(1, oldLease.indexReader()->numDocs());
+}
+
+TEST_F(IndexReaderPoolTest, Invalidate)
+{
+    IndexReaderPtr first = pool->acquire().indexReader();
+    pool->invalidate();
+    EXPECT_EQ(nullptr, pool->reader);
+
+    auto lease = pool->acquire();
+    ASSERT_TRUE(lease.isValid());
+    EXPECT_NE(first, lease.indexReader());
+}
+
+TEST_F(IndexReaderPoolTest, IsIndexBroken)
+{
+    EXPECT_TRUE(IndexReaderPool::isIndexBroken(IOException(L"io")));
+    EXPECT_TRUE(IndexReaderPool::isIndexBroken(CorruptIndexException(L"corrupt")));
+    EXPECT_TRUE(IndexReaderPool::isIndexBroken(FileNotFoundException(L"missing")));
+    EXPECT_FALSE(IndexReaderPool::isIndexBroken(ParseException(L"bad keyword")));
+    EXPECT_FALSE(IndexReaderPool::isIndexBroken(QueryParserError(L"bad keyword")));
+}
+
+TEST_F(IndexReaderPoolTest, ParseErrorKeepsReader)
+{
+    IndexReaderPtr first = pool->acquire().indexReader();
+    QueryParserPtr parser = pool->newQueryParser(L"contents");
+    try {
+        parser->parse(L"\"unterminated");
+    } catch (const LuceneException &e) {
+        if (IndexReaderPool::isIndexBroken(e))
+            pool->invalidate();
+    }
+
+    EXPECT_EQ(first, pool->acquire().indexReader());
+}
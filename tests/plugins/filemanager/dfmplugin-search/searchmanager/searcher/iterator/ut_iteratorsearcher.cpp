@@ -11,6 +11,10 @@
 
 #include <gtest/gtest.h>
 
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+
 DPSEARCH_USE_NAMESPACE
 DFMBASE_USE_NAMESPACE
 
@@ -96,9 +100,38 @@ TEST(IteratorSearcherTest, doSearch_2)
     st.set_lamda(VADDR(LocalDirIterator, fileInfo), [] { __DBG_STUB_INVOKE__ return FileInfoPointer(new SyncFileInfo(QUrl::fromLocalFile("/home"))); });
 
     UrlRoute::regScheme("file", "/");
-    search.doSearch();
+    search.doIteratorSearch();
 
     EXPECT_FALSE(hasNext);
     EXPECT_FALSE(search.allResults.isEmpty());
     EXPECT_TRUE(search.searchPathList.isEmpty());
 }
+
+TEST(IteratorSearcherTest, doLocalSearch)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QDir(dir.path()).mkpath("a/b/c");
+    QFile(dir.path() + "/a/b/c/key_file.txt").open(QIODevice::WriteOnly);
+    QFile(dir.path() + "/a/other.txt").open(QIODevice::WriteOnly);
+    // 隐藏文件和隐藏目录下的文件不参与搜索
+    QDir(dir.path()).mkpath(".git/objects");
+    QFile(dir.path() + "/.git/objects/key_object").open(QIODevice::WriteOnly);
+    QFile(dir.path() + "/a/.key_hidden.txt").open(QIODevice::WriteOnly);
+
+    IteratorSearcher search(QUrl::fromLocalFile(dir.path()), "key");
+    search.status.storeRelease(AbstractSearcher::kRuning);
+    search.doSearch();
+
+    EXPECT_EQ(search.takeAll(), QList<QUrl>({ QUrl::fromLocalFile(dir.path() + "/a/b/c/key_file.txt") }));
+}
+
+TEST(IteratorSearcherTest, isFilteredDir)
+{
+    IteratorSearcher search(QUrl::fromLocalFile("/home"), "key");
+    EXPECT_TRUE(search.isFilteredDir("/proc/1"));
+    EXPECT_FALSE(search.isFilteredDir("/home/test"));
+
+    IteratorSearcher procSearch(QUrl::fromLocalFile("/proc"), "key");
+    EXPECT_FALSE(procSearch.isFilteredDir("/proc/1"));
+}
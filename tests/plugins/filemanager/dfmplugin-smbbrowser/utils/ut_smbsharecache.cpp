@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+#include "utils/smbsharecache.h"
+#include "utils/smbhostprober.h"
+
+#include <dfm-framework/dpf.h>
+
+#include <QUrl>
+
+#include <gtest/gtest.h>
+
+using namespace dfmplugin_smbbrowser;
+
+class UT_SmbShareCache : public testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        stub.set_lamda(&SmbShareCache::save, [] { __DBG_STUB_INVOKE__ });
+        SmbShareCache::instance()->listings.clear();
+    }
+    virtual void TearDown() override
+    {
+        SmbShareCache::instance()->listings.clear();
+        stub.clear();
+    }
+
+private:
+    stub_ext::StubExt stub;
+};
+
+static SmbShareNode makeShare(const QString &url, const QString &name)
+{
+    SmbShareNode node;
+    node.url = url;
+    node.displayName = name;
+    node.iconType = "folder-remote";
+    return node;
+}
+
+TEST_F(UT_SmbShareCache, IsCacheable)
+{
+    EXPECT_TRUE(SmbShareCache::isCacheable(QUrl("smb://1.2.3.4")));
+    EXPECT_TRUE(SmbShareCache::isCacheable(QUrl("smb://1.2.3.4/")));
+    EXPECT_FALSE(SmbShareCache::isCacheable(QUrl("smb://1.2.3.4/share")));
+    EXPECT_FALSE(SmbShareCache::isCacheable(QUrl("network:///")));
+    EXPECT_FALSE(SmbShareCache::isCacheable(QUrl("ftp://1.2.3.4")));
+}
+
+TEST_F(UT_SmbShareCache, StoreAndListing)
+{
+    auto cache = SmbShareCache::instance();
+    EXPECT_FALSE(cache->hasListing(QUrl("smb://1.2.3.4")));
+
+    cache->store(QUrl("smb://1.2.3.4"), { makeShare("smb://1.2.3.4/a", "a") });
+    SmbShareNodes nodes;
+    qint64 age = -1;
+    EXPECT_TRUE(cache->listing(QUrl("smb://1.2.3.4/"), &nodes, &age));
+    EXPECT_EQ(1, nodes.count());
+    EXPECT_TRUE(age >= 0 && age < 1000);
+
+    // the port is part of the host key.
+    EXPECT_TRUE(cache->hasListing(QUrl("smb://1.2.3.4")));
+    EXPECT_FALSE(cache->hasListing(QUrl("smb://1.2.3.4:1445")));
+
+    cache->remove(QUrl("smb://1.2.3.4"));
+    EXPECT_FALSE(cache->hasListing(QUrl("smb://1.2.3.4")));
+}
+
+TEST_F(UT_SmbShareCache, StoreNotifyOnlyWhenChanged)
+{
+    int refreshed = 0;
+    typedef QVariant (dpf::EventChannelManager::*Push)(const QString &, const QString &, QList<QUrl>);
+    stub.set_lamda(static_cast<Push>(&dpf::EventChannelManager::push), [&] {
+        __DBG_STUB_INVOKE__
+        ++refreshed;
+        return QVariant();
+    });
+
+    auto cache = SmbShareCache::instance();
+    const SmbShareNodes nodes { makeShare("smb://host/a", "a") };
+    cache->store(QUrl("smb://host"), nodes, true);
+    EXPECT_EQ(1, refreshed);
+    cache->store(QUrl("smb://host"), nodes, true);
+    EXPECT_EQ(1, refreshed);
+    cache->store(QUrl("smb://host"), { makeShare("smb://host/b", "b") }, false);
+    EXPECT_EQ(1, refreshed);
+}
+
+TEST_F(UT_SmbShareCache, AddShare)
+{
+    auto cache = SmbShareCache::instance();
+    cache->addShare(QUrl("smb://host/share/"));
+
+    SmbShareNodes nodes;
+    qint64 age = 0;
+    EXPECT_TRUE(cache->listing(QUrl("smb://host"), &nodes, &age));
+    ASSERT_EQ(1, nodes.count());
+    EXPECT_EQ("smb://host/share", nodes.first().url);
+    EXPECT_EQ("share", nodes.first().displayName);
+    EXPECT_TRUE(age > 1000);   // partial listing should be refreshed on first use
+
+    cache->addShare(QUrl("smb://host/share"));
+    cache->listing(QUrl("smb://host"), &nodes);
+    EXPECT_EQ(1, nodes.count());
+
+    cache->addShare(QUrl("1234"));
+    EXPECT_EQ(1, cache->listings.count());
+}
+
+TEST_F(UT_SmbShareCache, ProberHostKey)
+{
+    EXPECT_TRUE(SmbHostProber::hostKey(QUrl("network:///")).isEmpty());
+    EXPECT_EQ("smb://1.2.3.4:445", SmbHostProber::hostKey(QUrl("smb://1.2.3.4/share")));
+    EXPECT_EQ("smb://1.2.3.4:1445", SmbHostProber::hostKey(QUrl("smb://1.2.3.4:1445")));
+    EXPECT_EQ("sftp://1.2.3.4:22", SmbHostProber::hostKey(QUrl("sftp://1.2.3.4")));
+}
+
+TEST_F(UT_SmbShareCache, ProberTimeout)
+{
+    auto prober = SmbHostProber::instance();
+    prober->results.clear();
+    EXPECT_EQ(3000, prober->timeoutOf("smb://host:445"));
+
+    SmbHostProber::ProbeResult result;
+    result.reachable = true;
+    result.connectMs = 10;
+    prober->results.insert("smb://host:445", result);
+    EXPECT_EQ(500, prober->timeoutOf("smb://host:445"));
+
+    result.connectMs = 300;
+    prober->results.insert("smb://host:445", result);
+    EXPECT_EQ(1200, prober->timeoutOf("smb://host:445"));
+    prober->results.clear();
+}
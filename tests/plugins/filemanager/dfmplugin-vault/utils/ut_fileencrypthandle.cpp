@@ -334,6 +334,46 @@ TEST(UT_FileEncryptHandle, encryptAlgoTypeOfGroupPolicy)
     EXPECT_TRUE(isOk);
 }
 
+TEST(UT_FileEncryptHandle, blockSizeOfConfig)
+{
+    QVariant configValue;
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(&DConfigManager::value, [ &configValue ]{
+        return configValue;
+    });
+
+    configValue = 64 * 1024;
+    EXPECT_EQ(64 * 1024, FileEncryptHandle::instance()->blockSizeOfConfig());
+    configValue = kVaultMinBlockSize;
+    EXPECT_EQ(kVaultMinBlockSize, FileEncryptHandle::instance()->blockSizeOfConfig());
+    configValue = kVaultMaxBlockSize;
+    EXPECT_EQ(kVaultMaxBlockSize, FileEncryptHandle::instance()->blockSizeOfConfig());
+
+    // 超出范围、非 2 的幂以及非数字的值都回退到默认块大小
+    configValue = kVaultMinBlockSize / 2;
+    EXPECT_EQ(kVaultDefaultBlockSize, FileEncryptHandle::instance()->blockSizeOfConfig());
+    configValue = kVaultMaxBlockSize * 2;
+    EXPECT_EQ(kVaultDefaultBlockSize, FileEncryptHandle::instance()->blockSizeOfConfig());
+    configValue = 48 * 1024;
+    EXPECT_EQ(kVaultDefaultBlockSize, FileEncryptHandle::instance()->blockSizeOfConfig());
+    configValue = -32768;
+    EXPECT_EQ(kVaultDefaultBlockSize, FileEncryptHandle::instance()->blockSizeOfConfig());
+    configValue = QString("UT_TEST");
+    EXPECT_EQ(kVaultDefaultBlockSize, FileEncryptHandle::instance()->blockSizeOfConfig());
+}
+
+TEST(UT_FileEncryptHandle, isValidBlockSize)
+{
+    EXPECT_TRUE(FileEncryptHandle::isValidBlockSize(kVaultDefaultBlockSize));
+    EXPECT_TRUE(FileEncryptHandle::isValidBlockSize(kVaultMinBlockSize));
+    EXPECT_TRUE(FileEncryptHandle::isValidBlockSize(kVaultMaxBlockSize));
+    EXPECT_FALSE(FileEncryptHandle::isValidBlockSize(0));
+    EXPECT_FALSE(FileEncryptHandle::isValidBlockSize(kVaultMinBlockSize / 2));
+    EXPECT_FALSE(FileEncryptHandle::isValidBlockSize(kVaultMaxBlockSize * 2));
+    EXPECT_FALSE(FileEncryptHandle::isValidBlockSize(48 * 1024));
+}
+
 TEST(UT_FileEncryptHandle, slotReadError_one)
 {
     stub_ext::StubExt stub;
@@ -483,6 +483,34 @@ TEST(UT_VaultHelper, createVault)
     EXPECT_TRUE(isOk);
 }
 
+TEST(UT_VaultHelper, createVault_blockSize)
+{
+    int usedBlockSize { 0 };
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(&FileEncryptHandle::encryptAlgoTypeOfGroupPolicy, []{
+        return EncryptType::AES_256_GCM;
+    });
+    stub.set_lamda(&FileEncryptHandle::blockSizeOfConfig, []{
+        return 64 * 1024;
+    });
+    stub.set_lamda(&FileEncryptHandle::createVault, [ &usedBlockSize ](FileEncryptHandle *, const QString &, const QString &,
+                                                                      const QString &, EncryptType, int blockSize){
+        usedBlockSize = blockSize;
+    });
+
+    // 创建时选择的块大小优先于配置
+    QString password;
+    VaultHelper::instance()->createVault(password, 1024 * 1024);
+    EXPECT_EQ(1024 * 1024, usedBlockSize);
+
+    // 未选择或非法时使用配置中的块大小
+    VaultHelper::instance()->createVault(password);
+    EXPECT_EQ(64 * 1024, usedBlockSize);
+    VaultHelper::instance()->createVault(password, 48 * 1024);
+    EXPECT_EQ(64 * 1024, usedBlockSize);
+}
+
 TEST(UT_VaultHelper, unlockVault)
 {
     bool isOk { false };
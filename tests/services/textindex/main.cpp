@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "service_textindex_global.h"
+
+#include <gtest/gtest.h>
+#include <sanitizer/asan_interface.h>
+#include <QCoreApplication>
+#include <QStandardPaths>
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+DFM_LOG_REISGER_CATEGORY(SERVICETEXTINDEX_NAMESPACE)
+SERVICETEXTINDEX_END_NAMESPACE
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    // 索引与内容缓存写入测试目录，不影响用户数据
+    QStandardPaths::setTestModeEnabled(true);
+
+    ::testing::InitGoogleTest(&argc, argv);
+
+    int ret = RUN_ALL_TESTS();
+
+#ifdef ENABLE_TSAN_TOOL
+    __sanitizer_set_report_path("../../../asan_textindex.log");
+#endif
+
+    return ret;
+}
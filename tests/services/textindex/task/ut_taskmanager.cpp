@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "task/taskmanager.h"
+
+#include "stubext.h"
+
+#include <gtest/gtest.h>
+
+SERVICETEXTINDEX_USE_NAMESPACE
+
+class UT_TaskManager : public testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        stub.set_lamda(&IndexTask::start, [] { __DBG_STUB_INVOKE__ });
+        stub.set_lamda(&IndexTask::isRunning, [] { __DBG_STUB_INVOKE__ return true; });
+        manager = new TaskManager;
+        QObject::connect(manager, &TaskManager::taskFinished, [this](const QString &, const QString &path, bool success) {
+            finished.append({ path, success });
+        });
+    }
+    virtual void TearDown() override
+    {
+        delete manager;
+        stub.clear();
+    }
+
+    void startOptimize()
+    {
+        manager->currentTask = new IndexTask(IndexTask::Type::Optimize, "/index", TaskHandler());
+    }
+
+    TaskManager *manager { nullptr };
+    QList<QPair<QString, bool>> finished;
+    stub_ext::StubExt stub;
+};
+
+TEST_F(UT_TaskManager, StartDuringOptimize)
+{
+    startOptimize();
+    EXPECT_TRUE(manager->hasRunningTask());
+
+    // 段合并期间的任务依次排队，不会互相覆盖
+    EXPECT_TRUE(manager->startTask(IndexTask::Type::Update, "/home/a"));
+    EXPECT_TRUE(manager->startTask(IndexTask::Type::Update, "/home/b"));
+    EXPECT_TRUE(manager->startTask(IndexTask::Type::Update, "/home/a"));
+    EXPECT_EQ(2, manager->pendingTasks.count());
+
+    manager->onTaskFinished(IndexTask::Type::Optimize, true);
+    ASSERT_TRUE(manager->currentTask);
+    EXPECT_EQ("/home/a", manager->currentTask->taskPath());
+    EXPECT_EQ(1, manager->pendingTasks.count());
+
+    manager->onTaskFinished(IndexTask::Type::Update, true);
+    ASSERT_TRUE(manager->currentTask);
+    EXPECT_EQ("/home/b", manager->currentTask->taskPath());
+
+    manager->onTaskFinished(IndexTask::Type::Update, true);
+    EXPECT_FALSE(manager->currentTask);
+
+    // 每个排队的调用方都收到结束通知
+    QList<QPair<QString, bool>> expected { { "/home/a", true }, { "/home/b", true } };
+    EXPECT_EQ(expected, finished);
+}
+
+TEST_F(UT_TaskManager, QueueLimitDuringOptimize)
+{
+    startOptimize();
+    for (int i = 0; i < 16; ++i)
+        EXPECT_TRUE(manager->startTask(IndexTask::Type::Update, QString("/home/%1").arg(i)));
+
+    EXPECT_FALSE(manager->startTask(IndexTask::Type::Update, "/home/full"));
+}
+
+TEST_F(UT_TaskManager, StopCancelsQueuedTasks)
+{
+    startOptimize();
+    manager->startTask(IndexTask::Type::Remove, "/home/a");
+    manager->stopCurrentTask();
+
+    EXPECT_TRUE(manager->pendingTasks.isEmpty());
+    QList<QPair<QString, bool>> expected { { "/home/a", false } };
+    EXPECT_EQ(expected, finished);
+}
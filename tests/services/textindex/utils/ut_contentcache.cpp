@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "utils/contentcache.h"
+#include "utils/docutils.h"
+
+#include "stubext.h"
+
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+SERVICETEXTINDEX_USE_NAMESPACE
+
+class UT_ContentCache : public testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        ContentCache::clear();
+    }
+    virtual void TearDown() override
+    {
+        ContentCache::clear();
+        stub.clear();
+    }
+
+    QString entryPath(const QByteArray &key) const
+    {
+        return ContentCache::cacheStorePath() + "/" + QString::fromLatin1(key.left(2)) + "/" + QString::fromLatin1(key);
+    }
+
+    stub_ext::StubExt stub;
+};
+
+TEST_F(UT_ContentCache, RoundTrip)
+{
+    const QByteArray key("ab0123");
+    EXPECT_FALSE(ContentCache::load(key));
+
+    ContentCache::store(key, QString("文档内容 content"));
+    auto content = ContentCache::load(key);
+    ASSERT_TRUE(content);
+    EXPECT_EQ(QString("文档内容 content"), content.value());
+}
+
+TEST_F(UT_ContentCache, EmptyText)
+{
+    // 纯图片PDF提取不到文字，缓存命中后不应再次解析
+    const QByteArray key("cd0123");
+    ContentCache::store(key, QString());
+    ASSERT_TRUE(QFile::exists(entryPath(key)));
+
+    auto content = ContentCache::load(key);
+    ASSERT_TRUE(content);
+    EXPECT_TRUE(content->isEmpty());
+    EXPECT_TRUE(QFile::exists(entryPath(key)));
+}
+
+TEST_F(UT_ContentCache, CorruptEntry)
+{
+    const QByteArray key("ef0123");
+    ContentCache::store(key, QString("content"));
+
+    QFile file(entryPath(key));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write("not a compressed blob");
+    file.close();
+
+    EXPECT_FALSE(ContentCache::load(key));
+    EXPECT_FALSE(QFile::exists(entryPath(key)));
+}
+
+TEST_F(UT_ContentCache, ExtractUsesCache)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("image.pdf");
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(64 * 1024, 'x'));
+    file.close();
+
+    int parsed = 0;
+    stub.set_lamda(&DocUtils::extractFileContent, [&parsed](const QString &) -> std::optional<QString> {
+        __DBG_STUB_INVOKE__
+        ++parsed;
+        return QString();
+    });
+
+    EXPECT_TRUE(ContentCache::extractFileContent(path));
+    EXPECT_TRUE(ContentCache::extractFileContent(path));
+    EXPECT_EQ(1, parsed);
+}
+
+TEST_F(UT_ContentCache, Clear)
+{
+    ContentCache::store("aa0123", QString("content"));
+    ContentCache::clear();
+    EXPECT_FALSE(QFileInfo::exists(ContentCache::cacheStorePath()));
+}